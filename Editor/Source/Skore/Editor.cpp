@@ -1,10 +1,12 @@
 #include "Skore/Editor.hpp"
 
 #include <algorithm>
+#include <cstdlib>
 #include <imgui.h>
 #include <imgui_internal.h>
 
 #include "Skore/App.hpp"
+#include "Skore/Core/ArgParser.hpp"
 #include "Skore/Core/Reflection.hpp"
 #include "Skore/ImGui/ImGui.hpp"
 #include "Skore/Window/ProjectBrowserWindow.hpp"
@@ -36,10 +38,12 @@
 #include "Skore/Project/ProjectManager.hpp"
 #include "Skore/Server/EditorServer.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <thread>
 
 #include "Skore/Core/Settings.hpp"
-#include "Skore/Core/ThreadPool.hpp"
+#include "Skore/Core/JobSystem.hpp"
 #include "Skore/Graphics/Graphics.hpp"
 #include "Skore/IO/Input.hpp"
 #include "Skore/Platform/Platform.hpp"
@@ -190,7 +194,7 @@ namespace Skore
 		std::mutex funcsMutex;
 		Queue<std::function<void()>> funcs;
 
-		std::unique_ptr<ThreadPool> threadPool;
+		std::atomic<u64> pendingTasks = 0;
 
 		MenuItemContext menuContext{};
 		Array<String>    recentProjectMenuPaths;
@@ -360,6 +364,31 @@ namespace Skore
 			undoActions.PopBack();
 		}
 
+		//drops the oldest scopes once the undo history is over the memory budget
+		void TrimUndoActions()
+		{
+			usize budget = GetUndoMemoryBudget();
+			if (budget == 0) return;
+
+			usize total = 0;
+			for (const auto& action : undoActions)
+			{
+				total += action->scope->GetMemorySize();
+			}
+
+			usize evict = 0;
+			while (evict < undoActions.Size() && total > budget)
+			{
+				total -= undoActions[evict]->scope->GetMemorySize();
+				evict++;
+			}
+
+			if (evict > 0)
+			{
+				undoActions.Erase(undoActions.begin(), undoActions.begin() + evict);
+			}
+		}
+
 		bool UndoEnabled(const MenuItemEventData& eventData)
 		{
 			return !undoRedoLocked && !undoActions.Empty();
@@ -512,7 +541,18 @@ namespace Skore
 					packagesToExport.EmplaceBack(package);
 				}
 				packagesToExport.EmplaceBack(projectRID);
-				ResourceAssets::ExportPackages(packagesToExport, assetsPath, projectName);
+
+				//release builds can pass a high --compression-level, --threads limits the cores used to compress
+				PackageExportOptions exportOptions;
+				if (StringView level = App::GetArgs().Get("compression-level"); !level.Empty())
+				{
+					exportOptions.compressionLevel = static_cast<i32>(std::strtol(String(level).CStr(), nullptr, 10));
+				}
+				if (StringView threads = App::GetArgs().Get("threads"); !threads.Empty())
+				{
+					exportOptions.threads = static_cast<u32>(std::strtoul(String(threads).CStr(), nullptr, 10));
+				}
+				ResourceAssets::ExportPackages(packagesToExport, assetsPath, projectName, exportOptions);
 			}
 
 			logger.Debug("Project exported to {}", Path::Join(projectPath, "Export"));
@@ -688,7 +728,10 @@ namespace Skore
 
 			EditorLayout::Shutdown();
 
-			threadPool = {};
+			while (pendingTasks.load() > 0)
+			{
+				std::this_thread::yield();
+			}
 			menuContext = {};
 
 			Resources::FindType<EditorState>()->UnregisterEvent(ResourceEventType::Changed, OnEditorStateChange, nullptr);
@@ -1172,7 +1215,7 @@ namespace Skore
 			ImGui::Text("%.2f ms (%.2f FPS)", App::DeltaTime() * 1000, App::GetFPS());
 			ImGui::Spring(1);
 
-			u64 size = threadPool->Size();
+			u64 size = pendingTasks.load();
 			if (size > 0)
 			{
 				if (size == 1)
@@ -1222,7 +1265,7 @@ namespace Skore
 
 		void OnEditorShutdownRequest(bool* canClose)
 		{
-			// if (threadPool && threadPool->Size() > 0)
+			// if (pendingTasks.load() > 0)
 			// {
 			// 	*canClose = false;
 			// 	return;
@@ -1294,6 +1337,7 @@ namespace Skore
 	{
 		UndoRedoScope* scope = UndoRedoScope::Create(name);
 		redoActions.Clear();
+		TrimUndoActions();
 		undoActions.EmplaceBack(std::make_unique<UndoRedoScopeStorage>(scope));
 		return scope;
 	}
@@ -1390,7 +1434,12 @@ namespace Skore
 
 	void Editor::AddTask(std::function<void()> func, StringView name)
 	{
-		threadPool->Enqueue(Traits::Move(func));
+		pendingTasks.fetch_add(1);
+		JobSystem::Schedule([func = Traits::Move(func)]
+		{
+			func();
+			pendingTasks.fetch_sub(1);
+		});
 	}
 
 	void Editor::SaveAll()
@@ -1500,7 +1549,6 @@ namespace Skore
 			return AppResult::Failure;
 		}
 
-		threadPool = std::make_unique<ThreadPool>("Editor::ThreadPool");
 		projectFilePath = projectFile;
 		projectPath = Path::Parent(projectFile);
 
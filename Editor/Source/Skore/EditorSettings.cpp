@@ -72,10 +72,24 @@ namespace Skore
 		return loadPreviousProject;
 	}
 
+	usize GetUndoMemoryBudget()
+	{
+		usize budget = 256;
+		if (RID generalSettings = Settings::Get<EditorSettings, GeneralEditorSettings>())
+		{
+			if (ResourceObject settings = Resources::Read(generalSettings))
+			{
+				budget = settings.GetUInt(GeneralEditorSettings::UndoMemoryBudget);
+			}
+		}
+		return budget * 1024 * 1024;
+	}
+
 	void RegisterEditorSettingsTypes()
 	{
 		ResourceType* type = Resources::Type<GeneralEditorSettings>()
 			.Field<GeneralEditorSettings::LoadPreviousProjectOnStartup>(ResourceFieldType::Bool)
+			.Field<GeneralEditorSettings::UndoMemoryBudget>(ResourceFieldType::UInt)
 			.Attribute<EditableSettings>(EditableSettings{
 				.path = "Editor/General",
 				.type = TypeInfo<EditorSettings>::ID(),
@@ -87,6 +101,7 @@ namespace Skore
 		RID rid = Resources::Create<GeneralEditorSettings>();
 		ResourceObject settings = Resources::Write(rid);
 		settings.SetBool(GeneralEditorSettings::LoadPreviousProjectOnStartup, true);
+		settings.SetUInt(GeneralEditorSettings::UndoMemoryBudget, 256);
 		settings.Commit();
 		type->SetDefaultValue(rid);
 	}
@@ -9,7 +9,8 @@ namespace Skore
 	{
 		enum
 		{
-			LoadPreviousProjectOnStartup
+			LoadPreviousProjectOnStartup,
+			UndoMemoryBudget //UInt, in MB, 0 keeps every undo scope
 		};
 	};
 
@@ -17,5 +18,6 @@ namespace Skore
 	SK_API RID    LoadEditorSettingsResource();
 	SK_API void   SaveEditorSettingsResource();
 	SK_API bool   ShouldLoadPreviousProjectOnStartup();
+	SK_API usize  GetUndoMemoryBudget();
 	void          RegisterEditorSettingsTypes();
 }
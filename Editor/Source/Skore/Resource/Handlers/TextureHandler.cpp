@@ -60,7 +60,7 @@ namespace Skore
 						});
 
 						VoidPtr mem = tempSrcBuffer->GetMappedData();
-						if (compressionMode == CompressionMode::None)
+						if (compressionMode == CompressionMode::None || compressedSize == size)
 						{
 							buffer.CopyData(mem, size);
 						}
@@ -9,6 +9,7 @@
 #include "Skore/Editor.hpp"
 #include "Skore/Core/ByteBuffer.hpp"
 #include "Skore/Core/Logger.hpp"
+#include "Skore/Core/Settings.hpp"
 #include "Skore/Core/StringUtils.hpp"
 #include "Skore/Graphics/Graphics.hpp"
 #include "Skore/Graphics/RenderTools.hpp"
@@ -36,7 +37,7 @@ namespace Skore
 
 		u32 CookerVersion() override
 		{
-			return 1;
+			return 2;
 		}
 
 		TypeID GetSettingsType() override
@@ -170,13 +171,13 @@ namespace Skore
 		bool generateMips = format != Format::RGBA32_FLOAT; //mips - not going to generate for hdri.
 		u32 mipLevels = generateMips ? static_cast<u32>(std::floor(std::log2(std::max(width, height)))) + 1 : 1;
 
-		CompressionMode compressionMode = CompressionMode::None;
-
-		//compress only RGBA32_FLOAT for now.
-		if (format == Format::RGBA32_FLOAT)
+		u32 compressionField = format == Format::RGBA32_FLOAT ? CompressionSettings::HDRTextureCompression : CompressionSettings::TextureCompression;
+		CompressionMode compressionMode = format == Format::RGBA32_FLOAT ? CompressionMode::ZSTD : CompressionMode::LZ4;
+		if (ResourceObject compressionSettings = Resources::Read(Settings::Get<ProjectSettings, CompressionSettings>()))
 		{
-			compressionMode = CompressionMode::ZSTD;
+			compressionMode = compressionSettings.GetEnum<CompressionMode>(compressionField);
 		}
+		i32 compressionLevel = compressionMode == CompressionMode::LZ4 ? CompressionLZ4HCLevel : CompressionDefaultLevel;
 
 		Span<u8> toCompressSpan;
 		ByteBuffer compressedBuffer = {};
@@ -305,7 +306,15 @@ namespace Skore
 				                                       compressedBuffer.Size() - totalCompressedSize,
 				                                       toCompressSpan.begin() + originOffset,
 				                                       totalMipSize,
-				                                       compressionMode);
+				                                       compressionMode,
+				                                       compressionLevel);
+
+				//mips that don't get smaller are stored as-is, readers check DataSize == UncompressedSize
+				if (compressedSize == 0 || compressedSize >= totalMipSize)
+				{
+					memcpy(compressedBuffer.begin() + totalCompressedSize, toCompressSpan.begin() + originOffset, totalMipSize);
+					compressedSize = totalMipSize;
+				}
 
 				totalCompressedSize += compressedSize;
 			}
@@ -338,7 +347,7 @@ namespace Skore
 		}
 		else
 		{
-			byteSpan = {mipsBuffer.begin(), totalUncompressedSize};
+			byteSpan = toCompressSpan;
 		}
 
 		ResourceObject textureObject = Resources::Write(texture);
@@ -12,6 +12,7 @@
 #include "Skore/Core/ByteBuffer.hpp"
 #include "Skore/Core/Event.hpp"
 #include "Skore/Core/Hash.hpp"
+#include "Skore/Core/JobSystem.hpp"
 #include "Skore/Core/Logger.hpp"
 #include "Skore/Core/Reflection.hpp"
 #include "Skore/Core/Settings.hpp"
@@ -26,6 +27,7 @@
 #include <efsw/efsw.hpp>
 #include "Skore/IO/Path.hpp"
 #include "Skore/Platform/Platform.hpp"
+#include "Skore/Resource/ResourcePackage.hpp"
 #include "Skore/Resource/Resources.hpp"
 #include "Skore/Resource/ResourceType.hpp"
 #include "Skore/Utils/PreviewGenerator.hpp"
@@ -1222,22 +1224,31 @@ namespace Skore
 		}
 	}
 
-	static void WriteCookedResource(StringView folder, RID root, HashSet<String>& currentFiles)
+	struct CookedFile
 	{
-		BinaryArchiveWriter writer;
+		String    path;
+		Array<u8> data;
+	};
+
+	static void SaveCookedFile(const CookedFile& file)
+	{
+		usize      bound = Compression::GetMaxCompressedBufferSize(file.data.Size(), CompressionMode::ZSTD);
+		ByteBuffer compressed;
+		compressed.Resize(bound);
+		usize compressedSize = Compression::Compress(compressed.begin(), bound, file.data.Data(), file.data.Size(), CompressionMode::ZSTD);
+		FileSystem::SaveFileAsByteArray(file.path, Span<u8>(compressed.begin(), compressedSize));
+	}
+
+	static void WriteCookedResource(StringView folder, RID root, HashSet<String>& currentFiles, Array<CookedFile>& cookedFiles)
+	{
+		BinaryArchiveWriter writer{true};
 		writer.BeginMap("asset");
 		writer.WriteString("pathId", Resources::GetUUID(root).ToString());
 		Resources::Serialize(root, writer);
 		writer.EndMap();
 
-		Span<u8>   data = writer.GetData();
-		usize      bound = Compression::GetMaxCompressedBufferSize(data.Size(), CompressionMode::ZSTD);
-		ByteBuffer compressed;
-		compressed.Resize(bound);
-		usize compressedSize = Compression::Compress(compressed.begin(), bound, data.begin(), data.Size(), CompressionMode::ZSTD);
-
 		String cookedFileName = Resources::GetUUID(root).ToString() + ".cooked";
-		FileSystem::SaveFileAsByteArray(Path::Join(folder, cookedFileName), Span<u8>(compressed.begin(), compressedSize));
+		cookedFiles.EmplaceBack(CookedFile{Path::Join(folder, cookedFileName), writer.GetData()});
 		currentFiles.Emplace(cookedFileName);
 
 		if (ResourceObject object = Resources::Read(root))
@@ -1277,7 +1288,8 @@ namespace Skore
 			FileSystem::CreateDirectory(folder);
 		}
 
-		HashSet<String> currentFiles;
+		HashSet<String>   currentFiles;
+		Array<CookedFile> cookedFiles;
 		for (RID entryRid : wrapperObj.GetSubObjectList(ResourceImportedAsset::SubResources))
 		{
 			ResourceObject entry = Resources::Read(entryRid);
@@ -1286,9 +1298,15 @@ namespace Skore
 			RID root = Resources::FindByUUID(UUID::FromString(entry.GetString(ResourceSubIdEntry::TargetUUID)));
 			if (!root) continue;
 
-			WriteCookedResource(folder, root, currentFiles);
+			WriteCookedResource(folder, root, currentFiles, cookedFiles);
 		}
 
+		//resources are serialized on this thread, the cooked files are compressed and saved in parallel
+		JobSystem::ParallelFor(static_cast<u32>(cookedFiles.Size()), 1, [&](u32 index)
+		{
+			SaveCookedFile(cookedFiles[index]);
+		});
+
 		String cookInfoName = "cook.info";
 		FileSystem::SaveFileAsString(Path::Join(folder, cookInfoName), CookToken(wrapperObj));
 		currentFiles.Emplace(cookInfoName);
@@ -2504,13 +2522,14 @@ namespace Skore
 		return Resources::GetUUID(rid);
 	}
 
-	void ResourceAssets::ExportPackages(Span<RID> packages, StringView path, StringView name)
+	void ResourceAssets::ExportPackages(Span<RID> packages, StringView path, StringView name, const PackageExportOptions& options)
 	{
-		BinaryArchiveWriter writer;
-
-		writer.BeginMap("projectSettings");
-		Settings::Save(writer, TypeInfo<ProjectSettings>::ID());
-		writer.EndMap();
+		ResourcePackageWriter package;
+		if (!package.Open(Path::Join(path, String(name) + SK_RESOURCE_EXT)))
+		{
+			return;
+		}
+		package.SetCompressionThreads(options.threads);
 
 		// Collect all assets with their load order before writing
 		struct AssetToExport
@@ -2562,8 +2581,6 @@ namespace Skore
 			return a.loadOrder < b.loadOrder;
 		});
 
-		writer.BeginSeq("assets");
-
 		String resourceFile = Path::Join(path, String(name).Append(SK_BUFFER_EXT));
 		u64    offset = 0;
 
@@ -2572,7 +2589,56 @@ namespace Skore
 
 		FileHandler bufferHandler = FileSystem::OpenFile(resourceFile, AccessMode::WriteOnly);
 
-		for (const AssetToExport& entry : assetsToExport)
+		//assets with the default load order are listed in the table of contents, so the player can load them on demand
+		struct TableOfContentsEntry
+		{
+			String pathId;
+			UUID   uuid;
+			String type;
+			u32    chunk;
+			u32    entry;
+		};
+		Array<TableOfContentsEntry> tableOfContents;
+		u32                         entryIndex = 0;
+
+		//chunks are compressed once every asset is cooked, so the dictionary can be trained from the cooked assets first
+		struct ChunkToWrite
+		{
+			Array<u8> data;
+			bool      beginGroup;
+		};
+		Array<ChunkToWrite> chunksToWrite;
+
+		Array<u8>    dictionarySamples;
+		Array<usize> dictionarySampleSizes;
+
+		auto writeCooked = [&](BinaryArchiveWriter& writer, const AssetToExport& entry, StringView pathId, RID root)
+		{
+			if (entry.loadOrder == INT32_MAX)
+			{
+				ResourceType* type = Resources::GetType(root);
+				tableOfContents.EmplaceBack(TableOfContentsEntry{
+					.pathId = pathId,
+					.uuid = Resources::GetUUID(root),
+					.type = type ? type->GetName() : StringView{},
+					.chunk = static_cast<u32>(chunksToWrite.Size()),
+					.entry = entryIndex
+				});
+			}
+
+			usize begin = writer.GetData().Size();
+			WriteCookedAsset(writer, pathId, root, bufferHandler, offset, byteBuffer, true);
+			entryIndex++;
+
+			Span<u8> cooked = writer.GetData();
+			if (usize size = cooked.Size() - begin; size <= ResourcePackageSmallChunkSize)
+			{
+				dictionarySamples.Insert(dictionarySamples.end(), cooked.begin() + begin, cooked.end());
+				dictionarySampleSizes.EmplaceBack(size);
+			}
+		};
+
+		auto writeAsset = [&](BinaryArchiveWriter& writer, const AssetToExport& entry)
 		{
 			ResourceObject assetObject = Resources::Read(entry.asset);
 			RID            importedAsset = assetObject.GetSubObject(ResourceAsset::ImportedAsset);
@@ -2592,26 +2658,82 @@ namespace Skore
 					if (!root) continue;
 
 					String pathId = basePathId + "#" + subEntry.GetString(ResourceSubIdEntry::SubId);
-					WriteCookedAsset(writer, pathId, root, bufferHandler, offset, byteBuffer, true);
+					writeCooked(writer, entry, pathId, root);
 				}
 			}
 			else if (RID object = assetObject.GetSubObject(ResourceAsset::Object))
 			{
-				WriteCookedAsset(writer, GetPathId(entry.asset), object, bufferHandler, offset, byteBuffer, true);
+				writeCooked(writer, entry, GetPathId(entry.asset), object);
 			}
+		};
+
+		//assets are grouped in chunks, so loading only needs one chunk decompressed at a time.
+		//chunks never mix load orders, each load order is a package group that is loaded after the previous ones
+		usize index = 0;
+		while (index < assetsToExport.Size())
+		{
+			int   loadOrder = assetsToExport[index].loadOrder;
+			bool  beginGroup = index == 0 || assetsToExport[index - 1].loadOrder != loadOrder;
+			usize chunkSize = loadOrder == INT32_MAX ? ResourcePackageSmallChunkSize : ResourcePackageChunkSize;
+
+			BinaryArchiveWriter writer{true};
+			writer.BeginSeq("assets");
+			entryIndex = 0;
+			while (index < assetsToExport.Size() && assetsToExport[index].loadOrder == loadOrder && writer.GetData().Size() < chunkSize)
+			{
+				writeAsset(writer, assetsToExport[index++]);
+			}
+			writer.EndSeq();
+
+			chunksToWrite.EmplaceBack(ChunkToWrite{
+				.data = writer.GetData(),
+				.beginGroup = beginGroup
+			});
 		}
 
-		FileSystem::CloseFile(bufferHandler);
+		//most small assets share their field names and layout, which they can't reuse when compressed alone
+		Array<u8> dictionary;
+		Compression::TrainDictionary(dictionarySamples, dictionarySampleSizes, dictionary);
+		package.AddDictionary(dictionary, options.compressionLevel);
 
-		writer.EndSeq();
+		{
+			BinaryArchiveWriter writer{true};
+			writer.BeginMap("projectSettings");
+			Settings::Save(writer, TypeInfo<ProjectSettings>::ID());
+			writer.EndMap();
+			package.AddChunk(writer.GetData(), CompressionMode::ZSTD, options.compressionLevel);
+		}
 
-		Span<u8>  uncompressedData = writer.GetData();
-		usize     compressedSize = Compression::GetMaxCompressedBufferSize(uncompressedData.Size(), CompressionMode::ZSTD);
-		Array<u8> compressedData(MemoryGlobals::GetHeapAllocator());
-		compressedData.Resize(compressedSize);
+		u32 firstChunk = package.GetChunkCount();
+		for (ChunkToWrite& chunk : chunksToWrite)
+		{
+			if (chunk.beginGroup)
+			{
+				package.BeginGroup();
+			}
+			package.AddChunk(Traits::Move(chunk.data), CompressionMode::ZSTD, options.compressionLevel);
+		}
 
-		compressedSize = Compression::Compress(compressedData.Data(), compressedSize, uncompressedData.Data(), uncompressedData.Size(), CompressionMode::ZSTD);
-		FileSystem::SaveFileAsByteArray(Path::Join(path, String(name) + SK_RESOURCE_EXT), Span(compressedData.Data(), compressedSize));
+		if (!tableOfContents.Empty())
+		{
+			BinaryArchiveWriter writer{true};
+			writer.BeginSeq("assets");
+			for (const TableOfContentsEntry& entry : tableOfContents)
+			{
+				writer.BeginMap();
+				writer.WriteString("pathId", entry.pathId);
+				writer.WriteString("uuid", entry.uuid.ToString());
+				writer.WriteString("type", entry.type);
+				writer.WriteUInt("chunk", firstChunk + entry.chunk);
+				writer.WriteUInt("entry", entry.entry);
+				writer.EndMap();
+			}
+			writer.EndSeq();
+			package.AddTableOfContents(writer.GetData());
+		}
+
+		FileSystem::CloseFile(bufferHandler);
+		package.Close();
 	}
 
 	GPUTexture* ResourceAssets::GetThumbnail(RID rid)
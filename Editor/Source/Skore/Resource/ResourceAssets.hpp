@@ -8,6 +8,7 @@
 #include "Skore/Core/ByteBuffer.hpp"
 #include "Skore/Core/Span.hpp"
 #include "Skore/Core/UUID.hpp"
+#include "Skore/IO/Compression.hpp"
 #include "Skore/Resource/ResourceBuffer.hpp"
 #include "Skore/Resource/ResourceCommon.hpp"
 
@@ -271,6 +272,12 @@ namespace Skore
 		virtual bool          ImportAsset(RID directory, ConstPtr settings, StringView path, UndoRedoScope* scope) { return false; }
 	};
 
+	struct PackageExportOptions
+	{
+		i32 compressionLevel = CompressionDefaultLevel;
+		u32 threads = 0; //0 uses every job system worker
+	};
+
 	struct SK_API ResourceAssets
 	{
 		static RID                     ScanPackageFromDirectory(StringView packageName, StringView packagePath);
@@ -314,7 +321,7 @@ namespace Skore
 		static String                  GetAssetName(RID rid);
 		static String                  GetAssetFullName(RID rid);
 		static UUID                    GetAssetUUID(RID rid);
-		static void                    ExportPackages(Span<RID> packages, StringView path, StringView name);
+		static void                    ExportPackages(Span<RID> packages, StringView path, StringView name, const PackageExportOptions& options = {});
 		static GPUTexture*             GetThumbnail(RID rid);
 		static GPUTexture*             GetDefaultThumbnail();
 		static const char*						 GetIcon(RID rid);
@@ -345,6 +345,13 @@ namespace Skore
 			Profiler::FrameStats fs = gpu ? Profiler::GetGpuFrameStats() : Profiler::GetCpuFrameStats();
 			ImGui::Text("Frame: %.2f ms   avg %.2f   min %.2f   max %.2f   (%u samples)",
 				fs.current * 1000.0, fs.avg * 1000.0, fs.min * 1000.0, fs.max * 1000.0, fs.count);
+
+			if (!gpu)
+			{
+				Profiler::MemoryStats ms = Profiler::GetFrameAllocatorStats();
+				ImGui::Text("Frame Allocator: %.2f KB   peak %.2f KB   reserved %.2f KB",
+					ms.current / 1024.0, ms.peak / 1024.0, ms.reserved / 1024.0);
+			}
 		}
 
 		// --- Layout: Left tree + Right chart ---
@@ -1,6 +1,10 @@
 #include "Skore/App.hpp"
 #include "Skore/Main.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
 #include "Skore/Events.hpp"
 #include "Skore/OpenXRManager.hpp"
 #include "Skore/Core/ArgParser.hpp"
@@ -10,6 +14,7 @@
 #include "Skore/Graphics/RenderPipeline.hpp"
 #include "Skore/IO/FileSystem.hpp"
 #include "Skore/IO/FileTypes.hpp"
+#include "Skore/IO/Input.hpp"
 #include "Skore/IO/Path.hpp"
 #include "Skore/Resource/Resources.hpp"
 #include "Skore/Scene/Scene.hpp"
@@ -26,6 +31,11 @@ namespace Skore
 
 	static RenderPipelineContext* pipelineContext;
 
+	static String      replayReportPath;
+	static Array<f64>  replayFrameTimes;
+	static u64         replayStartFrame = 0;
+	static bool        replayFinished = false;
+
 	Logger& logger = Logger::GetLogger("Skore::Player");
 
 	void OnPlayerOnRecordRenderCommands(GPUCommandBuffer* cmd)
@@ -38,7 +48,73 @@ namespace Skore
 
 	void OnPlayerShutdown()
 	{
-		pipelineContext->Destroy();
+		if (pipelineContext)
+		{
+			pipelineContext->Destroy();
+		}
+	}
+
+	void WriteReplayReport()
+	{
+		if (replayFrameTimes.Empty())
+		{
+			logger.Warn("input replay finished without frames");
+			return;
+		}
+
+		Array<f64> sorted = replayFrameTimes;
+		std::sort(sorted.begin(), sorted.end());
+
+		f64 total = 0.0;
+		for (f64 time : replayFrameTimes)
+		{
+			total += time;
+		}
+
+		auto percentile = [&](f64 p)
+		{
+			return sorted[static_cast<usize>(p * static_cast<f64>(sorted.Size() - 1))] * 1000.0;
+		};
+
+		logger.Info("replay {} frames, cpu ms avg {:.3f} p50 {:.3f} p95 {:.3f} p99 {:.3f} max {:.3f}",
+		            replayFrameTimes.Size(), total / static_cast<f64>(replayFrameTimes.Size()) * 1000.0,
+		            percentile(0.5), percentile(0.95), percentile(0.99), sorted.Back() * 1000.0);
+
+		if (replayReportPath.Empty())
+		{
+			return;
+		}
+
+		String csv = "frame,cpu_ms\n";
+		char   line[64];
+		for (usize i = 0; i < replayFrameTimes.Size(); ++i)
+		{
+			i32 size = snprintf(line, sizeof(line), "%llu,%.4f\n", static_cast<unsigned long long>(i), replayFrameTimes[i] * 1000.0);
+			csv.Append(line, line + size);
+		}
+		FileSystem::SaveFileAsString(replayReportPath, csv);
+		logger.Info("replay report written to {}", replayReportPath);
+	}
+
+	//timings of the previous frame, the replay ends on the begin frame after its last frame
+	void OnPlayerReplayBeginFrame()
+	{
+		if (replayFinished)
+		{
+			return;
+		}
+
+		if (App::Frame() > replayStartFrame)
+		{
+			replayFrameTimes.EmplaceBack(App::GetFrameCPUTime());
+		}
+
+		if (!Input::IsReplaying())
+		{
+			replayFinished = true;
+			WriteReplayReport();
+			App::RequestShutdown();
+		}
 	}
 
 	void SK_API InitResourceLoaders();
@@ -67,6 +143,9 @@ namespace Skore
 
 		String assetsPath = Path::Join(currentDir, "Assets");
 
+		//assets are loaded on first use unless --eager-resources is passed
+		ResourceLoadMode loadMode = args.Has("eager-resources") ? ResourceLoadMode::Eager : ResourceLoadMode::Lazy;
+
 		//------------------- step 2 -- Resource Loading
 		for (const String& file : DirectoryEntries(assetsPath))
 		{
@@ -74,7 +153,7 @@ namespace Skore
 			if (Path::Extension(file) == SK_RESOURCE_EXT)
 			{
 				resourceLoaded = true;
-				RID loadedProjectSettings = Resources::LoadResources(file);
+				RID loadedProjectSettings = Resources::LoadResources(file, loadMode);
 				projectSettingsLoaded = loadedProjectSettings || projectSettingsLoaded;
 			}
 		}
@@ -118,20 +197,39 @@ namespace Skore
 			appConfig.maximized = appSettingsObject.GetBool(AppSettings::Maximized);
 		}
 
+		//dedicated servers, bots and soak tests: --headless [--tick-rate 30]
+		appConfig.headless = args.Has("headless");
+		if (String tickRate = args.Get("tick-rate"); !tickRate.Empty())
+		{
+			appConfig.tickRate = static_cast<u32>(std::strtoul(tickRate.CStr(), nullptr, 10));
+		}
+
+		//reproducible sessions: --deterministic [--seed 42] [--record file | --replay file [--replay-report file.csv]]
+		String recordPath = args.Get("record");
+		String replayPath = args.Get("replay");
+		appConfig.deterministic = args.Has("deterministic") || !recordPath.Empty() || !replayPath.Empty();
+		if (String seed = args.Get("seed"); !seed.Empty())
+		{
+			appConfig.randomSeed = std::strtoull(seed.CStr(), nullptr, 10);
+		}
+
 		if (AppResult result = App::CreateContext(appConfig); result != AppResult::Continue)
 		{
 			return result == AppResult::Success ? 0 : 1;
 		}
 
-		Array<TypeID> extraModules;
-		extraModules.EmplaceBack(TypeInfo<SwapchainRenderPipelineModule>::ID());
-		extraModules.EmplaceBack(TypeInfo<ProfilerOverlayPipelineModule>::ID());
+		if (!appConfig.headless)
+		{
+			Array<TypeID> extraModules;
+			extraModules.EmplaceBack(TypeInfo<SwapchainRenderPipelineModule>::ID());
+			extraModules.EmplaceBack(TypeInfo<ProfilerOverlayPipelineModule>::ID());
 
-		RenderPipelineContextSettings contextSettings;
-		pipelineContext = RenderPipeline::CreateContext(TypeInfo<DefaultRenderPipeline>::ID(), extraModules, contextSettings);
+			RenderPipelineContextSettings contextSettings;
+			pipelineContext = RenderPipeline::CreateContext(TypeInfo<DefaultRenderPipeline>::ID(), extraModules, contextSettings);
 
-		Event::Bind<OnRecordRenderCommands, &OnPlayerOnRecordRenderCommands>();
-		Event::Bind<OnShutdown, &OnPlayerShutdown>();
+			Event::Bind<OnRecordRenderCommands, &OnPlayerOnRecordRenderCommands>();
+			Event::Bind<OnShutdown, &OnPlayerShutdown>();
+		}
 
 
 		if (resourceLoaded)
@@ -149,6 +247,28 @@ namespace Skore
 			}
 		}
 
+		if (!replayPath.Empty())
+		{
+			if (!Input::StartReplay(replayPath))
+			{
+				return 1;
+			}
+
+			//benchmark runs don't wait for the tick rate, the fixed step keeps the simulation the same
+			replayReportPath = args.Get("replay-report");
+			if (!replayReportPath.Empty())
+			{
+				App::SetTargetFPS(0);
+			}
+
+			replayStartFrame = App::Frame();
+			Event::Bind<OnBeginFrame, &OnPlayerReplayBeginFrame>();
+		}
+		else if (!recordPath.Empty())
+		{
+			Input::StartRecording(recordPath);
+		}
+
 		App::Run();
 
 		return 0;
@@ -11,7 +11,8 @@
 #include "Skore/Core/Logger.hpp"
 #include "Skore/Core/Reflection.hpp"
 #include "Skore/Core/Settings.hpp"
-#include "Skore/Core/ThreadPool.hpp"
+#include "Skore/Core/JobSystem.hpp"
+#include "Skore/Core/Math.hpp"
 #include "Skore/Graphics/Graphics.hpp"
 #include "Skore/Graphics/RenderResourceCache.hpp"
 #include "Skore/IO/FileSystem.hpp"
@@ -25,6 +26,7 @@ namespace Skore
 
 	void InputInit();
 	void FileSystemInit();
+	void FileSystemShutdown();
 	Key  FromSDL(u32 key);
 	void ReflectionSetOptions(bool reloadEnabled);
 	bool GraphicsInit(const AppConfig& appConfig);
@@ -33,7 +35,7 @@ namespace Skore
 	void GraphicsShutdown();
 	void ResourceInit();
 	void ResourceShutdown();
-	void AudioEngineInit();
+	void AudioEngineInit(bool nullBackend);
 	void AudioEngineShutdown();
 	void InputHandlerEvents(SDL_Event* event);
 	void ScriptEngineInit();
@@ -69,6 +71,11 @@ namespace Skore
 		bool running = false;
 		bool appInitialized = false;
 		bool requireShutdown = false;
+		bool headless = false;
+		bool deterministic = false;
+		u32  tickRate = 0;
+		u64  randomSeed = 0;
+		f64  frameCPUTime = 0.0;
 
 		ArgParser argParser;
 
@@ -91,8 +98,6 @@ namespace Skore
 		std::mutex                   mutex;
 		Array<std::function<void()>> funcs;
 
-		std::unique_ptr<ThreadPool> threadPool;
-
 		Logger& logger = Logger::GetLogger("Skore::App");
 
 		Array<Pair<FnSDLEventCallback, VoidPtr>> eventCallbacks;
@@ -108,6 +113,7 @@ namespace Skore
 		argParser.Parse(argc, argv);
 
 		FileSystemInit();
+		JobSystem::Init();
 		ResourceInit();
 		RegisterTypes();
 		InputInit();
@@ -166,12 +172,16 @@ namespace Skore
 		Profiler::Shutdown();
 		onShutdownHandler.Invoke();
 
-		threadPool.reset();
+		JobSystem::Shutdown();
+		FileSystemShutdown();
 
 		RmlUIShutdown();
 		AudioEngineShutdown();
 		PhysicsShutdown();
-		GraphicsShutdown();
+		if (!headless)
+		{
+			GraphicsShutdown();
+		}
 		ResourceShutdown();
 		LayerSystemShutdown();
 
@@ -207,11 +217,14 @@ namespace Skore
 		}
 
 		u64 currentFrameTime = SDL_GetPerformanceCounter();
-		deltaTime = static_cast<float>(currentFrameTime - lastFrameTime) / perfFrequency;
+		f64 elapsed = static_cast<f64>(currentFrameTime - lastFrameTime) / perfFrequency;
 		lastFrameTime = currentFrameTime;
 
+		//headless and deterministic ticks advance a fixed step, the simulation doesn't depend on how long the host took to run the frame
+		deltaTime = (headless || deterministic) && tickRate > 0 ? 1.0 / static_cast<f64>(tickRate) : elapsed;
+
 		frameCount++;
-		fpsTimer += deltaTime;
+		fpsTimer += elapsed;
 
 		if (fpsTimer >= 1.0f)
 		{
@@ -222,6 +235,7 @@ namespace Skore
 
 		//logger.Info("fps {} ", fps);
 
+		MemoryGlobals::ResetFrameAllocator();
 		Profiler::BeginFrame();
 
 		if (u32 reflectionVersion = Reflection::GetVersion(); reflectionVersion != lastReflectionVersion)
@@ -231,7 +245,10 @@ namespace Skore
 		}
 
 		onBeginFrameHandler.Invoke();
-		RenderResourceCache::Flush();
+		if (!headless)
+		{
+			RenderResourceCache::Flush();
+		}
 		onUpdateHandler.Invoke();
 		onEndFrameHandler.Invoke();
 		Profiler::EndFrame();
@@ -239,10 +256,12 @@ namespace Skore
 
 		frame++;
 
+		u64 frameEndTime = SDL_GetPerformanceCounter();
+		frameCPUTime = static_cast<f64>(frameEndTime - currentFrameTime) / perfFrequency;
+
 		if (targetFPS > 0)
 		{
 			f64 targetFrameTime = 1.0 / static_cast<f64>(targetFPS);
-			u64 frameEndTime = SDL_GetPerformanceCounter();
 			f64 elapsed = static_cast<f64>(frameEndTime - lastFrameTime) / perfFrequency;
 			f64 remaining = targetFrameTime - elapsed;
 			if (remaining > 0.0)
@@ -279,18 +298,47 @@ namespace Skore
 			return AppResult::Success;
 		}
 
-		if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMEPAD))
+		headless = appConfig.headless;
+		deterministic = appConfig.deterministic;
+		tickRate = appConfig.tickRate;
+
+		//headless only needs events for quit requests
+		if (!SDL_Init(headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO | SDL_INIT_GAMEPAD))
 		{
 			logger.Error("error or SDL_Init {} ", SDL_GetError());
 			return AppResult::Failure;
 		}
 
-		if (!GraphicsInit(appConfig))
+		if (deterministic)
 		{
-			return AppResult::Failure;
+			if (tickRate == 0)
+			{
+				logger.Warn("deterministic mode requires a fixed tick rate, using 60");
+				tickRate = 60;
+			}
+			randomSeed = appConfig.randomSeed;
+			Random::SetSeed(randomSeed);
+			logger.Info("running deterministic at {} ticks per second with seed {}", tickRate, randomSeed);
 		}
 
-		OpenXRManagerCreateSession();
+		if (headless || deterministic)
+		{
+			targetFPS = tickRate;
+		}
+
+		if (headless)
+		{
+			logger.Info("running headless at {} ticks per second", tickRate);
+		}
+		else
+		{
+			if (!GraphicsInit(appConfig))
+			{
+				return AppResult::Failure;
+			}
+
+			OpenXRManagerCreateSession();
+		}
 
 		lastFrameTime = SDL_GetPerformanceCounter();
 		perfFrequency = SDL_GetPerformanceFrequency();
@@ -298,9 +346,12 @@ namespace Skore
 		running = true;
 		requireShutdown = true;
 
-		CreateGraphicsDefaultValues();
+		if (!headless)
+		{
+			CreateGraphicsDefaultValues();
+		}
 		PhysicsInit();
-		AudioEngineInit();
+		AudioEngineInit(headless);
 		ScriptEngineInit();
 
 		return AppResult::Continue;
@@ -312,7 +363,7 @@ namespace Skore
 		{
 			PoolEvents();
 
-			if (OpenXrManagerIterate() != AppResult::Continue)
+			if (!headless && OpenXrManagerIterate() != AppResult::Continue)
 			{
 				break;
 			}
@@ -387,15 +438,6 @@ namespace Skore
 		funcs.EmplaceBack(callback);
 	}
 
-	ThreadPool& App::GetThreadPool()
-	{
-		if (!threadPool)
-		{
-			threadPool = std::make_unique<ThreadPool>("App::ThreadPool");
-		}
-		return *threadPool;
-	}
-
 	void App::LoadPlugin(StringView path, StringView entryPoint)
 	{
 		if (VoidPtr library = Platform::LoadObject(path.CStr()))
@@ -419,6 +461,31 @@ namespace Skore
 		}
 	}
 
+	bool App::IsHeadless()
+	{
+		return headless;
+	}
+
+	bool App::IsDeterministic()
+	{
+		return deterministic;
+	}
+
+	u32 App::GetTickRate()
+	{
+		return tickRate;
+	}
+
+	u64 App::GetRandomSeed()
+	{
+		return randomSeed;
+	}
+
+	f64 App::GetFrameCPUTime()
+	{
+		return frameCPUTime;
+	}
+
 	bool App::ReloadedEnabled()
 	{
 		return enableReload;
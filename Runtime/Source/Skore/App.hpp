@@ -7,7 +7,6 @@
 namespace Skore
 {
 	class ArgParser;
-	class ThreadPool;
 
 	enum class AppResult
 	{
@@ -36,6 +35,10 @@ namespace Skore
 		bool   maximized;
 		bool   fullscreen;
 		bool   enableReload = false;
+		bool   headless = false; //no window, gpu or audio device, scenes, physics, audio (null backend), scripts and resources still run
+		bool   deterministic = false; //fixed DeltaTime and seeded Random, simulation results don't depend on the host timing
+		u64    randomSeed = 0;        //deterministic only
+		u32    tickRate = 60;         //headless or deterministic, updates per second with DeltaTime fixed to 1 / tickRate, 0 runs unpaced with the measured delta
 	};
 
 	typedef void (*FnInitCallback)();
@@ -58,8 +61,12 @@ namespace Skore
 		static void       SetTargetFPS(u32 fps); // 0 = unlimited
 		static u32        GetTargetFPS();
 		static void       RunOnMainThread(const std::function<void()>& callback);
-		static ThreadPool& GetThreadPool();
 		static void       LoadPlugin(StringView path, StringView entryPoint = "SkoreLoadPlugin");
+		static bool       IsHeadless();
+		static bool       IsDeterministic();
+		static u32        GetTickRate();
+		static u64        GetRandomSeed();
+		static f64        GetFrameCPUTime(); //seconds spent on the last frame, without the target fps wait
 		static bool       ReloadedEnabled();
 		static void       SetReloadEnabled(bool enabled);
 
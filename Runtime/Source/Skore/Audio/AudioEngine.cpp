@@ -11,6 +11,8 @@ namespace Skore
 	namespace
 	{
 		ma_engine    engine;
+		ma_context   nullContext;
+		bool         nullContextCreated = false;
 		bool         engineEnabled = true;
 		HashSet<RID> audioClips;
 	}
@@ -20,10 +22,21 @@ namespace Skore
 		ma_sound sound;
 	};
 
-	void AudioEngineInit()
+	void AudioEngineInit(bool nullBackend)
 	{
 		ma_engine_config engineConfig = ma_engine_config_init();
 		engineConfig.listenerCount = 1; // Number of listeners
+
+		//silent device, sounds still play and finish on time without audio hardware
+		if (nullBackend)
+		{
+			ma_backend backends[] = {ma_backend_null};
+			if (ma_context_init(backends, 1, nullptr, &nullContext) == MA_SUCCESS)
+			{
+				engineConfig.pContext = &nullContext;
+				nullContextCreated = true;
+			}
+		}
 		ma_engine_init(&engineConfig, &engine);
 		ma_engine_start(&engine);
 		engineEnabled = true;
@@ -33,6 +46,12 @@ namespace Skore
 	{
 		ma_engine_stop(&engine);
 		ma_engine_uninit(&engine);
+
+		if (nullContextCreated)
+		{
+			ma_context_uninit(&nullContext);
+			nullContextCreated = false;
+		}
 	}
 
 	bool AudioEngine::IsSoundEnabled()
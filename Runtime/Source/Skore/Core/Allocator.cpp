@@ -2,6 +2,10 @@
 
 #include "mimalloc.h"
 
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
 namespace Skore
 {
 	static VoidPtr MemAlloc(VoidPtr allocator, usize bytes)
@@ -19,6 +23,266 @@ namespace Skore
 		return mi_realloc(ptr, newSize);
 	}
 
+	namespace
+	{
+		constexpr usize FrameBlockSize = 1024 * 1024;
+		constexpr usize FrameMaxRetainedSize = 64 * 1024 * 1024;
+		constexpr usize FrameAlignment = 16;
+		constexpr usize FrameHeaderSize = 16; //stores the requested size, used by realloc
+
+		constexpr usize FrameAlignUp(usize value)
+		{
+			return (value + FrameAlignment - 1) & ~(FrameAlignment - 1);
+		}
+
+		struct FrameBlock
+		{
+			FrameBlock* next;
+			usize       capacity;
+			usize       offset;
+
+			u8* Data()
+			{
+				return reinterpret_cast<u8*>(this) + FrameAlignUp(sizeof(FrameBlock));
+			}
+		};
+
+		struct FrameBuffer
+		{
+			FrameBlock* head = nullptr;
+			u64         frame = U64_MAX;
+			usize       used = 0;
+		};
+
+		struct FrameArena
+		{
+			FrameBuffer        buffers[2];
+			std::atomic<u64>   frame = U64_MAX;
+			std::atomic<usize> used = 0;
+			std::atomic<usize> reserved = 0;
+
+			FrameArena* prev = nullptr;
+			FrameArena* next = nullptr;
+
+			FrameArena();
+			~FrameArena();
+		};
+
+		std::atomic<u64> frameIndex = 0;
+		usize            lastFrameUsed = 0;
+
+		std::mutex& FrameArenasMutex()
+		{
+			static std::mutex mutex;
+			return mutex;
+		}
+
+		FrameArena* frameArenas = nullptr;
+
+		//thread_local destructors run before static ones, containers destroyed at exit can still call free
+		thread_local bool frameArenaDestroyed = false;
+
+		FrameArena::FrameArena()
+		{
+			std::lock_guard lock(FrameArenasMutex());
+			next = frameArenas;
+			if (frameArenas)
+			{
+				frameArenas->prev = this;
+			}
+			frameArenas = this;
+		}
+
+		void FreeBlocks(FrameArena& arena, FrameBlock* block)
+		{
+			while (block)
+			{
+				FrameBlock* next = block->next;
+				arena.reserved.fetch_sub(block->capacity, std::memory_order_relaxed);
+				mi_free(block);
+				block = next;
+			}
+		}
+
+		FrameArena::~FrameArena()
+		{
+			{
+				std::lock_guard lock(FrameArenasMutex());
+				if (prev)
+				{
+					prev->next = next;
+				}
+				else
+				{
+					frameArenas = next;
+				}
+
+				if (next)
+				{
+					next->prev = prev;
+				}
+			}
+
+			for (FrameBuffer& buffer : buffers)
+			{
+				FreeBlocks(*this, buffer.head);
+			}
+			frameArenaDestroyed = true;
+		}
+
+		FrameArena& GetFrameArena()
+		{
+			thread_local FrameArena arena;
+			return arena;
+		}
+
+		FrameBlock* NewFrameBlock(FrameArena& arena, usize capacity, FrameBlock* next)
+		{
+			FrameBlock* block = static_cast<FrameBlock*>(mi_malloc_aligned(FrameAlignUp(sizeof(FrameBlock)) + capacity, FrameAlignment));
+			block->next = next;
+			block->capacity = capacity;
+			block->offset = 0;
+			arena.reserved.fetch_add(capacity, std::memory_order_relaxed);
+			return block;
+		}
+
+		void ResetFrameBuffer(FrameArena& arena, FrameBuffer& buffer)
+		{
+			usize lastUsed = buffer.used;
+			buffer.used = 0;
+
+			if (buffer.head == nullptr)
+			{
+				return;
+			}
+
+			if (buffer.head->next == nullptr && buffer.head->capacity <= FrameMaxRetainedSize)
+			{
+				buffer.head->offset = 0;
+				return;
+			}
+
+			//the buffer overflowed, replace all blocks by a single one that fits the last usage
+			usize capacity = lastUsed < FrameBlockSize ? FrameBlockSize : lastUsed;
+			if (capacity > FrameMaxRetainedSize)
+			{
+				capacity = FrameMaxRetainedSize;
+			}
+
+			FreeBlocks(arena, buffer.head);
+			buffer.head = NewFrameBlock(arena, capacity, nullptr);
+		}
+
+		FrameBuffer& GetFrameBuffer(FrameArena& arena)
+		{
+			u64          frame = frameIndex.load(std::memory_order_acquire);
+			FrameBuffer& buffer = arena.buffers[frame % 2];
+			if (buffer.frame != frame)
+			{
+				ResetFrameBuffer(arena, buffer);
+				buffer.frame = frame;
+				arena.used.store(0, std::memory_order_relaxed);
+				arena.frame.store(frame, std::memory_order_release);
+			}
+			return buffer;
+		}
+
+		//returns the block when ptr is the last allocation of the calling thread, only those can be freed or resized in place
+		FrameBlock* FindLastFrameAllocation(FrameBuffer& buffer, VoidPtr ptr, usize& size)
+		{
+			FrameBlock* block = buffer.head;
+			u8*         bytes = static_cast<u8*>(ptr);
+			if (block == nullptr || bytes < block->Data() + FrameHeaderSize || bytes >= block->Data() + block->offset)
+			{
+				return nullptr;
+			}
+
+			size = *reinterpret_cast<usize*>(bytes - FrameHeaderSize);
+			if (bytes + FrameAlignUp(size) != block->Data() + block->offset)
+			{
+				return nullptr;
+			}
+			return block;
+		}
+
+		VoidPtr FrameMemAlloc(VoidPtr allocator, usize bytes)
+		{
+			FrameArena&  arena = GetFrameArena();
+			FrameBuffer& buffer = GetFrameBuffer(arena);
+
+			usize size = FrameHeaderSize + FrameAlignUp(bytes);
+
+			FrameBlock* block = buffer.head;
+			if (block == nullptr || block->offset + size > block->capacity)
+			{
+				block = NewFrameBlock(arena, size > FrameBlockSize ? size : FrameBlockSize, buffer.head);
+				buffer.head = block;
+			}
+
+			u8* header = block->Data() + block->offset;
+			*reinterpret_cast<usize*>(header) = bytes;
+
+			block->offset += size;
+			buffer.used += size;
+			arena.used.store(arena.used.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+
+			return header + FrameHeaderSize;
+		}
+
+		void FrameMemFree(VoidPtr allocator, VoidPtr ptr)
+		{
+			if (ptr == nullptr || frameArenaDestroyed)
+			{
+				return;
+			}
+
+			FrameBuffer& buffer = GetFrameBuffer(GetFrameArena());
+
+			usize size = 0;
+			if (FrameBlock* block = FindLastFrameAllocation(buffer, ptr, size))
+			{
+				block->offset -= FrameHeaderSize + FrameAlignUp(size);
+			}
+		}
+
+		VoidPtr FrameMemRealloc(VoidPtr allocator, VoidPtr ptr, usize newSize)
+		{
+			if (ptr == nullptr)
+			{
+				return FrameMemAlloc(allocator, newSize);
+			}
+
+			FrameArena&  arena = GetFrameArena();
+			FrameBuffer& buffer = GetFrameBuffer(arena);
+
+			usize oldSize = 0;
+			if (FrameBlock* block = FindLastFrameAllocation(buffer, ptr, oldSize))
+			{
+				u8* end = static_cast<u8*>(ptr) + FrameAlignUp(newSize);
+				if (end <= block->Data() + block->capacity)
+				{
+					usize newOffset = end - block->Data();
+					if (newOffset > block->offset)
+					{
+						buffer.used += newOffset - block->offset;
+						arena.used.store(arena.used.load(std::memory_order_relaxed) + newOffset - block->offset, std::memory_order_relaxed);
+					}
+					block->offset = newOffset;
+					*reinterpret_cast<usize*>(static_cast<u8*>(ptr) - FrameHeaderSize) = newSize;
+					return ptr;
+				}
+			}
+			else
+			{
+				oldSize = *reinterpret_cast<usize*>(static_cast<u8*>(ptr) - FrameHeaderSize);
+			}
+
+			VoidPtr newPtr = FrameMemAlloc(allocator, newSize);
+			memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+			return newPtr;
+		}
+	}
+
 
 	Allocator* MemoryGlobals::GetDefaultAllocator()
 	{
@@ -42,4 +306,46 @@ namespace Skore
 		};
 		return &heapAllocator;
 	}
-}
\ No newline at end of file
+
+	Allocator* MemoryGlobals::GetFrameAllocator()
+	{
+		static Allocator frameAllocator = {
+			.allocator = nullptr,
+			.MemAlloc = FrameMemAlloc,
+			.MemFree = FrameMemFree,
+			.MemRealloc = FrameMemRealloc
+		};
+		return &frameAllocator;
+	}
+
+	void MemoryGlobals::ResetFrameAllocator()
+	{
+		std::lock_guard lock(FrameArenasMutex());
+
+		u64   frame = frameIndex.load(std::memory_order_relaxed);
+		usize used = 0;
+		for (FrameArena* arena = frameArenas; arena != nullptr; arena = arena->next)
+		{
+			if (arena->frame.load(std::memory_order_acquire) == frame)
+			{
+				used += arena->used.load(std::memory_order_relaxed);
+			}
+		}
+		lastFrameUsed = used;
+
+		//arenas are reset lazily by their own threads on the next allocation
+		frameIndex.store(frame + 1, std::memory_order_release);
+	}
+
+	FrameAllocatorStats MemoryGlobals::GetFrameAllocatorStats()
+	{
+		std::lock_guard lock(FrameArenasMutex());
+
+		usize reserved = 0;
+		for (FrameArena* arena = frameArenas; arena != nullptr; arena = arena->next)
+		{
+			reserved += arena->reserved.load(std::memory_order_relaxed);
+		}
+		return FrameAllocatorStats{lastFrameUsed, reserved};
+	}
+}
@@ -48,10 +48,23 @@ namespace Skore
 		}
 	};
 
+	struct FrameAllocatorStats
+	{
+		usize used;     // bytes allocated by all threads during the last completed frame
+		usize reserved; // bytes currently reserved by all frame arenas
+	};
+
 	struct SK_API MemoryGlobals
 	{
 		static Allocator* GetDefaultAllocator();
 		static Allocator* GetHeapAllocator();
+
+		// Per-thread bump allocator, each thread owns two arenas that are swapped every frame.
+		// Memory stays valid until the end of the next frame, MemFree is a no-op except for the last allocation of the thread.
+		// Copies and moves of frame allocated containers keep the frame allocator, use CopyFromFrame to keep the data longer.
+		static Allocator*          GetFrameAllocator();
+		static void                ResetFrameAllocator(); // called once per frame by App
+		static FrameAllocatorStats GetFrameAllocatorStats();
 	};
 
 	template <typename Type, typename... Args>
@@ -96,6 +109,13 @@ namespace Skore
 		alloc->MemFree(alloc->allocator, ptr);
 	}
 
+	// copies a container (Array, String) to the default allocator, so it outlives the frame allocator it was built with.
+	template <typename T>
+	T CopyFromFrame(const T& value)
+	{
+		return T(value, MemoryGlobals::GetDefaultAllocator());
+	}
+
 
 	template <typename T>
 	class StdAllocator
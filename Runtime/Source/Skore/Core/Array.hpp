@@ -37,6 +37,7 @@ namespace Skore
 		Array(const FixedArray<T, size>& arr);
 		Array(Allocator* allocator);
 		Array(Allocator* allocator, usize size);
+		Array(const Array& other, Allocator* allocator);
 
 
 		Iterator      begin();
@@ -129,6 +130,13 @@ namespace Skore
 		Insert(begin(), other.begin(), other.m_last);
 	}
 
+	template <typename T>
+	SK_FINLINE Array<T>::Array(const Array& other, Allocator* allocator) : m_first(0), m_last(0), m_capacity(0), m_allocator(allocator)
+	{
+		Reserve(other.Size());
+		Insert(begin(), other.begin(), other.m_last);
+	}
+
 	template <typename T>
 	SK_FINLINE Array<T>::Array(Array&& other) noexcept
 	{
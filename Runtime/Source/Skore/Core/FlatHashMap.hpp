@@ -0,0 +1,668 @@
+#pragma once
+
+#include "Skore/Common.hpp"
+#include "Hash.hpp"
+#include "HashMap.hpp"
+#include "Pair.hpp"
+#include "Allocator.hpp"
+#include "Traits.hpp"
+
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define SK_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Skore
+{
+	// control byte of each slot, full slots store the low 7 bits of the hash (H2).
+	enum FlatHashCtrl : i8
+	{
+		FlatHashCtrl_Empty = -128,
+		FlatHashCtrl_Deleted = -2,
+	};
+
+	// 16 control bytes scanned at once, bit i of the returned masks refers to slot i of the group.
+	struct FlatHashGroup
+	{
+		static constexpr usize Width = 16;
+
+		const i8* ctrl;
+
+		SK_FINLINE u32 Match(i8 h2) const
+		{
+#if SK_FLAT_HASH_SSE2
+			__m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+			return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), group)));
+#else
+			u32 mask = 0;
+			for (u32 i = 0; i < Width; ++i)
+			{
+				mask |= static_cast<u32>(ctrl[i] == h2) << i;
+			}
+			return mask;
+#endif
+		}
+
+		SK_FINLINE u32 MatchEmpty() const
+		{
+			return Match(FlatHashCtrl_Empty);
+		}
+
+		// empty or deleted, both have the sign bit set.
+		SK_FINLINE u32 MatchAvailable() const
+		{
+#if SK_FLAT_HASH_SSE2
+			return static_cast<u32>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))));
+#else
+			u32 mask = 0;
+			for (u32 i = 0; i < Width; ++i)
+			{
+				mask |= static_cast<u32>(ctrl[i] < 0) << i;
+			}
+			return mask;
+#endif
+		}
+
+		static SK_FINLINE u32 LowestBit(u32 mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return index;
+#else
+			return static_cast<u32>(__builtin_ctz(mask));
+#endif
+		}
+	};
+
+	// T is Pair<Key, Value> for iterators and const Pair<Key, Value> for const iterators.
+	template <typename T>
+	struct FlatHashIterator
+	{
+		T*        slot{};
+		const i8* ctrl{};
+		const i8* ctrlEnd{};
+
+		FlatHashIterator() = default;
+
+		FlatHashIterator(T* slot, const i8* ctrl, const i8* ctrlEnd) : slot(slot), ctrl(ctrl), ctrlEnd(ctrlEnd) {}
+
+		// iterators convert to const iterators
+		template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, T>>>
+		FlatHashIterator(const FlatHashIterator<Other>& other) : slot(other.slot), ctrl(other.ctrl), ctrlEnd(other.ctrlEnd) {}
+
+		T* operator->() const
+		{
+			return slot;
+		}
+
+		T& operator*() const
+		{
+			return *slot;
+		}
+
+		explicit operator bool() const noexcept
+		{
+			return slot != nullptr;
+		}
+
+		FlatHashIterator& operator++()
+		{
+			do
+			{
+				++slot;
+				++ctrl;
+			}
+			while (ctrl != ctrlEnd && *ctrl < 0);
+
+			if (ctrl == ctrlEnd)
+			{
+				slot = nullptr;
+			}
+			return *this;
+		}
+
+		template <typename Other>
+		bool operator==(const FlatHashIterator<Other>& other) const
+		{
+			return slot == other.slot;
+		}
+
+		template <typename Other>
+		bool operator!=(const FlatHashIterator<Other>& other) const
+		{
+			return slot != other.slot;
+		}
+	};
+
+	// Open addressing hash map with the HashMap API. Slots are stored inline in a single array, split in groups of 16
+	// with one control byte per slot, and lookups probe a whole group per step with SIMD compares.
+	// Unlike HashMap, inserting can move entries: pointers and iterators are only stable until the next insertion.
+	// Find/Has/Erase accept any key type hashed and compared like Key, e.g. StringView for String keys.
+	template <typename Key, typename Value>
+	class FlatHashMap
+	{
+	public:
+		typedef Pair<Key, Value>                  ValueType;
+		typedef FlatHashIterator<ValueType>       Iterator;
+		typedef FlatHashIterator<const ValueType> ConstIterator;
+
+		FlatHashMap() = default;
+		FlatHashMap(Allocator* allocator);
+		FlatHashMap(const FlatHashMap& other);
+		FlatHashMap(FlatHashMap&& other) noexcept;
+		FlatHashMap& operator=(const FlatHashMap& other);
+		FlatHashMap& operator=(FlatHashMap&& other) noexcept;
+
+		Iterator      begin();
+		Iterator      end();
+		ConstIterator begin() const;
+		ConstIterator end() const;
+
+		void  Clear();
+		bool  Empty() const;
+		usize Size() const;
+		usize Capacity() const;
+		void  Reserve(usize size);
+
+		template <typename ParamKey>
+		Iterator Find(const ParamKey& key);
+
+		template <typename ParamKey>
+		ConstIterator Find(const ParamKey& key) const;
+
+		void Erase(Iterator where);
+
+		template <typename ParamKey>
+		void Erase(const ParamKey& key);
+
+		Value& operator[](const Key& key);
+
+		Pair<Iterator, bool> Insert(const Pair<Key, Value>& p);
+		Pair<Iterator, bool> Insert(const Key& key, const Value& value);
+
+		Pair<Iterator, bool> Emplace(const Key& key, Value&& value);
+
+		template <typename ParamKey>
+		bool Has(const ParamKey& key) const;
+
+		void Swap(FlatHashMap& other);
+
+		~FlatHashMap();
+
+	private:
+		i8*        m_ctrl = nullptr;
+		ValueType* m_slots = nullptr;
+		usize      m_capacity = 0; //multiple of FlatHashGroup::Width, power of two
+		usize      m_size = 0;
+		usize      m_growthLeft = 0;
+		Allocator* m_allocator = MemoryGlobals::GetDefaultAllocator();
+
+		static SK_FINLINE usize HashKey(usize hash)
+		{
+			//Hash<T> of small integers and pointers doesn't spread the bits used for H1/H2
+			u64 h = (static_cast<u64>(hash) ^ (static_cast<u64>(hash) >> 32)) * 0x9E3779B97F4A7C15ull;
+			return static_cast<usize>(h ^ (h >> 29));
+		}
+
+		static SK_FINLINE i8 H2(usize hash)
+		{
+			return static_cast<i8>(hash & 0x7F);
+		}
+
+		static SK_FINLINE usize MaxLoad(usize capacity)
+		{
+			return capacity - capacity / 8;
+		}
+
+		template <typename ParamKey>
+		usize FindIndex(const ParamKey& key) const;
+
+		usize FindInsertIndex(usize hash) const;
+		usize PrepareInsert(usize hash);
+		void  Resize(usize newCapacity);
+		void  DestroySlots();
+		Iterator MakeIterator(usize index) const;
+	};
+
+	template <typename Key, typename Value>
+	FlatHashMap<Key, Value>::FlatHashMap(Allocator* allocator) : m_allocator(allocator) {}
+
+	template <typename Key, typename Value>
+	FlatHashMap<Key, Value>::FlatHashMap(const FlatHashMap& other) : m_allocator(other.m_allocator)
+	{
+		Reserve(other.m_size);
+		for (const ValueType& it : other)
+		{
+			Insert(it);
+		}
+	}
+
+	template <typename Key, typename Value>
+	FlatHashMap<Key, Value>::FlatHashMap(FlatHashMap&& other) noexcept : m_allocator(other.m_allocator)
+	{
+		Swap(other);
+	}
+
+	template <typename Key, typename Value>
+	FlatHashMap<Key, Value>& FlatHashMap<Key, Value>::operator=(const FlatHashMap& other)
+	{
+		if (this != &other)
+		{
+			FlatHashMap(other).Swap(*this);
+		}
+		return *this;
+	}
+
+	template <typename Key, typename Value>
+	FlatHashMap<Key, Value>& FlatHashMap<Key, Value>::operator=(FlatHashMap&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Clear();
+			Swap(other);
+		}
+		return *this;
+	}
+
+	template <typename Key, typename Value>
+	typename FlatHashMap<Key, Value>::Iterator FlatHashMap<Key, Value>::MakeIterator(usize index) const
+	{
+		return Iterator{m_slots + index, m_ctrl + index, m_ctrl + m_capacity};
+	}
+
+	template <typename Key, typename Value>
+	SK_FINLINE typename FlatHashMap<Key, Value>::Iterator FlatHashMap<Key, Value>::begin()
+	{
+		if (m_size == 0) return {};
+
+		usize index = 0;
+		while (m_ctrl[index] < 0)
+		{
+			++index;
+		}
+		return MakeIterator(index);
+	}
+
+	template <typename Key, typename Value>
+	SK_FINLINE typename FlatHashMap<Key, Value>::Iterator FlatHashMap<Key, Value>::end()
+	{
+		return {};
+	}
+
+	template <typename Key, typename Value>
+	SK_FINLINE typename FlatHashMap<Key, Value>::ConstIterator FlatHashMap<Key, Value>::begin() const
+	{
+		return const_cast<FlatHashMap*>(this)->begin();
+	}
+
+	template <typename Key, typename Value>
+	SK_FINLINE typename FlatHashMap<Key, Value>::ConstIterator FlatHashMap<Key, Value>::end() const
+	{
+		return {};
+	}
+
+	template <typename Key, typename Value>
+	void FlatHashMap<Key, Value>::DestroySlots()
+	{
+		if constexpr (!std::is_trivially_destructible_v<ValueType>)
+		{
+			for (usize i = 0; i < m_capacity; ++i)
+			{
+				if (m_ctrl[i] >= 0)
+				{
+					m_slots[i].~ValueType();
+				}
+			}
+		}
+	}
+
+	template <typename Key, typename Value>
+	void FlatHashMap<Key, Value>::Clear()
+	{
+		if (m_capacity == 0) return;
+
+		DestroySlots();
+		m_allocator->MemFree(m_allocator->allocator, m_ctrl);
+
+		m_ctrl = nullptr;
+		m_slots = nullptr;
+		m_capacity = 0;
+		m_size = 0;
+		m_growthLeft = 0;
+	}
+
+	template <typename Key, typename Value>
+	SK_FINLINE bool FlatHashMap<Key, Value>::Empty() const
+	{
+		return m_size == 0;
+	}
+
+	template <typename Key, typename Value>
+	SK_FINLINE usize FlatHashMap<Key, Value>::Size() const
+	{
+		return m_size;
+	}
+
+	template <typename Key, typename Value>
+	SK_FINLINE usize FlatHashMap<Key, Value>::Capacity() const
+	{
+		return m_capacity;
+	}
+
+	template <typename Key, typename Value>
+	void FlatHashMap<Key, Value>::Reserve(usize size)
+	{
+		usize capacity = m_capacity > 0 ? m_capacity : FlatHashGroup::Width;
+		while (MaxLoad(capacity) < size)
+		{
+			capacity *= 2;
+		}
+
+		if (capacity > m_capacity)
+		{
+			Resize(capacity);
+		}
+	}
+
+	template <typename Key, typename Value>
+	void FlatHashMap<Key, Value>::Resize(usize newCapacity)
+	{
+		i8*        oldCtrl = m_ctrl;
+		ValueType* oldSlots = m_slots;
+		usize      oldCapacity = m_capacity;
+
+		//control bytes and slots share one allocation, slots start aligned after the control bytes
+		usize ctrlSize = (newCapacity + alignof(ValueType) - 1) & ~(alignof(ValueType) - 1);
+		u8*   memory = static_cast<u8*>(m_allocator->MemAlloc(m_allocator->allocator, ctrlSize + newCapacity * sizeof(ValueType)));
+
+		m_ctrl = reinterpret_cast<i8*>(memory);
+		m_slots = reinterpret_cast<ValueType*>(memory + ctrlSize);
+		m_capacity = newCapacity;
+		m_growthLeft = MaxLoad(newCapacity) - m_size;
+
+		memset(m_ctrl, static_cast<u8>(FlatHashCtrl_Empty), newCapacity);
+
+		for (usize i = 0; i < oldCapacity; ++i)
+		{
+			if (oldCtrl[i] >= 0)
+			{
+				usize hash = HashKey(Hash<Key>::Value(oldSlots[i].first));
+				usize index = FindInsertIndex(hash);
+				m_ctrl[index] = H2(hash);
+				new(PlaceHolder(), m_slots + index) ValueType(Traits::Move(oldSlots[i]));
+				oldSlots[i].~ValueType();
+			}
+		}
+
+		if (oldCtrl)
+		{
+			m_allocator->MemFree(m_allocator->allocator, oldCtrl);
+		}
+	}
+
+	template <typename Key, typename Value>
+	template <typename ParamKey>
+	SK_FINLINE usize FlatHashMap<Key, Value>::FindIndex(const ParamKey& key) const
+	{
+		if (m_size == 0) return nPos;
+
+		usize hash = HashKey(Hash<Key>::Value(key));
+		i8    h2 = H2(hash);
+		usize groupMask = m_capacity / FlatHashGroup::Width - 1;
+		usize group = (hash >> 7) & groupMask;
+
+		//triangular probing over groups visits every group once when the group count is a power of two
+		for (usize step = 1; ; ++step)
+		{
+			FlatHashGroup probe{m_ctrl + group * FlatHashGroup::Width};
+
+			u32 match = probe.Match(h2);
+			while (match != 0)
+			{
+				usize index = group * FlatHashGroup::Width + FlatHashGroup::LowestBit(match);
+				if (m_slots[index].first == key)
+				{
+					return index;
+				}
+				match &= match - 1;
+			}
+
+			if (probe.MatchEmpty() != 0 || step > groupMask)
+			{
+				return nPos;
+			}
+
+			group = (group + step) & groupMask;
+		}
+	}
+
+	template <typename Key, typename Value>
+	SK_FINLINE usize FlatHashMap<Key, Value>::FindInsertIndex(usize hash) const
+	{
+		usize groupMask = m_capacity / FlatHashGroup::Width - 1;
+		usize group = (hash >> 7) & groupMask;
+
+		for (usize step = 1; ; ++step)
+		{
+			FlatHashGroup probe{m_ctrl + group * FlatHashGroup::Width};
+			if (u32 available = probe.MatchAvailable())
+			{
+				return group * FlatHashGroup::Width + FlatHashGroup::LowestBit(available);
+			}
+			group = (group + step) & groupMask;
+		}
+	}
+
+	template <typename Key, typename Value>
+	usize FlatHashMap<Key, Value>::PrepareInsert(usize hash)
+	{
+		if (m_growthLeft == 0)
+		{
+			//many deleted slots, rehash in place instead of growing
+			usize capacity = m_capacity == 0 ? FlatHashGroup::Width : m_capacity;
+			Resize(m_size < MaxLoad(capacity) / 2 ? capacity : capacity * 2);
+		}
+
+		usize index = FindInsertIndex(hash);
+		if (m_ctrl[index] == FlatHashCtrl_Empty)
+		{
+			--m_growthLeft;
+		}
+
+		m_ctrl[index] = H2(hash);
+		++m_size;
+		return index;
+	}
+
+	template <typename Key, typename Value>
+	template <typename ParamKey>
+	SK_FINLINE typename FlatHashMap<Key, Value>::Iterator FlatHashMap<Key, Value>::Find(const ParamKey& key)
+	{
+		usize index = FindIndex(key);
+		return index != nPos ? MakeIterator(index) : Iterator{};
+	}
+
+	template <typename Key, typename Value>
+	template <typename ParamKey>
+	SK_FINLINE typename FlatHashMap<Key, Value>::ConstIterator FlatHashMap<Key, Value>::Find(const ParamKey& key) const
+	{
+		usize index = FindIndex(key);
+		return index != nPos ? ConstIterator{MakeIterator(index)} : ConstIterator{};
+	}
+
+	template <typename Key, typename Value>
+	template <typename ParamKey>
+	SK_FINLINE bool FlatHashMap<Key, Value>::Has(const ParamKey& key) const
+	{
+		return FindIndex(key) != nPos;
+	}
+
+	template <typename Key, typename Value>
+	Pair<typename FlatHashMap<Key, Value>::Iterator, bool> FlatHashMap<Key, Value>::Insert(const Pair<Key, Value>& p)
+	{
+		usize index = FindIndex(p.first);
+		if (index != nPos)
+		{
+			return {MakeIterator(index), false};
+		}
+
+		index = PrepareInsert(HashKey(Hash<Key>::Value(p.first)));
+		new(PlaceHolder(), m_slots + index) ValueType(p);
+		return {MakeIterator(index), true};
+	}
+
+	template <typename Key, typename Value>
+	SK_FINLINE Pair<typename FlatHashMap<Key, Value>::Iterator, bool> FlatHashMap<Key, Value>::Insert(const Key& key, const Value& value)
+	{
+		return Insert(Pair<Key, Value>(key, value));
+	}
+
+	template <typename Key, typename Value>
+	Pair<typename FlatHashMap<Key, Value>::Iterator, bool> FlatHashMap<Key, Value>::Emplace(const Key& key, Value&& value)
+	{
+		usize index = FindIndex(key);
+		if (index != nPos)
+		{
+			return {MakeIterator(index), false};
+		}
+
+		index = PrepareInsert(HashKey(Hash<Key>::Value(key)));
+		new(PlaceHolder(), m_slots + index) ValueType(Key(key), Traits::Forward<Value>(value));
+		return {MakeIterator(index), true};
+	}
+
+	template <typename Key, typename Value>
+	Value& FlatHashMap<Key, Value>::operator[](const Key& key)
+	{
+		usize index = FindIndex(key);
+		if (index == nPos)
+		{
+			index = PrepareInsert(HashKey(Hash<Key>::Value(key)));
+			new(PlaceHolder(), m_slots + index) ValueType(Key(key), Value());
+		}
+		return m_slots[index].second;
+	}
+
+	template <typename Key, typename Value>
+	void FlatHashMap<Key, Value>::Erase(Iterator where)
+	{
+		usize index = where.slot - m_slots;
+		m_slots[index].~ValueType();
+		--m_size;
+
+		//a group with an empty slot stops every probe, so the slot can become empty again
+		FlatHashGroup group{m_ctrl + (index & ~(FlatHashGroup::Width - 1))};
+		if (group.MatchEmpty() != 0)
+		{
+			m_ctrl[index] = FlatHashCtrl_Empty;
+			++m_growthLeft;
+		}
+		else
+		{
+			m_ctrl[index] = FlatHashCtrl_Deleted;
+		}
+	}
+
+	template <typename Key, typename Value>
+	template <typename ParamKey>
+	void FlatHashMap<Key, Value>::Erase(const ParamKey& key)
+	{
+		usize index = FindIndex(key);
+		if (index != nPos)
+		{
+			Erase(MakeIterator(index));
+		}
+	}
+
+	template <typename Key, typename Value>
+	void FlatHashMap<Key, Value>::Swap(FlatHashMap& other)
+	{
+		std::swap(m_ctrl, other.m_ctrl);
+		std::swap(m_slots, other.m_slots);
+		std::swap(m_capacity, other.m_capacity);
+		std::swap(m_size, other.m_size);
+		std::swap(m_growthLeft, other.m_growthLeft);
+		std::swap(m_allocator, other.m_allocator);
+	}
+
+	template <typename Key, typename Value>
+	FlatHashMap<Key, Value>::~FlatHashMap()
+	{
+		Clear();
+	}
+
+	template <typename Key, typename Value>
+	struct TypeApi<FlatHashMap<Key, Value>>
+	{
+		static void GetApi(VoidPtr pointer)
+		{
+			new(PlaceHolder{}, pointer) HashMapApi{};
+			HashMapApi& api = *static_cast<HashMapApi*>(pointer);
+
+			api.Size = [](ConstPtr instance)
+			{
+				return static_cast<const FlatHashMap<Key, Value>*>(instance)->Size();
+			};
+
+			api.GetKeyProps = []
+			{
+				return TypeInfo<Key>::GetProps();
+			};
+
+			api.GetValueProps = []
+			{
+				return TypeInfo<Value>::GetProps();
+			};
+
+			api.Create = []
+			{
+				return static_cast<VoidPtr>(Alloc<FlatHashMap<Key, Value>>());
+			};
+
+			api.Destroy = [](VoidPtr instance)
+			{
+				DestroyAndFree(static_cast<FlatHashMap<Key, Value>*>(instance));
+			};
+
+			api.Copy = [](VoidPtr dest, ConstPtr src)
+			{
+				*static_cast<FlatHashMap<Key, Value>*>(dest) = *static_cast<const FlatHashMap<Key, Value>*>(src);
+			};
+
+			api.Clear = [](VoidPtr instance)
+			{
+				static_cast<FlatHashMap<Key, Value>*>(instance)->Clear();
+			};
+
+			api.Insert = [](VoidPtr instance, ConstPtr key, ConstPtr value)
+			{
+				static_cast<FlatHashMap<Key, Value>*>(instance)->Insert(*static_cast<const Key*>(key), *static_cast<const Value*>(value));
+			};
+
+			api.ForEach = [](ConstPtr instance, bool (*fn)(ConstPtr key, ConstPtr value, VoidPtr ctx), VoidPtr ctx)
+			{
+				const FlatHashMap<Key, Value>& map = *static_cast<const FlatHashMap<Key, Value>*>(instance);
+				for (auto it = map.begin(); it != map.end(); ++it)
+				{
+					if (!fn(&it->first, &it->second, ctx))
+					{
+						break;
+					}
+				}
+			};
+		}
+
+		static constexpr TypeID GetApiId()
+		{
+			return TypeInfo<HashMapApi>::ID();
+		}
+	};
+}
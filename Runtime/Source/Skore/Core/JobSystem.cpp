@@ -0,0 +1,603 @@
+#include "JobSystem.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "Skore/Core/Allocator.hpp"
+#include "Skore/Core/Array.hpp"
+#include "Skore/Core/Logger.hpp"
+#include "Skore/Platform/Platform.hpp"
+
+namespace Skore
+{
+	namespace
+	{
+		constexpr u32 JobPoolCapacity = 2048;
+		constexpr u32 DequeCapacity = 4096;
+		constexpr u32 MaxThreadContexts = 128;
+		constexpr u32 SpinCountBeforeSleep = 64;
+
+		enum class JobState : u32
+		{
+			Free,
+			Allocated
+		};
+	}
+
+	struct Job
+	{
+		FnJobFunction         function;
+		Job*                  parent;
+		std::atomic<i32>      unfinishedJobs;
+		std::atomic<i32>      waitCount;
+		std::atomic<u32>      generation;
+		std::atomic<JobState> state;
+		std::atomic<bool>     lock;
+		bool                  finished;
+		u32                   continuationCount;
+		Job*                  continuations[JobSystem::MaxContinuations];
+		alignas(16) u8        storage[JobSystem::JobStorageSize];
+
+		void Lock()
+		{
+			while (lock.exchange(true, std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		void Unlock()
+		{
+			lock.store(false, std::memory_order_release);
+		}
+	};
+
+	namespace
+	{
+		// Chase-Lev deque, the owner thread pushes and pops at the bottom, other threads steal from the top.
+		struct JobDeque
+		{
+			std::atomic<i64>  top{0};
+			std::atomic<i64>  bottom{0};
+			std::atomic<Job*> jobs[DequeCapacity]{};
+
+			bool Push(Job* job)
+			{
+				i64 b = bottom.load(std::memory_order_relaxed);
+				i64 t = top.load(std::memory_order_acquire);
+				if (b - t >= DequeCapacity)
+				{
+					return false;
+				}
+				jobs[b & (DequeCapacity - 1)].store(job, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return true;
+			}
+
+			Job* Pop()
+			{
+				i64 b = bottom.load(std::memory_order_relaxed) - 1;
+				bottom.store(b, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				i64 t = top.load(std::memory_order_relaxed);
+
+				if (t > b)
+				{
+					bottom.store(b + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				Job* job = jobs[b & (DequeCapacity - 1)].load(std::memory_order_relaxed);
+				if (t == b)
+				{
+					// last job, race against stealers
+					if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					{
+						job = nullptr;
+					}
+					bottom.store(b + 1, std::memory_order_relaxed);
+				}
+				return job;
+			}
+
+			Job* Steal()
+			{
+				i64 t = top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				i64 b = bottom.load(std::memory_order_acquire);
+				if (t >= b)
+				{
+					return nullptr;
+				}
+
+				Job* job = jobs[t & (DequeCapacity - 1)].load(std::memory_order_relaxed);
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					return nullptr;
+				}
+				return job;
+			}
+		};
+
+		// One context per thread that touches the job system, workers own theirs for the lifetime of the system,
+		// other threads adopt a context on first use and release it when the thread exits.
+		struct ThreadContext
+		{
+			JobDeque          deque;
+			Job               jobs[JobPoolCapacity]{};
+			u32               nextJob = 0;
+			u32               index = 0;
+			u32               stealIndex = 0;
+			std::atomic<bool> owned{false};
+		};
+
+		struct JobSystemState
+		{
+			std::atomic<ThreadContext*> contexts[MaxThreadContexts]{};
+			std::atomic<u32>            contextCount{0};
+			Array<std::thread>          workers;
+			std::atomic<u64>            queuedJobs{0};
+			std::atomic<u64>            pendingJobs{0};
+			std::atomic<u32>            sleepingWorkers{0};
+			std::atomic<bool>           running{false};
+			std::mutex                  sleepMutex;
+			std::condition_variable     sleepCondition;
+			std::mutex                  initMutex;
+			std::atomic<u64>            epoch{0};
+
+			~JobSystemState()
+			{
+				JobSystem::Shutdown();
+			}
+		};
+
+		JobSystemState state;
+
+		struct CurrentThreadContext
+		{
+			ThreadContext* context = nullptr;
+			u64            epoch = 0;
+			bool           worker = false;
+
+			~CurrentThreadContext()
+			{
+				if (context && !worker && epoch == state.epoch.load(std::memory_order_acquire))
+				{
+					context->owned.store(false, std::memory_order_release);
+				}
+			}
+		};
+
+		thread_local CurrentThreadContext currentThreadContext;
+
+		Logger& logger = Logger::GetLogger("Skore::JobSystem");
+
+		void EnsureInitialized()
+		{
+			if (!state.running.load(std::memory_order_acquire))
+			{
+				JobSystem::Init();
+			}
+		}
+
+		ThreadContext* AcquireContext()
+		{
+			u32 count = state.contextCount.load(std::memory_order_acquire);
+			for (u32 i = 0; i < count; ++i)
+			{
+				ThreadContext* context = state.contexts[i].load(std::memory_order_acquire);
+				bool           expected = false;
+				if (context && context->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+				{
+					return context;
+				}
+			}
+
+			ThreadContext* context = Alloc<ThreadContext>();
+			context->owned.store(true, std::memory_order_relaxed);
+
+			u32 index = state.contextCount.fetch_add(1, std::memory_order_acq_rel);
+			SK_ASSERT(index < MaxThreadContexts, "too many threads using the job system");
+			if (index >= MaxThreadContexts)
+			{
+				logger.Error("max number of job system threads reached ({})", MaxThreadContexts);
+				state.contextCount.fetch_sub(1, std::memory_order_acq_rel);
+				return nullptr;
+			}
+
+			context->index = index;
+			context->stealIndex = index;
+			state.contexts[index].store(context, std::memory_order_release);
+			return context;
+		}
+
+		ThreadContext* GetCurrentContext()
+		{
+			u64 epoch = state.epoch.load(std::memory_order_acquire);
+			if (currentThreadContext.context == nullptr || currentThreadContext.epoch != epoch)
+			{
+				currentThreadContext.context = AcquireContext();
+				currentThreadContext.epoch = epoch;
+				currentThreadContext.worker = false;
+			}
+			return currentThreadContext.context;
+		}
+
+		void Execute(Job* job);
+
+		Job* GetJob(ThreadContext* context)
+		{
+			if (context)
+			{
+				if (Job* job = context->deque.Pop())
+				{
+					return job;
+				}
+			}
+
+			u32 count = state.contextCount.load(std::memory_order_acquire);
+			if (count == 0)
+			{
+				return nullptr;
+			}
+
+			u32 start = context ? ++context->stealIndex : 0;
+			for (u32 i = 0; i < count; ++i)
+			{
+				ThreadContext* other = state.contexts[(start + i) % count].load(std::memory_order_acquire);
+				if (other && other != context)
+				{
+					if (Job* job = other->deque.Steal())
+					{
+						return job;
+					}
+				}
+			}
+			return nullptr;
+		}
+
+		bool TryExecuteOne(ThreadContext* context)
+		{
+			if (Job* job = GetJob(context))
+			{
+				state.queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+				Execute(job);
+				return true;
+			}
+			return false;
+		}
+
+		void WakeWorkers(u32 count)
+		{
+			if (state.sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+			{
+				{
+					std::lock_guard lock(state.sleepMutex);
+				}
+
+				if (count == 1)
+				{
+					state.sleepCondition.notify_one();
+				}
+				else
+				{
+					state.sleepCondition.notify_all();
+				}
+			}
+		}
+
+		void Enqueue(Job* job)
+		{
+			ThreadContext* context = GetCurrentContext();
+
+			state.queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+			if (context == nullptr || !context->deque.Push(job))
+			{
+				// deque is full, run it in place instead.
+				state.queuedJobs.fetch_sub(1, std::memory_order_seq_cst);
+				Execute(job);
+				return;
+			}
+			WakeWorkers(1);
+		}
+
+		void ReleaseWait(Job* job)
+		{
+			if (job->waitCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				Enqueue(job);
+			}
+		}
+
+		void Finish(Job* job)
+		{
+			if (job->unfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			{
+				return;
+			}
+
+			Job* continuations[JobSystem::MaxContinuations];
+			u32  continuationCount;
+
+			job->Lock();
+			job->finished = true;
+			continuationCount = job->continuationCount;
+			for (u32 i = 0; i < continuationCount; ++i)
+			{
+				continuations[i] = job->continuations[i];
+			}
+			job->continuationCount = 0;
+			job->Unlock();
+
+			for (u32 i = 0; i < continuationCount; ++i)
+			{
+				ReleaseWait(continuations[i]);
+			}
+
+			Job* parent = job->parent;
+			state.pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+			job->state.store(JobState::Free, std::memory_order_release);
+
+			if (parent)
+			{
+				Finish(parent);
+			}
+		}
+
+		void Execute(Job* job)
+		{
+			job->function(job->storage);
+			Finish(job);
+		}
+
+		Job* AllocJob(ThreadContext* context)
+		{
+			while (true)
+			{
+				for (u32 i = 0; i < JobPoolCapacity; ++i)
+				{
+					Job* job = &context->jobs[context->nextJob++ & (JobPoolCapacity - 1)];
+					if (job->state.load(std::memory_order_acquire) == JobState::Free)
+					{
+						job->state.store(JobState::Allocated, std::memory_order_relaxed);
+						return job;
+					}
+				}
+
+				// every job of this thread is in flight, help until one is released.
+				if (!TryExecuteOne(context))
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		void WorkerMain(ThreadContext* context)
+		{
+			currentThreadContext.context = context;
+			currentThreadContext.epoch = state.epoch.load(std::memory_order_acquire);
+			currentThreadContext.worker = true;
+
+			u32 spinCount = 0;
+
+			while (state.running.load(std::memory_order_acquire))
+			{
+				if (TryExecuteOne(context))
+				{
+					spinCount = 0;
+					continue;
+				}
+
+				if (++spinCount < SpinCountBeforeSleep)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				spinCount = 0;
+
+				std::unique_lock lock(state.sleepMutex);
+				state.sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+				state.sleepCondition.wait(lock, []
+				{
+					return state.queuedJobs.load(std::memory_order_seq_cst) > 0 || !state.running.load(std::memory_order_seq_cst);
+				});
+				state.sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+			}
+		}
+	}
+
+	void JobSystem::Init(u32 workerCount)
+	{
+		std::lock_guard lock(state.initMutex);
+		if (state.running.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		if (workerCount == 0)
+		{
+			u32 cores = std::thread::hardware_concurrency();
+			workerCount = cores > 1 ? cores - 1 : 1;
+		}
+
+		state.epoch.fetch_add(1, std::memory_order_acq_rel);
+		state.running.store(true, std::memory_order_release);
+
+		for (u32 i = 0; i < workerCount; ++i)
+		{
+			ThreadContext* context = AcquireContext();
+			if (context == nullptr)
+			{
+				break;
+			}
+
+			std::thread thread(WorkerMain, context);
+			auto        name = fmt::format("JobWorker {}", i);
+			Platform::SetThreadName(thread, {name.c_str(), name.size()});
+			state.workers.EmplaceBack(Traits::Move(thread));
+		}
+
+		logger.Debug("job system initialized with {} workers", state.workers.Size());
+	}
+
+	void JobSystem::Shutdown()
+	{
+		std::lock_guard lock(state.initMutex);
+		if (!state.running.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		// drain everything that was already submitted
+		while (state.queuedJobs.load(std::memory_order_acquire) > 0)
+		{
+			if (!TryExecuteOne(nullptr))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		{
+			std::lock_guard sleepLock(state.sleepMutex);
+			state.running.store(false, std::memory_order_seq_cst);
+		}
+		state.sleepCondition.notify_all();
+
+		for (std::thread& worker : state.workers)
+		{
+			worker.join();
+		}
+		state.workers.Clear();
+
+		u32 count = state.contextCount.exchange(0, std::memory_order_acq_rel);
+		for (u32 i = 0; i < count; ++i)
+		{
+			if (ThreadContext* context = state.contexts[i].exchange(nullptr, std::memory_order_acq_rel))
+			{
+				DestroyAndFree(context);
+			}
+		}
+
+		state.queuedJobs.store(0, std::memory_order_release);
+		state.pendingJobs.store(0, std::memory_order_release);
+		state.epoch.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	u32 JobSystem::GetWorkerCount()
+	{
+		EnsureInitialized();
+		return static_cast<u32>(state.workers.Size());
+	}
+
+	bool JobSystem::IsWorkerThread()
+	{
+		return currentThreadContext.worker && currentThreadContext.epoch == state.epoch.load(std::memory_order_acquire);
+	}
+
+	JobHandle JobSystem::CreateJob(FnJobFunction function, VoidPtr* storage, JobHandle parent)
+	{
+		EnsureInitialized();
+
+		ThreadContext* context = GetCurrentContext();
+		SK_ASSERT(context, "thread has no job context");
+
+		Job* job = AllocJob(context);
+
+		job->Lock();
+		u32 generation = job->generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+		job->finished = false;
+		job->continuationCount = 0;
+		job->Unlock();
+
+		job->function = function;
+		job->parent = nullptr;
+		job->unfinishedJobs.store(1, std::memory_order_relaxed);
+		job->waitCount.store(1, std::memory_order_relaxed);
+
+		if (parent.job)
+		{
+			SK_ASSERT(parent.job->generation.load(std::memory_order_acquire) == parent.generation, "parent job is already completed");
+			SK_ASSERT(parent.job->unfinishedJobs.load(std::memory_order_acquire) > 0, "parent job is already completed");
+			parent.job->unfinishedJobs.fetch_add(1, std::memory_order_acq_rel);
+			job->parent = parent.job;
+		}
+
+		*storage = job->storage;
+		return JobHandle{job, generation};
+	}
+
+	void JobSystem::AddContinuation(JobHandle ancestor, JobHandle continuation)
+	{
+		SK_ASSERT(continuation.job, "invalid continuation");
+		if (!ancestor.job)
+		{
+			return;
+		}
+
+		Job* job = ancestor.job;
+		Job* next = continuation.job;
+
+		next->waitCount.fetch_add(1, std::memory_order_acq_rel);
+
+		bool added = false;
+		job->Lock();
+		if (job->generation.load(std::memory_order_acquire) == ancestor.generation && !job->finished)
+		{
+			SK_ASSERT(job->continuationCount < MaxContinuations, "max number of continuations reached");
+			if (job->continuationCount < MaxContinuations)
+			{
+				job->continuations[job->continuationCount++] = next;
+				added = true;
+			}
+		}
+		job->Unlock();
+
+		if (!added)
+		{
+			if (job->generation.load(std::memory_order_acquire) == ancestor.generation && !IsCompleted(ancestor))
+			{
+				// continuation list is full, fall back to waiting for the ancestor here.
+				Wait(ancestor);
+			}
+			ReleaseWait(next);
+		}
+	}
+
+	void JobSystem::Run(JobHandle handle)
+	{
+		SK_ASSERT(handle.job, "invalid job handle");
+		state.pendingJobs.fetch_add(1, std::memory_order_acq_rel);
+		ReleaseWait(handle.job);
+	}
+
+	bool JobSystem::IsCompleted(JobHandle handle)
+	{
+		if (!handle.job)
+		{
+			return true;
+		}
+		return handle.job->generation.load(std::memory_order_acquire) != handle.generation ||
+			handle.job->unfinishedJobs.load(std::memory_order_acquire) == 0;
+	}
+
+	void JobSystem::Wait(JobHandle handle)
+	{
+		ThreadContext* context = GetCurrentContext();
+		while (!IsCompleted(handle))
+		{
+			if (!TryExecuteOne(context))
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	u64 JobSystem::PendingJobs()
+	{
+		return state.pendingJobs.load(std::memory_order_acquire);
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Skore/Common.hpp"
+#include "Skore/Core/Traits.hpp"
+
+namespace Skore
+{
+	struct Job;
+
+	typedef void (*FnJobFunction)(VoidPtr storage);
+
+	// Handle to a job created through JobSystem. The generation detects handles that outlived their job,
+	// a stale handle always reports the job as completed.
+	struct JobHandle
+	{
+		Job* job = nullptr;
+		u32  generation = 0;
+
+		explicit operator bool() const
+		{
+			return job != nullptr;
+		}
+	};
+
+	// Work-stealing scheduler shared by every engine system.
+	// Each thread that submits jobs owns a fixed job pool and a lock-free deque, workers pop from their own deque and steal
+	// from the others when it's empty. Job functors are stored inline in the job, so submission doesn't allocate.
+	struct SK_API JobSystem
+	{
+		static constexpr usize JobStorageSize = 128;
+		static constexpr u32   MaxContinuations = 8;
+
+		static void Init(u32 workerCount = 0); // 0 = logical cores - 1
+		static void Shutdown();
+		static u32  GetWorkerCount();
+		static bool IsWorkerThread();
+
+		// creates a job that stays idle until Run is called, parent only completes after all its children completed.
+		static JobHandle CreateJob(FnJobFunction function, VoidPtr* storage, JobHandle parent = {});
+
+		// continuation is started only after ancestor is completed and Run was called on it.
+		static void AddContinuation(JobHandle ancestor, JobHandle continuation);
+
+		static void Run(JobHandle handle);
+		static bool IsCompleted(JobHandle handle);
+
+		// executes other jobs on the calling thread while the job is not completed.
+		static void Wait(JobHandle handle);
+
+		// number of jobs that were run but are not completed yet.
+		static u64 PendingJobs();
+
+		template <typename Func>
+		static JobHandle Create(Func&& func, JobHandle parent = {})
+		{
+			using FuncType = Traits::RemoveConstRef<Func>;
+			static_assert(sizeof(FuncType) <= JobStorageSize, "job functor is too large to be stored inline");
+			static_assert(alignof(FuncType) <= 16, "job functor alignment is not supported");
+
+			VoidPtr   storage = nullptr;
+			JobHandle handle = CreateJob([](VoidPtr storage)
+			{
+				FuncType* func = static_cast<FuncType*>(storage);
+				(*func)();
+				func->~FuncType();
+			}, &storage, parent);
+
+			new(PlaceHolder{}, storage) FuncType(Traits::Forward<Func>(func));
+			return handle;
+		}
+
+		template <typename Func>
+		static JobHandle Schedule(Func&& func)
+		{
+			JobHandle handle = Create(Traits::Forward<Func>(func));
+			Run(handle);
+			return handle;
+		}
+
+		// calls func(index) for each index in [0, count), split in jobs of batchSize indices. Returns when all calls are done.
+		template <typename Func>
+		static void ParallelFor(u32 count, u32 batchSize, const Func& func)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			if (batchSize == 0)
+			{
+				batchSize = 1;
+			}
+
+			if (count <= batchSize)
+			{
+				for (u32 i = 0; i < count; ++i)
+				{
+					func(i);
+				}
+				return;
+			}
+
+			JobHandle root = Create([] {});
+			for (u32 begin = 0; begin < count; begin += batchSize)
+			{
+				u32 end = begin + batchSize < count ? begin + batchSize : count;
+				Run(Create([&func, begin, end]
+				{
+					for (u32 i = begin; i < end; ++i)
+					{
+						func(i);
+					}
+				}, root));
+			}
+			Run(root);
+			Wait(root);
+		}
+	};
+}
@@ -8,9 +8,41 @@
 
 namespace Skore
 {
+	namespace
+	{
+		struct RandomState
+		{
+			u64                        xorshift;
+			i64                        nextInt;
+			u64                        nextUInt;
+			std::default_random_engine floatEngine;
+
+			RandomState()
+			{
+				Seed(Platform::GetTime());
+			}
+
+			void Seed(u64 seed)
+			{
+				//xorshift gets stuck on zero
+				seed = seed != 0 ? seed : 0x9E3779B97F4A7C15ULL;
+				xorshift = seed;
+				nextInt = static_cast<i64>(seed);
+				nextUInt = seed;
+				floatEngine.seed(static_cast<std::default_random_engine::result_type>(seed));
+			}
+		};
+
+		RandomState& GetRandomState()
+		{
+			static RandomState state;
+			return state;
+		}
+	}
+
 	u64 Random::Xorshift64star()
 	{
-		static u64 x = Platform::GetTime();
+		u64& x = GetRandomState().xorshift;
 		x ^= x >> 12;
 		x ^= x << 25;
 		x ^= x >> 27;
@@ -19,7 +51,7 @@ namespace Skore
 
 	i64 Random::NextInt(i64 max)
 	{
-		static i64 x = static_cast<i64>(Platform::GetTime());
+		i64& x = GetRandomState().nextInt;
 		x ^= x >> 12;
 		x ^= x << 25;
 		x ^= x >> 27;
@@ -29,14 +61,13 @@ namespace Skore
 
 	f32 Random::NextFloat32(f32 min, f32 max)
 	{
-		static std::default_random_engine     e;
 		std::uniform_real_distribution dis(min, max);
-		return dis(e);
+		return dis(GetRandomState().floatEngine);
 	}
 
 	u64 Random::NextUInt(u64 max)
 	{
-		static u64 x = Platform::GetTime();
+		u64& x = GetRandomState().nextUInt;
 		x ^= x >> 12;
 		x ^= x << 25;
 		x ^= x >> 27;
@@ -44,11 +75,17 @@ namespace Skore
 		return (x % max);
 	}
 
+	void Random::SetSeed(u64 seed)
+	{
+		GetRandomState().Seed(seed);
+	}
+
 	void Random::RegisterType(NativeReflectType<Random>& type)
 	{
 		type.Function<&Random::Xorshift64star>("Xorshift64star");
 		type.Function<&Random::NextInt>("NextInt", "max");
 		type.Function<&Random::NextFloat32>("NextFloat32", "min", "max");
 		type.Function<&Random::NextUInt>("NextUInt", "max");
+		type.Function<&Random::SetSeed>("SetSeed", "seed");
 	}
 }
\ No newline at end of file
@@ -4,6 +4,13 @@
 #include "Skore/Common.hpp"
 
 #include <cmath>
+#include <type_traits>
+
+#if SK_SIMD_AVX2
+#include <immintrin.h>
+#elif SK_SIMD_SSE41
+#include <smmintrin.h>
+#endif
 
 
 namespace Skore
@@ -1625,52 +1632,128 @@ namespace Skore
 		return retValue.Dot(other);
 	}
 
-	//got from https://github.com/travisvroman/kohi/blob/main/engine/src/math/kmath.h
-	constexpr Quat Quat::Slerp(const Quat& q0, const Quat& q1, f32 percentage)
+	// Scalar implementations of the functions with a SIMD path, also used in constant evaluation.
+	namespace MathScalar
 	{
-		Quat outQuaternion{};
+		//got from https://github.com/travisvroman/kohi/blob/main/engine/src/math/kmath.h
+		constexpr Quat Slerp(const Quat& q0, const Quat& q1, f32 percentage)
+		{
+			Quat outQuaternion{};
+
+			Quat v0 = Quat::Normalized(q0);
+			Quat v1 = Quat::Normalized(q1);
+
+			f32 dot = Quat::DotProduct(v0, v1);
+
+			if (dot < 0.0f)
+			{
+				v1.x = -v1.x;
+				v1.y = -v1.y;
+				v1.z = -v1.z;
+				v1.w = -v1.w;
+				dot = -dot;
+			}
 
-		Quat v0 = Normalized(q0);
-		Quat v1 = Normalized(q1);
+			const f32 DOT_THRESHOLD = 0.9995f;
+			if (dot > DOT_THRESHOLD)
+			{
+				outQuaternion = Quat{
+					v0.x + ((v1.x - v0.x) * percentage),
+					v0.y + ((v1.y - v0.y) * percentage),
+					v0.z + ((v1.z - v0.z) * percentage),
+					v0.w + ((v1.w - v0.w) * percentage)
+				};
 
-		f32 dot = DotProduct(v0, v1);
+				return outQuaternion.Normalize();
+			}
 
-		if (dot < 0.0f)
+			f32 theta_0 = Math::Acos(dot);
+			f32 theta = theta_0 * percentage;
+			f32 sin_theta = Math::Sin(theta);
+			f32 sin_theta_0 = Math::Sin(theta_0);
+
+			f32 s0 = Math::Cos(theta) - dot * sin_theta / sin_theta_0;
+			f32 s1 = sin_theta / sin_theta_0;
+
+			return {
+				(v0.x * s0) + (v1.x * s1),
+				(v0.y * s0) + (v1.y * s1),
+				(v0.z * s0) + (v1.z * s1),
+				(v0.w * s0) + (v1.w * s1)
+			};
+		}
+	}
+
+#if SK_SIMD_SSE41
+	namespace MathSimd
+	{
+		SK_FINLINE __m128 Load(const Float* v)
 		{
-			v1.x = -v1.x;
-			v1.y = -v1.y;
-			v1.z = -v1.z;
-			v1.w = -v1.w;
-			dot = -dot;
+			return _mm_loadu_ps(v);
 		}
 
-		const f32 DOT_THRESHOLD = 0.9995f;
-		if (dot > DOT_THRESHOLD)
+		SK_FINLINE void Store(Float* dest, __m128 v)
 		{
-			outQuaternion = Quat{
-				v0.x + ((v1.x - v0.x) * percentage),
-				v0.y + ((v1.y - v0.y) * percentage),
-				v0.z + ((v1.z - v0.z) * percentage),
-				v0.w + ((v1.w - v0.w) * percentage)
-			};
+			_mm_storeu_ps(dest, v);
+		}
 
-			return outQuaternion.Normalize();
+		SK_FINLINE __m128 Splat(__m128 v, int lane)
+		{
+			switch (lane)
+			{
+				case 0: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+				case 1: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+				case 2: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+				default: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+			}
 		}
 
-		f32 theta_0 = Math::Acos(dot);
-		f32 theta = theta_0 * percentage;
-		f32 sin_theta = Math::Sin(theta);
-		f32 sin_theta_0 = Math::Sin(theta_0);
+		inline Quat Slerp(const Quat& q0, const Quat& q1, f32 percentage)
+		{
+			__m128 v0 = Load(q0.c);
+			__m128 v1 = Load(q1.c);
 
-		f32 s0 = Math::Cos(theta) - dot * sin_theta / sin_theta_0;
-		f32 s1 = sin_theta / sin_theta_0;
+			v0 = _mm_div_ps(v0, _mm_sqrt_ps(_mm_dp_ps(v0, v0, 0xFF)));
+			v1 = _mm_div_ps(v1, _mm_sqrt_ps(_mm_dp_ps(v1, v1, 0xFF)));
 
-		return {
-			(v0.x * s0) + (v1.x * s1),
-			(v0.y * s0) + (v1.y * s1),
-			(v0.z * s0) + (v1.z * s1),
-			(v0.w * s0) + (v1.w * s1)
-		};
+			f32 dot = _mm_cvtss_f32(_mm_dp_ps(v0, v1, 0xFF));
+			if (dot < 0.0f)
+			{
+				v1 = _mm_xor_ps(v1, _mm_set1_ps(-0.0f));
+				dot = -dot;
+			}
+
+			Quat result;
+			if (dot > 0.9995f)
+			{
+				__m128 lerp = _mm_add_ps(v0, _mm_mul_ps(_mm_sub_ps(v1, v0), _mm_set1_ps(percentage)));
+				Store(result.c, _mm_div_ps(lerp, _mm_sqrt_ps(_mm_dp_ps(lerp, lerp, 0xFF))));
+				return result;
+			}
+
+			f32 theta0 = Math::Acos(dot);
+			f32 theta = theta0 * percentage;
+			f32 sinTheta = Math::Sin(theta);
+			f32 sinTheta0 = Math::Sin(theta0);
+
+			f32 s0 = Math::Cos(theta) - dot * sinTheta / sinTheta0;
+			f32 s1 = sinTheta / sinTheta0;
+
+			Store(result.c, _mm_add_ps(_mm_mul_ps(v0, _mm_set1_ps(s0)), _mm_mul_ps(v1, _mm_set1_ps(s1))));
+			return result;
+		}
+	}
+#endif
+
+	constexpr Quat Quat::Slerp(const Quat& q0, const Quat& q1, f32 percentage)
+	{
+#if SK_SIMD_SSE41
+		if (!std::is_constant_evaluated())
+		{
+			return MathSimd::Slerp(q0, q1, percentage);
+		}
+#endif
+		return MathScalar::Slerp(q0, q1, percentage);
 	}
 
 	inline Float Quat::Roll(const Quat& q)
@@ -1702,40 +1785,89 @@ namespace Skore
 		return {Pitch(quat), Yaw(quat), Roll(quat)};
 	}
 
-	constexpr Mat4 Quat::ToMatrix4(const Quat& q)
+	namespace MathScalar
 	{
-		Mat4  result{1.0f};
-		Float qxx(q.x * q.x);
-		Float qyy(q.y * q.y);
-		Float qzz(q.z * q.z);
-		Float qxz(q.x * q.z);
-		Float qxy(q.x * q.y);
-		Float qyz(q.y * q.z);
-		Float qwx(q.w * q.x);
-		Float qwy(q.w * q.y);
-		Float qwz(q.w * q.z);
-
-		result[0][0] = Float(1) - Float(2) * (qyy + qzz);
-		result[0][1] = Float(2) * (qxy + qwz);
-		result[0][2] = Float(2) * (qxz - qwy);
-		result[0][3] = Float(0);
-
-		result[1][0] = Float(2) * (qxy - qwz);
-		result[1][1] = Float(1) - Float(2) * (qxx + qzz);
-		result[1][2] = Float(2) * (qyz + qwx);
-		result[1][3] = Float(0);
-
-		result[2][0] = Float(2) * (qxz + qwy);
-		result[2][1] = Float(2) * (qyz - qwx);
-		result[2][2] = Float(1) - Float(2) * (qxx + qyy);
-		result[2][3] = Float(0);
+		constexpr Mat4 ToMatrix4(const Quat& q)
+		{
+			Mat4  result{1.0f};
+			Float qxx(q.x * q.x);
+			Float qyy(q.y * q.y);
+			Float qzz(q.z * q.z);
+			Float qxz(q.x * q.z);
+			Float qxy(q.x * q.y);
+			Float qyz(q.y * q.z);
+			Float qwx(q.w * q.x);
+			Float qwy(q.w * q.y);
+			Float qwz(q.w * q.z);
+
+			result[0][0] = Float(1) - Float(2) * (qyy + qzz);
+			result[0][1] = Float(2) * (qxy + qwz);
+			result[0][2] = Float(2) * (qxz - qwy);
+			result[0][3] = Float(0);
+
+			result[1][0] = Float(2) * (qxy - qwz);
+			result[1][1] = Float(1) - Float(2) * (qxx + qzz);
+			result[1][2] = Float(2) * (qyz + qwx);
+			result[1][3] = Float(0);
+
+			result[2][0] = Float(2) * (qxz + qwy);
+			result[2][1] = Float(2) * (qyz - qwx);
+			result[2][2] = Float(1) - Float(2) * (qxx + qyy);
+			result[2][3] = Float(0);
+
+			result[3][0] = Float(0);
+			result[3][1] = Float(0);
+			result[3][2] = Float(0);
+			result[3][3] = Float(1);
+
+			return result;
+		}
+	}
 
-		result[3][0] = Float(0);
-		result[3][1] = Float(0);
-		result[3][2] = Float(0);
-		result[3][3] = Float(1);
+#if SK_SIMD_SSE41
+	namespace MathSimd
+	{
+		inline Mat4 ToMatrix4(const Quat& q)
+		{
+			// col0 = e0 + 2 * (y * (-y, x, -w) + z * (-z, w, x))
+			// col1 = e1 + 2 * (x * (y, -x, w) + z * (-w, -z, y))
+			// col2 = e2 + 2 * (x * (z, -w, -x) + y * (w, z, -y))
+			__m128 v = Load(q.c);
+			__m128 x = Splat(v, 0);
+			__m128 y = Splat(v, 1);
+			__m128 z = Splat(v, 2);
+			__m128 two = _mm_set1_ps(2.0f);
+
+			__m128 yxww = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 0, 1));
+			__m128 zwxw = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 3, 2));
+			__m128 wzyw = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 2, 3));
+
+			__m128 col0 = _mm_add_ps(_mm_mul_ps(y, _mm_mul_ps(yxww, _mm_setr_ps(-1.0f, 1.0f, -1.0f, 0.0f))),
+			                         _mm_mul_ps(z, _mm_mul_ps(zwxw, _mm_setr_ps(-1.0f, 1.0f, 1.0f, 0.0f))));
+			__m128 col1 = _mm_add_ps(_mm_mul_ps(x, _mm_mul_ps(yxww, _mm_setr_ps(1.0f, -1.0f, 1.0f, 0.0f))),
+			                         _mm_mul_ps(z, _mm_mul_ps(wzyw, _mm_setr_ps(-1.0f, -1.0f, 1.0f, 0.0f))));
+			__m128 col2 = _mm_add_ps(_mm_mul_ps(x, _mm_mul_ps(zwxw, _mm_setr_ps(1.0f, -1.0f, -1.0f, 0.0f))),
+			                         _mm_mul_ps(y, _mm_mul_ps(wzyw, _mm_setr_ps(1.0f, 1.0f, -1.0f, 0.0f))));
+
+			Mat4 result;
+			Store(result.m[0].c, _mm_add_ps(_mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f), _mm_mul_ps(two, col0)));
+			Store(result.m[1].c, _mm_add_ps(_mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f), _mm_mul_ps(two, col1)));
+			Store(result.m[2].c, _mm_add_ps(_mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f), _mm_mul_ps(two, col2)));
+			Store(result.m[3].c, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+			return result;
+		}
+	}
+#endif
 
-		return result;
+	constexpr Mat4 Quat::ToMatrix4(const Quat& q)
+	{
+#if SK_SIMD_SSE41
+		if (!std::is_constant_evaluated())
+		{
+			return MathSimd::ToMatrix4(q);
+		}
+#endif
+		return MathScalar::ToMatrix4(q);
 	}
 
 	template <typename Type>
@@ -1834,20 +1966,104 @@ namespace Skore
 		return !(a == b);
 	}
 
-	constexpr Mat4 operator*(const Mat4& a, const Mat4& b)
+	namespace MathScalar
 	{
-		Mat4 mat;
-		int  k, r, c;
-		for (c = 0; c < 4; ++c)
-			for (r = 0; r < 4; ++r)
-			{
-				mat.m[c][r] = 0.f;
-				for (k = 0; k < 4; ++k)
+		constexpr Mat4 Mul(const Mat4& a, const Mat4& b)
+		{
+			Mat4 mat;
+			int  k, r, c;
+			for (c = 0; c < 4; ++c)
+				for (r = 0; r < 4; ++r)
 				{
-					mat.m[c][r] += a.m[k][r] * b.m[c][k];
+					mat.m[c][r] = 0.f;
+					for (k = 0; k < 4; ++k)
+					{
+						mat.m[c][r] += a.m[k][r] * b.m[c][k];
+					}
 				}
+			return mat;
+		}
+
+		constexpr Vec4 Mul(const Mat4& m, const Vec4& v)
+		{
+			Vec4 mov0{v[0]};
+			Vec4 mov1{v[1]};
+			Vec4 mul0 = m[0] * mov0;
+			Vec4 mul1 = m[1] * mov1;
+			Vec4 add0 = mul0 + mul1;
+			Vec4 mov2{v[2]};
+			Vec4 mov3{v[3]};
+			Vec4 mul2 = m[2] * mov2;
+			Vec4 mul3 = m[3] * mov3;
+			Vec4 add1 = mul2 + mul3;
+			Vec4 add2 = add0 + add1;
+			return add2;
+		}
+	}
+
+#if SK_SIMD_SSE41
+	namespace MathSimd
+	{
+		//columns are accumulated in the same order as the scalar path, results are bit-identical without FMA contraction
+		SK_FINLINE __m128 MulColumn(const __m128 a[4], __m128 column)
+		{
+			__m128 result = _mm_mul_ps(a[0], Splat(column, 0));
+			result = _mm_add_ps(result, _mm_mul_ps(a[1], Splat(column, 1)));
+			result = _mm_add_ps(result, _mm_mul_ps(a[2], Splat(column, 2)));
+			return _mm_add_ps(result, _mm_mul_ps(a[3], Splat(column, 3)));
+		}
+
+		inline Mat4 Mul(const Mat4& a, const Mat4& b)
+		{
+			Mat4 result;
+#if SK_SIMD_AVX2
+			//two columns per iteration
+			__m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m[0].c));
+			__m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m[1].c));
+			__m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m[2].c));
+			__m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m[3].c));
+
+			for (int c = 0; c < 4; c += 2)
+			{
+				__m256 column = _mm256_loadu_ps(b.m[c].c);
+				__m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)));
+				r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1))));
+				r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))));
+				r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_shuffle_ps(column, column, _MM_SHUFFLE(3, 3, 3, 3))));
+				_mm256_storeu_ps(result.m[c].c, r);
 			}
-		return mat;
+#else
+			__m128 columns[4] = {Load(a.m[0].c), Load(a.m[1].c), Load(a.m[2].c), Load(a.m[3].c)};
+			for (int c = 0; c < 4; ++c)
+			{
+				Store(result.m[c].c, MulColumn(columns, Load(b.m[c].c)));
+			}
+#endif
+			return result;
+		}
+
+		inline Vec4 Mul(const Mat4& m, const Vec4& v)
+		{
+			__m128 vec = Load(v.c);
+			__m128 add0 = _mm_add_ps(_mm_mul_ps(Load(m.m[0].c), Splat(vec, 0)), _mm_mul_ps(Load(m.m[1].c), Splat(vec, 1)));
+			__m128 add1 = _mm_add_ps(_mm_mul_ps(Load(m.m[2].c), Splat(vec, 2)), _mm_mul_ps(Load(m.m[3].c), Splat(vec, 3)));
+
+			Vec4 result;
+			Store(result.c, _mm_add_ps(add0, add1));
+			return result;
+		}
+	}
+#endif
+
+	constexpr Mat4 operator*(const Mat4& a, const Mat4& b)
+	{
+#if SK_SIMD_SSE41
+		if (!std::is_constant_evaluated())
+		{
+			return MathSimd::Mul(a, b);
+		}
+#endif
+		return MathScalar::Mul(a, b);
 	}
 
 	constexpr Mat4 operator*(const Mat4& m, const f32& a)
@@ -1865,18 +2081,13 @@ namespace Skore
 
 	constexpr Vec4 operator*(const Mat4& m, const Vec4& v)
 	{
-		Vec4 mov0{v[0]};
-		Vec4 mov1{v[1]};
-		Vec4 mul0 = m[0] * mov0;
-		Vec4 mul1 = m[1] * mov1;
-		Vec4 add0 = mul0 + mul1;
-		Vec4 mov2{v[2]};
-		Vec4 mov3{v[3]};
-		Vec4 mul2 = m[2] * mov2;
-		Vec4 mul3 = m[3] * mov3;
-		Vec4 add1 = mul2 + mul3;
-		Vec4 add2 = add0 + add1;
-		return add2;
+#if SK_SIMD_SSE41
+		if (!std::is_constant_evaluated())
+		{
+			return MathSimd::Mul(m, v);
+		}
+#endif
+		return MathScalar::Mul(m, v);
 	}
 
 	constexpr Mat4 MakeMat4(const f32* values)
@@ -2061,64 +2272,139 @@ namespace Skore
 		return Translate(v.x, v.y, v.z);
 	}
 
-	//credits: from https://github.com/travisvroman/kohi/blob/main/engine/src/math/kmath.h
-	inline Mat4 Mat4::Inverse(const Mat4& mat)
+	namespace MathScalar
 	{
-		const f32* m = mat.a;
-
-		f32 t0 = m[10] * m[15];
-		f32 t1 = m[14] * m[11];
-		f32 t2 = m[6] * m[15];
-		f32 t3 = m[14] * m[7];
-		f32 t4 = m[6] * m[11];
-		f32 t5 = m[10] * m[7];
-		f32 t6 = m[2] * m[15];
-		f32 t7 = m[14] * m[3];
-		f32 t8 = m[2] * m[11];
-		f32 t9 = m[10] * m[3];
-		f32 t10 = m[2] * m[7];
-		f32 t11 = m[6] * m[3];
-		f32 t12 = m[8] * m[13];
-		f32 t13 = m[12] * m[9];
-		f32 t14 = m[4] * m[13];
-		f32 t15 = m[12] * m[5];
-		f32 t16 = m[4] * m[9];
-		f32 t17 = m[8] * m[5];
-		f32 t18 = m[0] * m[13];
-		f32 t19 = m[12] * m[1];
-		f32 t20 = m[0] * m[9];
-		f32 t21 = m[8] * m[1];
-		f32 t22 = m[0] * m[5];
-		f32 t23 = m[4] * m[1];
-
-		Mat4 outMatrix{};
-		f32* o = outMatrix.a;
-
-		o[0] = (t0 * m[5] + t3 * m[9] + t4 * m[13]) - (t1 * m[5] + t2 * m[9] + t5 * m[13]);
-		o[1] = (t1 * m[1] + t6 * m[9] + t9 * m[13]) - (t0 * m[1] + t7 * m[9] + t8 * m[13]);
-		o[2] = (t2 * m[1] + t7 * m[5] + t10 * m[13]) - (t3 * m[1] + t6 * m[5] + t11 * m[13]);
-		o[3] = (t5 * m[1] + t8 * m[5] + t11 * m[9]) - (t4 * m[1] + t9 * m[5] + t10 * m[9]);
-
-		f32 d = 1.0f / (m[0] * o[0] + m[4] * o[1] + m[8] * o[2] + m[12] * o[3]);
-
-		o[0] = d * o[0];
-		o[1] = d * o[1];
-		o[2] = d * o[2];
-		o[3] = d * o[3];
-		o[4] = d * ((t1 * m[4] + t2 * m[8] + t5 * m[12]) - (t0 * m[4] + t3 * m[8] + t4 * m[12]));
-		o[5] = d * ((t0 * m[0] + t7 * m[8] + t8 * m[12]) - (t1 * m[0] + t6 * m[8] + t9 * m[12]));
-		o[6] = d * ((t3 * m[0] + t6 * m[4] + t11 * m[12]) - (t2 * m[0] + t7 * m[4] + t10 * m[12]));
-		o[7] = d * ((t4 * m[0] + t9 * m[4] + t10 * m[8]) - (t5 * m[0] + t8 * m[4] + t11 * m[8]));
-		o[8] = d * ((t12 * m[7] + t15 * m[11] + t16 * m[15]) - (t13 * m[7] + t14 * m[11] + t17 * m[15]));
-		o[9] = d * ((t13 * m[3] + t18 * m[11] + t21 * m[15]) - (t12 * m[3] + t19 * m[11] + t20 * m[15]));
-		o[10] = d * ((t14 * m[3] + t19 * m[7] + t22 * m[15]) - (t15 * m[3] + t18 * m[7] + t23 * m[15]));
-		o[11] = d * ((t17 * m[3] + t20 * m[7] + t23 * m[11]) - (t16 * m[3] + t21 * m[7] + t22 * m[11]));
-		o[12] = d * ((t14 * m[10] + t17 * m[14] + t13 * m[6]) - (t16 * m[14] + t12 * m[6] + t15 * m[10]));
-		o[13] = d * ((t20 * m[14] + t12 * m[2] + t19 * m[10]) - (t18 * m[10] + t21 * m[14] + t13 * m[2]));
-		o[14] = d * ((t18 * m[6] + t23 * m[14] + t15 * m[2]) - (t22 * m[14] + t14 * m[2] + t19 * m[6]));
-		o[15] = d * ((t22 * m[10] + t16 * m[2] + t21 * m[6]) - (t20 * m[6] + t23 * m[10] + t17 * m[2]));
+		//credits: from https://github.com/travisvroman/kohi/blob/main/engine/src/math/kmath.h
+		inline Mat4 Inverse(const Mat4& mat)
+		{
+			const f32* m = mat.a;
+
+			f32 t0 = m[10] * m[15];
+			f32 t1 = m[14] * m[11];
+			f32 t2 = m[6] * m[15];
+			f32 t3 = m[14] * m[7];
+			f32 t4 = m[6] * m[11];
+			f32 t5 = m[10] * m[7];
+			f32 t6 = m[2] * m[15];
+			f32 t7 = m[14] * m[3];
+			f32 t8 = m[2] * m[11];
+			f32 t9 = m[10] * m[3];
+			f32 t10 = m[2] * m[7];
+			f32 t11 = m[6] * m[3];
+			f32 t12 = m[8] * m[13];
+			f32 t13 = m[12] * m[9];
+			f32 t14 = m[4] * m[13];
+			f32 t15 = m[12] * m[5];
+			f32 t16 = m[4] * m[9];
+			f32 t17 = m[8] * m[5];
+			f32 t18 = m[0] * m[13];
+			f32 t19 = m[12] * m[1];
+			f32 t20 = m[0] * m[9];
+			f32 t21 = m[8] * m[1];
+			f32 t22 = m[0] * m[5];
+			f32 t23 = m[4] * m[1];
+
+			Mat4 outMatrix{};
+			f32* o = outMatrix.a;
+
+			o[0] = (t0 * m[5] + t3 * m[9] + t4 * m[13]) - (t1 * m[5] + t2 * m[9] + t5 * m[13]);
+			o[1] = (t1 * m[1] + t6 * m[9] + t9 * m[13]) - (t0 * m[1] + t7 * m[9] + t8 * m[13]);
+			o[2] = (t2 * m[1] + t7 * m[5] + t10 * m[13]) - (t3 * m[1] + t6 * m[5] + t11 * m[13]);
+			o[3] = (t5 * m[1] + t8 * m[5] + t11 * m[9]) - (t4 * m[1] + t9 * m[5] + t10 * m[9]);
+
+			f32 d = 1.0f / (m[0] * o[0] + m[4] * o[1] + m[8] * o[2] + m[12] * o[3]);
+
+			o[0] = d * o[0];
+			o[1] = d * o[1];
+			o[2] = d * o[2];
+			o[3] = d * o[3];
+			o[4] = d * ((t1 * m[4] + t2 * m[8] + t5 * m[12]) - (t0 * m[4] + t3 * m[8] + t4 * m[12]));
+			o[5] = d * ((t0 * m[0] + t7 * m[8] + t8 * m[12]) - (t1 * m[0] + t6 * m[8] + t9 * m[12]));
+			o[6] = d * ((t3 * m[0] + t6 * m[4] + t11 * m[12]) - (t2 * m[0] + t7 * m[4] + t10 * m[12]));
+			o[7] = d * ((t4 * m[0] + t9 * m[4] + t10 * m[8]) - (t5 * m[0] + t8 * m[4] + t11 * m[8]));
+			o[8] = d * ((t12 * m[7] + t15 * m[11] + t16 * m[15]) - (t13 * m[7] + t14 * m[11] + t17 * m[15]));
+			o[9] = d * ((t13 * m[3] + t18 * m[11] + t21 * m[15]) - (t12 * m[3] + t19 * m[11] + t20 * m[15]));
+			o[10] = d * ((t14 * m[3] + t19 * m[7] + t22 * m[15]) - (t15 * m[3] + t18 * m[7] + t23 * m[15]));
+			o[11] = d * ((t17 * m[3] + t20 * m[7] + t23 * m[11]) - (t16 * m[3] + t21 * m[7] + t22 * m[11]));
+			o[12] = d * ((t14 * m[10] + t17 * m[14] + t13 * m[6]) - (t16 * m[14] + t12 * m[6] + t15 * m[10]));
+			o[13] = d * ((t20 * m[14] + t12 * m[2] + t19 * m[10]) - (t18 * m[10] + t21 * m[14] + t13 * m[2]));
+			o[14] = d * ((t18 * m[6] + t23 * m[14] + t15 * m[2]) - (t22 * m[14] + t14 * m[2] + t19 * m[6]));
+			o[15] = d * ((t22 * m[10] + t16 * m[2] + t21 * m[6]) - (t20 * m[6] + t23 * m[10] + t17 * m[2]));
+
+			return outMatrix;
+		}
+	}
 
-		return outMatrix;
+#if SK_SIMD_SSE41
+	namespace MathSimd
+	{
+		template <int A, int B>
+		SK_FINLINE __m128 InverseFactor(const __m128 in[4])
+		{
+			__m128 swp0a = _mm_shuffle_ps(in[3], in[2], _MM_SHUFFLE(A, A, A, A));
+			__m128 swp0b = _mm_shuffle_ps(in[3], in[2], _MM_SHUFFLE(B, B, B, B));
+			__m128 swp00 = _mm_shuffle_ps(in[2], in[1], _MM_SHUFFLE(B, B, B, B));
+			__m128 swp01 = _mm_shuffle_ps(swp0a, swp0a, _MM_SHUFFLE(2, 0, 0, 0));
+			__m128 swp02 = _mm_shuffle_ps(swp0b, swp0b, _MM_SHUFFLE(2, 0, 0, 0));
+			__m128 swp03 = _mm_shuffle_ps(in[2], in[1], _MM_SHUFFLE(A, A, A, A));
+			return _mm_sub_ps(_mm_mul_ps(swp00, swp01), _mm_mul_ps(swp02, swp03));
+		}
+
+		//credits: port of glm_mat4_inverse from https://github.com/g-truc/glm/blob/master/glm/simd/matrix.h
+		inline Mat4 Inverse(const Mat4& mat)
+		{
+			__m128 in[4] = {Load(mat.m[0].c), Load(mat.m[1].c), Load(mat.m[2].c), Load(mat.m[3].c)};
+
+			__m128 fac[6] = {
+				InverseFactor<3, 2>(in),
+				InverseFactor<3, 1>(in),
+				InverseFactor<2, 1>(in),
+				InverseFactor<3, 0>(in),
+				InverseFactor<2, 0>(in),
+				InverseFactor<1, 0>(in)
+			};
+
+			__m128 signA = _mm_set_ps(1.0f, -1.0f, 1.0f, -1.0f);
+			__m128 signB = _mm_set_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+
+			__m128 temp0 = _mm_shuffle_ps(in[1], in[0], _MM_SHUFFLE(0, 0, 0, 0));
+			__m128 vec0 = _mm_shuffle_ps(temp0, temp0, _MM_SHUFFLE(2, 2, 2, 0));
+			__m128 temp1 = _mm_shuffle_ps(in[1], in[0], _MM_SHUFFLE(1, 1, 1, 1));
+			__m128 vec1 = _mm_shuffle_ps(temp1, temp1, _MM_SHUFFLE(2, 2, 2, 0));
+			__m128 temp2 = _mm_shuffle_ps(in[1], in[0], _MM_SHUFFLE(2, 2, 2, 2));
+			__m128 vec2 = _mm_shuffle_ps(temp2, temp2, _MM_SHUFFLE(2, 2, 2, 0));
+			__m128 temp3 = _mm_shuffle_ps(in[1], in[0], _MM_SHUFFLE(3, 3, 3, 3));
+			__m128 vec3 = _mm_shuffle_ps(temp3, temp3, _MM_SHUFFLE(2, 2, 2, 0));
+
+			__m128 inv0 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vec1, fac[0]), _mm_mul_ps(vec2, fac[1])), _mm_mul_ps(vec3, fac[2])));
+			__m128 inv1 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vec0, fac[0]), _mm_mul_ps(vec2, fac[3])), _mm_mul_ps(vec3, fac[4])));
+			__m128 inv2 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vec0, fac[1]), _mm_mul_ps(vec1, fac[3])), _mm_mul_ps(vec3, fac[5])));
+			__m128 inv3 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vec0, fac[2]), _mm_mul_ps(vec1, fac[4])), _mm_mul_ps(vec2, fac[5])));
+
+			__m128 row0 = _mm_shuffle_ps(inv0, inv1, _MM_SHUFFLE(0, 0, 0, 0));
+			__m128 row1 = _mm_shuffle_ps(inv2, inv3, _MM_SHUFFLE(0, 0, 0, 0));
+			__m128 row2 = _mm_shuffle_ps(row0, row1, _MM_SHUFFLE(2, 0, 2, 0));
+
+			__m128 det = _mm_dp_ps(in[0], row2, 0xFF);
+			__m128 rcp = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+			Mat4 result;
+			Store(result.m[0].c, _mm_mul_ps(inv0, rcp));
+			Store(result.m[1].c, _mm_mul_ps(inv1, rcp));
+			Store(result.m[2].c, _mm_mul_ps(inv2, rcp));
+			Store(result.m[3].c, _mm_mul_ps(inv3, rcp));
+			return result;
+		}
+	}
+#endif
+
+	inline Mat4 Mat4::Inverse(const Mat4& mat)
+	{
+#if SK_SIMD_SSE41
+		return MathSimd::Inverse(mat);
+#else
+		return MathScalar::Inverse(mat);
+#endif
 	}
 
 	inline Mat4 Mat4::Ortho_RH_NO(f32 left, f32 right, f32 bottom, f32 top, f32 zNear, f32 zFar)
@@ -2639,6 +2925,9 @@ namespace Skore
 		static f32 NextFloat32(f32 min, f32 max);
 		static u64 NextUInt(u64 max);
 
+		//reseeds all generators, sequences are repeatable for the same seed. seeded from the clock by default.
+		static void SetSeed(u64 seed);
+
 		static void RegisterType(NativeReflectType<Random>& type);
 	};
 }
\ No newline at end of file
@@ -1052,7 +1052,31 @@ namespace Skore
 		context.stack.PopBack();
 	}
 
-	BinaryArchiveWriter::BinaryArchiveWriter()
+	namespace
+	{
+		// field index layout, stored as the last field of a map:
+		// [u32 nameSize][BinaryIndexName][u64 size][slots][u32 slotCount][u32 BinaryIndexMagic]
+		// slots are an open addressing table of name hashes, offsets are relative to the map begin.
+		constexpr char BinaryIndexName[] = "\x01idx";
+		constexpr u32  BinaryIndexNameSize = sizeof(BinaryIndexName) - 1;
+		constexpr u32  BinaryIndexMagic = 0x58444953;
+		constexpr u32  BinaryIndexMinFields = 8;
+		constexpr u64  BinaryIndexFooterSize = sizeof(u32) * 2;
+		constexpr u64  BinaryIndexHeaderSize = sizeof(u32) + BinaryIndexNameSize + sizeof(u64);
+
+		struct BinaryIndexSlot
+		{
+			u64 hash;
+			u64 offset; //U64_MAX for empty slots
+		};
+
+		u64 BinaryFieldHash(StringView name)
+		{
+			return MurmurHash64(name.Data(), static_cast<i32>(name.Size()), HashSeed64);
+		}
+	}
+
+	BinaryArchiveWriter::BinaryArchiveWriter(bool writeFieldIndex) : m_writeFieldIndex(writeFieldIndex)
 	{
 		m_data.Reserve(1000);
 	}
@@ -1121,15 +1145,13 @@ namespace Skore
 
 	void BinaryArchiveWriter::BeginSeq()
 	{
-		m_stack.EmplaceBack(m_data.Size());
-
-		const u64 size = 0;
-		m_data.Append(reinterpret_cast<const u8*>(&size), sizeof(u64));
+		BeginScope(false);
 	}
 
 	void BinaryArchiveWriter::BeginSeq(StringView name)
 	{
-		BeginMap(name);
+		WriteName(name);
+		BeginScope(false);
 	}
 
 	void BinaryArchiveWriter::EndSeq()
@@ -1139,30 +1161,73 @@ namespace Skore
 
 	void BinaryArchiveWriter::BeginMap()
 	{
-		m_stack.EmplaceBack(m_data.Size());
-
-		const u64 size = 0;
-		m_data.Append(reinterpret_cast<const u8*>(&size), sizeof(u64));
+		BeginScope(true);
 	}
 
 	void BinaryArchiveWriter::BeginMap(StringView name)
 	{
 		WriteName(name);
-		m_stack.EmplaceBack(m_data.Size());
-
-		const u64 size = 0;
-		m_data.Append(reinterpret_cast<const u8*>(&size), sizeof(u64));
+		BeginScope(true);
 	}
 
 	void BinaryArchiveWriter::EndMap()
 	{
 		BinaryStack& currentStack = m_stack.Back();
 
+		if (currentStack.map && m_fields.Size() - currentStack.firstField >= BinaryIndexMinFields)
+		{
+			WriteFieldIndex(currentStack);
+		}
+
 		const u64 size = m_data.Size() - currentStack.initData - sizeof(u64);
 		memcpy(m_data.Data() + currentStack.initData, &size, sizeof(u64));
 		PopStack();
 	}
 
+	void BinaryArchiveWriter::BeginScope(bool map)
+	{
+		m_stack.EmplaceBack(m_data.Size(), m_fields.Size(), map);
+
+		const u64 size = 0;
+		m_data.Append(reinterpret_cast<const u8*>(&size), sizeof(u64));
+	}
+
+	void BinaryArchiveWriter::WriteFieldIndex(const BinaryStack& stack)
+	{
+		u64 fieldCount = m_fields.Size() - stack.firstField;
+		u32 slotCount = 1;
+		while (slotCount < fieldCount * 2)
+		{
+			slotCount <<= 1;
+		}
+
+		u32 nameSize = BinaryIndexNameSize;
+		u64 size = slotCount * sizeof(BinaryIndexSlot) + BinaryIndexFooterSize;
+		m_data.Append(reinterpret_cast<const u8*>(&nameSize), sizeof(u32));
+		m_data.Append(reinterpret_cast<const u8*>(BinaryIndexName), nameSize);
+		m_data.Append(reinterpret_cast<const u8*>(&size), sizeof(u64));
+
+		Array<BinaryIndexSlot> slots;
+		slots.Resize(slotCount, BinaryIndexSlot{0, U64_MAX});
+
+		for (u64 i = stack.firstField; i < m_fields.Size(); ++i)
+		{
+			const FieldEntry& field = m_fields[i];
+
+			u32 slot = static_cast<u32>(field.hash) & (slotCount - 1);
+			while (slots[slot].offset != U64_MAX)
+			{
+				slot = (slot + 1) & (slotCount - 1);
+			}
+			slots[slot] = BinaryIndexSlot{field.hash, field.offset};
+		}
+
+		const u32 magic = BinaryIndexMagic;
+		m_data.Append(reinterpret_cast<const u8*>(slots.Data()), slots.Size() * sizeof(BinaryIndexSlot));
+		m_data.Append(reinterpret_cast<const u8*>(&slotCount), sizeof(u32));
+		m_data.Append(reinterpret_cast<const u8*>(&magic), sizeof(u32));
+	}
+
 	Span<u8> BinaryArchiveWriter::GetData() const
 	{
 		return {m_data};
@@ -1176,6 +1241,11 @@ namespace Skore
 
 	void BinaryArchiveWriter::WriteName(StringView name)
 	{
+		if (m_writeFieldIndex && !m_stack.Empty() && m_stack.Back().map)
+		{
+			m_fields.EmplaceBack(BinaryFieldHash(name), m_data.Size() - m_stack.Back().initData - sizeof(u64));
+		}
+
 		u32 nameSize = name.Size();
 		m_data.Append(reinterpret_cast<u8*>(&nameSize), sizeof(u32));
 		m_data.Append(reinterpret_cast<const u8*>(name.CStr()), nameSize);
@@ -1189,6 +1259,7 @@ namespace Skore
 
 	void BinaryArchiveWriter::PopStack()
 	{
+		m_fields.Resize(m_stack.Back().firstField);
 		m_stack.PopBack();
 	}
 
@@ -1349,7 +1420,7 @@ namespace Skore
 
 		ValueOffset field = {};
 		ReadOffset(field, stack);
-		m_stack.EmplaceBack(field.pos, field.pos + field.size, U64_MAX, IterType::Map);
+		PushMap(field.pos, field.pos + field.size);
 	}
 
 	bool BinaryArchiveReader::BeginMap(StringView name)
@@ -1357,7 +1428,7 @@ namespace Skore
 		MapField data;
 		if (ReadMapField(data, name))
 		{
-			m_stack.EmplaceBack(data.pos, data.pos + data.size, U64_MAX, IterType::Map);
+			PushMap(data.pos, data.pos + data.size);
 			return true;
 		}
 		return false;
@@ -1396,6 +1467,42 @@ namespace Skore
 		m_stack.PopBack();
 	}
 
+	void BinaryArchiveReader::PushMap(u64 begin, u64 end)
+	{
+		BinaryStack& stack = m_stack.EmplaceBack(begin, end, U64_MAX, IterType::Map);
+		if (end - begin < BinaryIndexHeaderSize + BinaryIndexFooterSize)
+		{
+			return;
+		}
+
+		u32 magic = *reinterpret_cast<const u32*>(m_data.Data() + end - sizeof(u32));
+		if (magic != BinaryIndexMagic)
+		{
+			return;
+		}
+
+		//maps written without index can end with the magic by chance, the whole field is validated
+		u32 slotCount = *reinterpret_cast<const u32*>(m_data.Data() + end - BinaryIndexFooterSize);
+		u64 size = static_cast<u64>(slotCount) * sizeof(BinaryIndexSlot) + BinaryIndexFooterSize;
+		if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0 || BinaryIndexHeaderSize + size > end - begin)
+		{
+			return;
+		}
+
+		u64 fieldBegin = end - BinaryIndexHeaderSize - size;
+
+		MapField field;
+		ReadMapField(field, fieldBegin);
+		if (field.size != size || field.name != StringView{BinaryIndexName, BinaryIndexNameSize})
+		{
+			return;
+		}
+
+		stack.end = fieldBegin;
+		stack.index = field.pos;
+		stack.indexSlots = slotCount;
+	}
+
 	void BinaryArchiveReader::ReadMapField(MapField& data, u64 offset) const
 	{
 		u32 nameSize = *reinterpret_cast<const u32*>(m_data.Data() + offset);
@@ -1425,7 +1532,34 @@ namespace Skore
 	bool BinaryArchiveReader::ReadMapField(MapField& data, StringView name) const
 	{
 		const BinaryStack& currentStack = m_stack.Back();
-		u64                current = currentStack.begin;
+
+		if (currentStack.indexSlots > 0)
+		{
+			u64 hash = BinaryFieldHash(name);
+			u32 mask = currentStack.indexSlots - 1;
+
+			for (u32 i = 0, slot = static_cast<u32>(hash) & mask; i < currentStack.indexSlots; ++i, slot = (slot + 1) & mask)
+			{
+				BinaryIndexSlot indexSlot;
+				memcpy(&indexSlot, m_data.Data() + currentStack.index + slot * sizeof(BinaryIndexSlot), sizeof(BinaryIndexSlot));
+				if (indexSlot.offset == U64_MAX)
+				{
+					return false;
+				}
+
+				if (indexSlot.hash == hash)
+				{
+					ReadMapField(data, currentStack.begin + indexSlot.offset);
+					if (data.name == name)
+					{
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		u64 current = currentStack.begin;
 		while (current < currentStack.end)
 		{
 			ReadMapField(data, current);
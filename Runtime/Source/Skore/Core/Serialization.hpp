@@ -220,7 +220,9 @@ namespace Skore
 	public:
 		SK_NO_COPY_CONSTRUCTOR(BinaryArchiveWriter);
 
-		BinaryArchiveWriter();
+		// writeFieldIndex appends a hash table of field names to every map with enough fields, readers use it to find
+		// fields without scanning the map. Readers without index support see it as an extra field.
+		explicit BinaryArchiveWriter(bool writeFieldIndex = false);
 		~BinaryArchiveWriter() override;
 
 		void WriteBool(StringView name, bool value) override;
@@ -250,15 +252,27 @@ namespace Skore
 	private:
 		struct BinaryStack
 		{
-			u64 initData;
+			u64  initData;
+			u64  firstField;
+			bool map;
+		};
+
+		struct FieldEntry
+		{
+			u64 hash;
+			u64 offset;
 		};
 
 		Array<u8>          m_data;
 		Array<BinaryStack> m_stack;
+		Array<FieldEntry>  m_fields;
+		bool               m_writeFieldIndex = false;
 
+		void BeginScope(bool map);
 		void WriteMapData(StringView name, ConstPtr value, u64 size);
 		void WriteName(StringView name);
 		void WriteValue(ConstPtr value, u64 size);
+		void WriteFieldIndex(const BinaryStack& stack);
 
 		void PopStack();
 	};
@@ -322,11 +336,14 @@ namespace Skore
 			u64      end;
 			u64      iter;
 			IterType type;
+			u64      index = U64_MAX; //position of the field index slots, if the map has one
+			u32      indexSlots = 0;
 		};
 
 		Span<u8>           m_data;
 		Array<BinaryStack> m_stack;
 
+		void PushMap(u64 begin, u64 end);
 		void ReadOffset(ValueOffset& data, const BinaryStack& stack) const;
 
 		void ReadMapField(MapField& data, u64 offset) const;
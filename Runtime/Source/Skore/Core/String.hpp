@@ -30,6 +30,7 @@ namespace Skore
         BasicString(ConstPointer first, ConstPointer last);
         BasicString(ConstPointer sz, usize len);
         BasicString(Allocator* allocator);
+        BasicString(const BasicString& other, Allocator* allocator);
         BasicString(const BasicStringView<T>& stringView, Allocator* allocator);
         BasicString(ConstPointer sz, Allocator* allocator);
         BasicString(ConstPointer first, ConstPointer last, Allocator* allocator);
@@ -127,6 +128,12 @@ namespace Skore
         Assign(other);
     }
 
+    template<typename T, usize BufferSize>
+    SK_FINLINE BasicString<T, BufferSize>::BasicString(const BasicString& other, Allocator* allocator) : m_size(0), m_allocator(allocator)
+    {
+        Assign(other);
+    }
+
     template<typename T, usize BufferSize>
     SK_FINLINE BasicString<T, BufferSize>::BasicString(const BasicStringView<T>& stringView, Allocator* allocator) : m_size(0), m_allocator(allocator)
     {
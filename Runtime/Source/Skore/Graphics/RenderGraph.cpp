@@ -1333,10 +1333,10 @@ namespace Skore
 			}
 		}
 
-		Array<Array<u32>> edges;
+		Array<Array<u32>> edges(MemoryGlobals::GetFrameAllocator());
 		edges.Resize(count);
 
-		Array<u32> indegrees;
+		Array<u32> indegrees(MemoryGlobals::GetFrameAllocator());
 		indegrees.Resize(count, 0);
 
 		auto dependencyResourceName = [&](const RenderGraphPass::Dependency& dependency) -> StringView
@@ -1429,10 +1429,10 @@ namespace Skore
 			}
 		}
 
-		Array<u32> sortedIndices;
+		Array<u32> sortedIndices(MemoryGlobals::GetFrameAllocator());
 		sortedIndices.Reserve(count);
 
-		Array<bool> emitted;
+		Array<bool> emitted(MemoryGlobals::GetFrameAllocator());
 		emitted.Resize(count, false);
 
 		while (sortedIndices.Size() < count)
@@ -1471,7 +1471,7 @@ namespace Skore
 			sortedPassScratch.EmplaceBack(passes[index]);
 		}
 
-		cachedSortedPassIndices = sortedIndices;
+		cachedSortedPassIndices = CopyFromFrame(sortedIndices);
 		passGraphSignature = signature;
 		passGraphCacheValid = true;
 		++topologyBuildCount;
@@ -7,6 +7,7 @@
 #include "Skore/Core/Math.hpp"
 #include "Skore/Core/Array.hpp"
 #include "Skore/Core/HashMap.hpp"
+#include "Skore/Core/FlatHashMap.hpp"
 #include "Skore/Core/String.hpp"
 #include "Skore/Core/StringView.hpp"
 #include "Skore/Core/Span.hpp"
@@ -417,21 +418,21 @@ namespace Skore
 		GPUDescriptorSet* sceneDescriptorSets[SK_FRAMES_IN_FLIGHT] = {nullptr, nullptr};
 		u64               sceneBufferFrameSize = 0;
 
-		HashMap<String, Resource>         resources;
-		Array<RenderGraphPass*>           passes;
-		Array<RenderGraphPass*>           passPool;
-		Array<u32>                        cachedSortedPassIndices;
-		Array<RenderGraphPass*>           sortedPassScratch;
-		Array<RenderPassAttachment>       renderPassAttachmentsScratch;
-		Array<bool>                       passActivatesAliasScratch;
-		Array<const Resource*>            activatedAliasResourcesScratch;
-		HashMap<usize, GPUPipeline*>      pipelineCache;
-		HashMap<usize, GPUDescriptorSet*> descriptorSetCache;
-		HashMap<usize, GPUDescriptorSet*> autoDescriptorSetCache;
-		HashMap<usize, GPURenderPass*>    renderPassCache;
-		HashMap<usize, GPUFramebuffer*>   framebufferCache;
-		Array<GPUPipeline*>               ownedPipelines;
-		Array<GPUMemory*>                 aliasHeaps;
+		HashMap<String, Resource>             resources;
+		Array<RenderGraphPass*>               passes;
+		Array<RenderGraphPass*>               passPool;
+		Array<u32>                            cachedSortedPassIndices;
+		Array<RenderGraphPass*>               sortedPassScratch;
+		Array<RenderPassAttachment>           renderPassAttachmentsScratch;
+		Array<bool>                           passActivatesAliasScratch;
+		Array<const Resource*>                activatedAliasResourcesScratch;
+		FlatHashMap<usize, GPUPipeline*>      pipelineCache;
+		FlatHashMap<usize, GPUDescriptorSet*> descriptorSetCache;
+		FlatHashMap<usize, GPUDescriptorSet*> autoDescriptorSetCache;
+		FlatHashMap<usize, GPURenderPass*>    renderPassCache;
+		FlatHashMap<usize, GPUFramebuffer*>   framebufferCache;
+		Array<GPUPipeline*>                   ownedPipelines;
+		Array<GPUMemory*>                     aliasHeaps;
 
 		bool resourcesDirty = true;
 		bool sizeChanged = false;
@@ -13,6 +13,7 @@
 #include "Skore/Graphics/Graphics.hpp"
 #include "Skore/Graphics/RenderTools.hpp"
 #include "Skore/Core/ByteBuffer.hpp"
+#include "Skore/Core/FlatHashMap.hpp"
 #include "Skore/Core/Logger.hpp"
 #include "Skore/Profiler.hpp"
 #include "Skore/Core/StringUtils.hpp"
@@ -264,11 +265,11 @@ namespace Skore
 						u32 width;
 						u32 height;
 					};
-					Array<PendingCopy> pendingCopies;
-					ByteBuffer         scratch;
+					Array<PendingCopy>         pendingCopies;
+					Array<ResourceBufferCopy>  pendingReads; //uncompressed mips of the batch, read together into the staging buffer
+					ByteBuffer                 scratch;
 
 					u32  stagingFill = 0;
-					u32  srcUncompressedOffset = 0;
 					u32  srcCompressedOffset = 0;
 					bool firstBatch = true;
 
@@ -283,6 +284,12 @@ namespace Skore
 
 					auto flushBatch = [&]()
 					{
+						if (!pendingReads.Empty())
+						{
+							buffer.CopyData(pendingReads);
+							pendingReads.Clear();
+						}
+
 						transferCmd->Begin();
 						barrierToCopyDestIfNeeded();
 						for (const PendingCopy& pc : pendingCopies)
@@ -345,7 +352,6 @@ namespace Skore
 
 						if (srcMip < skippedMips)
 						{
-							srcUncompressedOffset += uncompressedSize;
 							srcCompressedOffset += compressedSize;
 							continue;
 						}
@@ -359,12 +365,12 @@ namespace Skore
 								flushBatch();
 							}
 
-							if (compressionMode == CompressionMode::None)
+							if (compressionMode == CompressionMode::None || compressedSize == uncompressedSize)
 							{
 								uploadOversizedMip(width, height, mip,
 									[&](VoidPtr dst, u32 size, u64 rowByteOffset)
 									{
-										buffer.CopyData(dst, size, srcUncompressedOffset + rowByteOffset);
+										buffer.CopyData(dst, size, srcCompressedOffset + rowByteOffset);
 									});
 							}
 							else
@@ -392,9 +398,9 @@ namespace Skore
 
 							u8* dst = static_cast<u8*>(stagingBuffer->GetMappedData()) + stagingFill;
 
-							if (compressionMode == CompressionMode::None)
+							if (compressionMode == CompressionMode::None || compressedSize == uncompressedSize)
 							{
-								buffer.CopyData(dst, uncompressedSize, srcUncompressedOffset);
+								pendingReads.EmplaceBack(ResourceBufferCopy{dst, uncompressedSize, srcCompressedOffset});
 							}
 							else
 							{
@@ -413,7 +419,6 @@ namespace Skore
 							stagingFill += uncompressedSize;
 						}
 
-						srcUncompressedOffset += uncompressedSize;
 						srcCompressedOffset += compressedSize;
 					}
 
@@ -575,15 +580,20 @@ namespace Skore
 							if (vertexBufferSize + totalIndexBytes <= StagingBufferSize)
 							{
 								u8* mapped = static_cast<u8*>(stagingBuffer->GetMappedData());
-								buffer.CopyData(mapped, vertexBufferSize, vertexSrcOffset);
+
+								//vertices and the indices of every lod are read in one batch
+								Array<ResourceBufferCopy> reads;
+								reads.Reserve(lodCount + 1);
+								reads.EmplaceBack(ResourceBufferCopy{mapped, vertexBufferSize, vertexSrcOffset});
 
 								u64 stagingCursor = vertexBufferSize;
 								u32 lodDstCursor  = indexDstOffset;
 								for (u32 i = 0; i < lodCount; i++)
 								{
-									buffer.CopyData(mapped + stagingCursor, idxRanges[i].sizeBytes, idxRanges[i].srcOffset);
+									reads.EmplaceBack(ResourceBufferCopy{mapped + stagingCursor, idxRanges[i].sizeBytes, idxRanges[i].srcOffset});
 									stagingCursor += idxRanges[i].sizeBytes;
 								}
+								buffer.CopyData(reads);
 
 								transferCmd->Begin();
 								transferCmd->ResourceBarrier(BufferBarrierDesc{.buffer = meshDataBuffer, .oldState = ResourceState::ShaderReadOnly, .newState = ResourceState::CopyDest});
@@ -961,12 +971,12 @@ namespace Skore
 			std::counting_semaphore<>               workSem{0};
 		};
 
-		HashMap<RID, FontResourceCachePtr>                 fontCache;
-		HashMap<RID, std::weak_ptr<TextureResourceCache>>  textureAsyncCache;
-		HashMap<RID, std::weak_ptr<TextureResourceCache>>  textureCache;
-		HashMap<RID, std::weak_ptr<MaterialResourceCache>> materialCache;
-		HashMap<RID, std::weak_ptr<MeshResourceCache>>     meshCache;
-		HashMap<RID, std::weak_ptr<SkinResourceCache>>     skinCache;
+		FlatHashMap<RID, FontResourceCachePtr>                 fontCache;
+		FlatHashMap<RID, std::weak_ptr<TextureResourceCache>>  textureAsyncCache;
+		FlatHashMap<RID, std::weak_ptr<TextureResourceCache>>  textureCache;
+		FlatHashMap<RID, std::weak_ptr<MaterialResourceCache>> materialCache;
+		FlatHashMap<RID, std::weak_ptr<MeshResourceCache>>     meshCache;
+		FlatHashMap<RID, std::weak_ptr<SkinResourceCache>>     skinCache;
 
 
 		std::mutex fontCacheMutex{};
@@ -1814,11 +1824,14 @@ namespace Skore
 			meshData->primitiveInfoSlots.Resize(primCountLod0);
 
 			Array<Array<MeshPrimitive>> lodPrims(lodCount);
+			Array<ResourceBufferCopy>   primReads;
+			primReads.Reserve(lodCount);
 			for (u32 i = 0; i < lodCount; i++)
 			{
 				lodPrims[i].Resize(lodMeta[i].primCount);
-				buffer.CopyData(lodPrims[i].Data(), lodMeta[i].primCount * sizeof(MeshPrimitive), lodMeta[i].primSrcOffset);
+				primReads.EmplaceBack(ResourceBufferCopy{lodPrims[i].Data(), lodMeta[i].primCount * sizeof(MeshPrimitive), lodMeta[i].primSrcOffset});
 			}
+			buffer.CopyData(primReads);
 
 			Array<u32> lodIndexUnitOffset(lodCount);
 			{
@@ -2284,7 +2297,7 @@ namespace Skore
 	{
 		if (!texture) return nullptr;
 
-		HashMap<RID, std::weak_ptr<TextureResourceCache>>& cache = async ? textureAsyncCache : textureCache;
+		FlatHashMap<RID, std::weak_ptr<TextureResourceCache>>& cache = async ? textureAsyncCache : textureCache;
 
 		// Phase 1: brief lock — return existing cache if any.
 		{
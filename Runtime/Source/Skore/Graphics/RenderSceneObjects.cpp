@@ -71,6 +71,7 @@ namespace Skore
 
 		Array<DrawcallRef> references;
 		AABB               aabb = {};
+		AABB               meshAabb = {}; //headless only, local bounds of the mesh
 
 		GPUBuffer*               skinnedRayTracingVertexBuffer = nullptr;
 		Array<GPUBottomLevelAS*> skinnedRayTracingBlas;
@@ -97,6 +98,13 @@ namespace Skore
 
 	RenderSceneObjects::RenderSceneObjects()
 	{
+		//headless apps have no device, renderables only keep their cpu state and bounds
+		if (Graphics::GetDevice() == nullptr)
+		{
+			headless = true;
+			return;
+		}
+
 		instanceDataBuffer = Graphics::CreateBuffer(BufferDesc{
 			.size = sizeof(InstanceData) * InitialInstanceNumber,
 			.usage = ResourceUsage::UnorderedAccess,
@@ -160,6 +168,7 @@ namespace Skore
 		renderables.Clear();
 		pendingUpdate.clear();
 		pendingBlas.clear();
+		boundsChanged.clear();
 		dirtyInstances.clear();
 
 		if (instanceDataBuffer)
@@ -192,6 +201,7 @@ namespace Skore
 		o->bonesBuffer = nullptr;
 		pendingUpdate.erase(o);
 		pendingBlas.erase(o);
+		boundsChanged.erase(o);
 		renderables.Erase(o);
 		DestroyAndFree(o);
 	}
@@ -365,6 +375,7 @@ namespace Skore
 		if (o->visible == visible) return;
 		o->visible = visible;
 		MarkDirty(o);
+		MarkBoundsChanged(o);
 	}
 
 	bool RenderSceneObjects::GetVisible(RenderableObject obj) const
@@ -378,6 +389,7 @@ namespace Skore
 		RenderableObjectStorage* o = obj.ToPtr<RenderableObjectStorage>();
 		if (o->layerMask == layerMask) return;
 		o->layerMask = layerMask;
+		MarkBoundsChanged(o);
 		for (const DrawcallRef& ref : o->references)
 		{
 			if (ref.pipelineIndex != U32_MAX)
@@ -523,6 +535,11 @@ namespace Skore
 
 	void RenderSceneObjects::MarkDirty(RenderableObjectStorage* obj)
 	{
+		if (headless)
+		{
+			RebuildHeadless(obj);
+			return;
+		}
 		pendingUpdate.insert(obj);
 	}
 
@@ -543,11 +560,57 @@ namespace Skore
 
 	void RenderSceneObjects::UpdateAABB(RenderableObjectStorage* obj)
 	{
-		obj->aabb = AABB();
+		AABB aabb = {};
 		if (obj->meshCache)
 		{
-			obj->aabb = Math::TransformAABB(obj->meshCache->aabb, obj->transform);
+			aabb = Math::TransformAABB(obj->meshCache->aabb, obj->transform);
+		}
+		else if (headless && obj->mesh)
+		{
+			aabb = Math::TransformAABB(obj->meshAabb, obj->transform);
+		}
+
+		if (aabb.min != obj->aabb.min || aabb.max != obj->aabb.max)
+		{
+			obj->aabb = aabb;
+			MarkBoundsChanged(obj);
+		}
+	}
+
+	//there is no Begin without a device, bounds are updated right away without loading the mesh
+	void RenderSceneObjects::RebuildHeadless(RenderableObjectStorage* obj)
+	{
+		if (obj->meshDirty)
+		{
+			obj->meshDirty = false;
+			obj->meshAabb = {};
+			if (!obj->meshCacheExplicit && obj->mesh)
+			{
+				if (ResourceObject meshObject = Resources::Read(obj->mesh))
+				{
+					obj->meshAabb = AABB{meshObject.GetVec3(MeshResource::AABBMin), meshObject.GetVec3(MeshResource::AABBMax)};
+				}
+			}
+		}
+		UpdateAABB(obj);
+	}
+
+	void RenderSceneObjects::MarkBoundsChanged(RenderableObjectStorage* obj)
+	{
+		if (trackBoundsChanges)
+		{
+			boundsChanged.insert(obj);
+		}
+	}
+
+	void RenderSceneObjects::TakeBoundsChanges(Array<u64>& userData)
+	{
+		userData.Clear();
+		for (RenderableObjectStorage* obj : boundsChanged)
+		{
+			userData.EmplaceBack(obj->userData);
 		}
+		boundsChanged.clear();
 	}
 
 	void RenderSceneObjects::RefreshMeshCache(RenderableObjectStorage* obj)
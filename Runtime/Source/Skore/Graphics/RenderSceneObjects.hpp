@@ -151,6 +151,9 @@ namespace Skore
 
 		AABB GetAABB(RenderableObject obj) const;
 
+		//user data of renderables that had aabb, visibility or layer mask changed since the last call, requires trackBoundsChanges
+		void TakeBoundsChanges(Array<u64>& userData);
+
 		using ForEachDrawcallFn = void(*)(u32 pipelineIndex, const Drawcall& drawcall, void* userData);
 
 		void ForEachVisibleDrawcallRef(RenderableObject obj, ForEachDrawcallFn fn, void* userData) const;
@@ -221,6 +224,7 @@ namespace Skore
 		bool asyncLoad = true;
 		bool requireTlas = true;
 		bool bindEvents = true;
+		bool trackBoundsChanges = false;
 
 	private:
 		void OnBeginRecord(GPUCommandBuffer* cmd);
@@ -229,6 +233,7 @@ namespace Skore
 		HashSet<RenderableObjectStorage*>  renderables;
 		DenseSet<RenderableObjectStorage*> pendingUpdate;
 		DenseSet<RenderableObjectStorage*> pendingBlas;
+		DenseSet<RenderableObjectStorage*> boundsChanged;
 		DenseSet<u32>                      dirtyInstances;
 
 		GPUBuffer* tlasScratchBuffer = nullptr;
@@ -249,6 +254,8 @@ namespace Skore
 
 		u64        meshReloadVersion = 0;
 
+		bool       headless = false; //no device, renderables keep only their bounds, read from the mesh resource
+
 		static u32 GetOrCreatePipeline(Array<DrawPipeline>& pipelines, const DrawPipelineDesc& desc);
 
 		void TrackMovedRenderable(RenderableObjectStorage* obj, const Mat4& previousTransform, const Mat4& transform);
@@ -259,6 +266,8 @@ namespace Skore
 		bool TryRebuild(RenderableObjectStorage* obj);
 		void ClearDrawcalls(RenderableObjectStorage* obj);
 		void UpdateAABB(RenderableObjectStorage* obj);
+		void RebuildHeadless(RenderableObjectStorage* obj);
+		void MarkBoundsChanged(RenderableObjectStorage* obj);
 		void RefreshMeshCache(RenderableObjectStorage* obj);
 		void RefreshMaterialsCache(RenderableObjectStorage* obj);
 		MaterialResourceCachePtr GetMaterialCache(RenderableObjectStorage* obj, u32 materialIndex) const;
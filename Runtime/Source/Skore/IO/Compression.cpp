@@ -1,26 +1,523 @@
 ﻿#include "Skore/IO/Compression.hpp"
 
-//#include "lz4.h"
+#define ZSTD_STATIC_LINKING_ONLY
 #include "zstd.h"
 #include "Skore/Core/Algorithm.hpp"
+#include "Skore/Core/Allocator.hpp"
+#include "Skore/Core/Array.hpp"
+#include "Skore/Core/FlatHashMap.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
 
 
 namespace Skore
 {
+	namespace
+	{
+		//lz4 block format: sequences of [token][literal length][literals][offset][match length], the last sequence only has literals.
+		//the limits below are part of the format, decoders rely on them.
+		constexpr usize LZ4MinMatch = 4;
+		constexpr usize LZ4LastLiterals = 5;   //the last 5 bytes are always literals
+		constexpr usize LZ4MatchFindLimit = 12; //a match can't start in the last 12 bytes
+		constexpr usize LZ4MaxOffset = 65535;
+		constexpr usize LZ4MaxInputSize = 0x7E000000;
+		constexpr i32   LZ4HCMinLevel = 4;
+
+		constexpr u32 LZ4FastHashLog = 12;
+		constexpr u32 LZ4HCHashLog = 15;
+
+		SK_FINLINE u32 LZ4Read32(const u8* p)
+		{
+			u32 value;
+			memcpy(&value, p, sizeof(u32));
+			return value;
+		}
+
+		SK_FINLINE u64 LZ4Read64(const u8* p)
+		{
+			u64 value;
+			memcpy(&value, p, sizeof(u64));
+			return value;
+		}
+
+		SK_FINLINE u32 LZ4Hash(u32 sequence, u32 hashLog)
+		{
+			return (sequence * 2654435761u) >> (32 - hashLog);
+		}
+
+		//number of equal bytes from p and match, p stops at limit
+		SK_FINLINE usize LZ4Count(const u8* p, const u8* match, const u8* limit)
+		{
+			const u8* start = p;
+			while (p + sizeof(u64) <= limit)
+			{
+				if (u64 diff = LZ4Read64(p) ^ LZ4Read64(match))
+				{
+#if defined(_MSC_VER)
+					unsigned long index;
+					_BitScanForward64(&index, diff);
+					return static_cast<usize>(p - start) + index / 8;
+#else
+					return static_cast<usize>(p - start) + static_cast<usize>(__builtin_ctzll(diff)) / 8;
+#endif
+				}
+				p += sizeof(u64);
+				match += sizeof(u64);
+			}
+
+			while (p < limit && *p == *match)
+			{
+				++p;
+				++match;
+			}
+			return static_cast<usize>(p - start);
+		}
+
+		SK_FINLINE u8* LZ4WriteLength(u8* op, usize length)
+		{
+			for (; length >= 255; length -= 255)
+			{
+				*op++ = 255;
+			}
+			*op++ = static_cast<u8>(length);
+			return op;
+		}
+
+		//matchLength 0 writes the last sequence, returns false if it doesn't fit
+		bool LZ4WriteSequence(u8*& op, const u8* oend, const u8* literals, usize literalLength, usize offset, usize matchLength)
+		{
+			usize required = 1 + literalLength + (literalLength >= 15 ? (literalLength - 15) / 255 + 1 : 0);
+			if (matchLength > 0)
+			{
+				required += 2 + (matchLength - LZ4MinMatch >= 15 ? (matchLength - LZ4MinMatch - 15) / 255 + 1 : 0);
+			}
+
+			if (required > static_cast<usize>(oend - op))
+			{
+				return false;
+			}
+
+			u8* token = op++;
+			*token = static_cast<u8>(std::min(literalLength, usize{15}) << 4);
+			if (literalLength >= 15)
+			{
+				op = LZ4WriteLength(op, literalLength - 15);
+			}
+
+			memcpy(op, literals, literalLength);
+			op += literalLength;
+
+			if (matchLength > 0)
+			{
+				*op++ = static_cast<u8>(offset);
+				*op++ = static_cast<u8>(offset >> 8);
+
+				usize length = matchLength - LZ4MinMatch;
+				*token |= static_cast<u8>(std::min(length, usize{15}));
+				if (length >= 15)
+				{
+					op = LZ4WriteLength(op, length - 15);
+				}
+			}
+			return true;
+		}
+
+		//greedy single probe hash, skips faster over data that doesn't compress
+		usize LZ4CompressFast(u8* dest, usize destSize, const u8* src, usize srcSize)
+		{
+			u8*       op = dest;
+			const u8* oend = dest + destSize;
+			const u8* ip = src;
+			const u8* anchor = src;
+			const u8* iend = src + srcSize;
+
+			if (srcSize > LZ4MatchFindLimit)
+			{
+				const u8* mflimit = iend - LZ4MatchFindLimit;
+				const u8* matchLimit = iend - LZ4LastLiterals;
+
+				u32 table[1u << LZ4FastHashLog] = {};
+
+				while (ip <= mflimit)
+				{
+					u32       h = LZ4Hash(LZ4Read32(ip), LZ4FastHashLog);
+					const u8* match = src + table[h];
+					table[h] = static_cast<u32>(ip - src);
+
+					if (match >= ip || static_cast<usize>(ip - match) > LZ4MaxOffset || LZ4Read32(match) != LZ4Read32(ip))
+					{
+						ip += 1 + ((ip - anchor) >> 6);
+						continue;
+					}
+
+					while (ip > anchor && match > src && ip[-1] == match[-1])
+					{
+						--ip;
+						--match;
+					}
+
+					usize length = LZ4MinMatch + LZ4Count(ip + LZ4MinMatch, match + LZ4MinMatch, matchLimit);
+					if (!LZ4WriteSequence(op, oend, anchor, ip - anchor, ip - match, length))
+					{
+						return 0;
+					}
+
+					ip += length;
+					anchor = ip;
+
+					if (ip <= mflimit)
+					{
+						table[LZ4Hash(LZ4Read32(ip - 2), LZ4FastHashLog)] = static_cast<u32>(ip - 2 - src);
+					}
+				}
+			}
+
+			if (!LZ4WriteSequence(op, oend, anchor, iend - anchor, 0, 0))
+			{
+				return 0;
+			}
+			return op - dest;
+		}
+
+		//hash chains over the last 64kb, searches up to maxAttempts candidates and defers a match by one byte when the next one is longer.
+		struct LZ4HCMatchFinder
+		{
+			const u8* base;
+			u32       maxAttempts;
+			u32       nextToUpdate = 0;
+			Array<u32> head;
+			Array<u16> chain;
+
+			LZ4HCMatchFinder(const u8* base, u32 maxAttempts) : base(base), maxAttempts(maxAttempts), head(1u << LZ4HCHashLog, U32_MAX), chain(LZ4MaxOffset + 1, 0) {}
+
+			void Insert(u32 target)
+			{
+				for (; nextToUpdate < target; ++nextToUpdate)
+				{
+					u32   h = LZ4Hash(LZ4Read32(base + nextToUpdate), LZ4HCHashLog);
+					usize delta = head[h] != U32_MAX ? nextToUpdate - head[h] : 0;
+					chain[nextToUpdate & LZ4MaxOffset] = static_cast<u16>(delta <= LZ4MaxOffset ? delta : 0);
+					head[h] = nextToUpdate;
+				}
+			}
+
+			usize Find(const u8* ip, const u8* matchLimit, const u8*& match)
+			{
+				u32 position = static_cast<u32>(ip - base);
+				Insert(position);
+
+				usize best = 0;
+				u32   candidate = head[LZ4Hash(LZ4Read32(ip), LZ4HCHashLog)];
+
+				for (u32 attempts = maxAttempts; candidate != U32_MAX && position - candidate <= LZ4MaxOffset && attempts > 0; --attempts)
+				{
+					const u8* ref = base + candidate;
+					if (ref[best] == ip[best] && LZ4Read32(ref) == LZ4Read32(ip))
+					{
+						usize length = LZ4MinMatch + LZ4Count(ip + LZ4MinMatch, ref + LZ4MinMatch, matchLimit);
+						if (length > best)
+						{
+							best = length;
+							match = ref;
+						}
+					}
+
+					u16 delta = chain[candidate & LZ4MaxOffset];
+					if (delta == 0)
+					{
+						break;
+					}
+					candidate -= delta;
+				}
+
+				return best;
+			}
+		};
+
+		usize LZ4CompressHC(u8* dest, usize destSize, const u8* src, usize srcSize, i32 level)
+		{
+			u8*       op = dest;
+			const u8* oend = dest + destSize;
+			const u8* ip = src;
+			const u8* anchor = src;
+			const u8* iend = src + srcSize;
+
+			if (srcSize > LZ4MatchFindLimit)
+			{
+				const u8* mflimit = iend - LZ4MatchFindLimit;
+				const u8* matchLimit = iend - LZ4LastLiterals;
+
+				LZ4HCMatchFinder finder(src, 1u << (std::min(level, 12) - 1));
+
+				while (ip <= mflimit)
+				{
+					const u8* match = nullptr;
+					usize     length = finder.Find(ip, matchLimit, match);
+					if (length < LZ4MinMatch)
+					{
+						++ip;
+						continue;
+					}
+
+					while (ip + 1 <= mflimit)
+					{
+						const u8* nextMatch = nullptr;
+						usize     nextLength = finder.Find(ip + 1, matchLimit, nextMatch);
+						if (nextLength <= length)
+						{
+							break;
+						}
+						++ip;
+						length = nextLength;
+						match = nextMatch;
+					}
+
+					if (!LZ4WriteSequence(op, oend, anchor, ip - anchor, ip - match, length))
+					{
+						return 0;
+					}
+
+					ip += length;
+					anchor = ip;
+				}
+			}
+
+			if (!LZ4WriteSequence(op, oend, anchor, iend - anchor, 0, 0))
+			{
+				return 0;
+			}
+			return op - dest;
+		}
+
+		SK_FINLINE bool LZ4ReadLength(const u8*& ip, const u8* iend, usize& length)
+		{
+			u8 value;
+			do
+			{
+				if (ip >= iend)
+				{
+					return false;
+				}
+				value = *ip++;
+				length += value;
+			}
+			while (value == 255);
+			return true;
+		}
+
+		//copies in 16 byte steps, can write up to 15 bytes past end
+		SK_FINLINE void LZ4WildCopy(u8* op, const u8* src, const u8* end)
+		{
+			do
+			{
+				memcpy(op, src, 16);
+				op += 16;
+				src += 16;
+			}
+			while (op < end);
+		}
+
+		//every read and write is bounds checked, corrupted input returns 0.
+		//away from the ends of the buffers literals and matches are copied in wide steps that may overwrite bytes written later.
+		usize LZ4Decompress(u8* dest, usize destSize, const u8* src, usize srcSize)
+		{
+			constexpr usize Margin = 32;
+
+			u8*       op = dest;
+			u8*       oend = dest + destSize;
+			const u8* ip = src;
+			const u8* iend = src + srcSize;
+
+			while (ip < iend)
+			{
+				u8 token = *ip++;
+
+				usize literalLength = token >> 4;
+				if (literalLength < 15 && static_cast<usize>(iend - ip) >= Margin && static_cast<usize>(oend - op) >= Margin)
+				{
+					//most sequences have short literals, copied with a single fixed size copy
+					memcpy(op, ip, 16);
+					op += literalLength;
+					ip += literalLength;
+				}
+				else
+				{
+					if (literalLength == 15 && !LZ4ReadLength(ip, iend, literalLength))
+					{
+						return 0;
+					}
+
+					if (literalLength > static_cast<usize>(iend - ip) || literalLength > static_cast<usize>(oend - op))
+					{
+						return 0;
+					}
+
+					if (static_cast<usize>(iend - ip) - literalLength >= Margin && static_cast<usize>(oend - op) - literalLength >= Margin)
+					{
+						LZ4WildCopy(op, ip, op + literalLength);
+					}
+					else
+					{
+						memcpy(op, ip, literalLength);
+					}
+					op += literalLength;
+					ip += literalLength;
+
+					if (ip == iend)
+					{
+						break;
+					}
+
+					if (iend - ip < 2)
+					{
+						return 0;
+					}
+				}
+
+				usize offset = ip[0] | (static_cast<usize>(ip[1]) << 8);
+				ip += 2;
+
+				usize matchLength = token & 15;
+				if (offset == 0 || offset > static_cast<usize>(op - dest))
+				{
+					return 0;
+				}
+
+				if (matchLength < 15 && offset >= sizeof(u64) && static_cast<usize>(oend - op) >= Margin)
+				{
+					//short matches are at most 18 bytes
+					const u8* match = op - offset;
+					memcpy(op, match, 8);
+					memcpy(op + 8, match + 8, 8);
+					memcpy(op + 16, match + 16, 2);
+					op += matchLength + LZ4MinMatch;
+					continue;
+				}
+
+				if (matchLength == 15 && !LZ4ReadLength(ip, iend, matchLength))
+				{
+					return 0;
+				}
+				matchLength += LZ4MinMatch;
+
+				if (matchLength > static_cast<usize>(oend - op))
+				{
+					return 0;
+				}
+
+				const u8* match = op - offset;
+				u8*       end = op + matchLength;
+
+				if (static_cast<usize>(oend - end) < Margin)
+				{
+					for (; op < end; ++op, ++match)
+					{
+						*op = *match;
+					}
+					continue;
+				}
+
+				if (offset >= 16)
+				{
+					LZ4WildCopy(op, match, end);
+				}
+				else
+				{
+					//short offsets repeat a pattern, once a multiple of the offset is 8 bytes behind it can be copied 8 bytes at a time
+					usize distance = offset;
+					while (distance < sizeof(u64))
+					{
+						distance += offset;
+					}
+
+					u8* p = op;
+					for (u8* patternEnd = op + distance; p < patternEnd; ++p)
+					{
+						*p = *(p - offset);
+					}
+					for (; p < end; p += sizeof(u64))
+					{
+						memcpy(p, p - distance, sizeof(u64));
+					}
+				}
+				op = end;
+			}
+
+			return op - dest;
+		}
+
+		//dictionaries are built from 8 byte segments, a segment found in more samples is worth more in the dictionary
+		constexpr usize DictionarySegmentSize = sizeof(u64);
+
+		struct DictionarySegment
+		{
+			u32 samples = 0;
+			u32 lastSample = U32_MAX;
+		};
+
+		struct DictionarySample
+		{
+			usize offset;
+			usize size;
+			f64   density;
+		};
+
+		struct ZSTDContexts
+		{
+			ZSTD_CCtx* cctx = nullptr;
+			ZSTD_DCtx* dctx = nullptr;
+
+			~ZSTDContexts()
+			{
+				ZSTD_freeCCtx(cctx);
+				ZSTD_freeDCtx(dctx);
+			}
+		};
+
+		//contexts keep their tables between calls, one per thread so packages can be read from any job
+		ZSTDContexts& GetZSTDContexts()
+		{
+			thread_local ZSTDContexts contexts;
+			return contexts;
+		}
+	}
+
+	struct CompressionDictionary
+	{
+		Array<u8>      data;
+		i32            level;
+		ZSTD_DDict*    ddict = nullptr;
+		ZSTD_CDict*    cdict = nullptr; //only created when the dictionary is used to compress
+		std::once_flag cdictFlag;
+
+		~CompressionDictionary()
+		{
+			ZSTD_freeDDict(ddict);
+			ZSTD_freeCDict(cdict);
+		}
+	};
+
 	usize Compression::Compress(u8* dest, usize descSize, const u8* src, usize srcSize, CompressionMode mode, i32 level)
 	{
 		switch (mode)
 		{
+			case CompressionMode::None:
+				break;
 			case CompressionMode::ZSTD:
 			{
-				return ZSTD_compress(dest, descSize, src, srcSize, level);
+				usize size = ZSTD_compress(dest, descSize, src, srcSize, level);
+				return ZSTD_isError(size) ? 0 : size;
+			}
+			case CompressionMode::LZ4:
+			{
+				if (srcSize > LZ4MaxInputSize)
+				{
+					return 0;
+				}
+				return level < LZ4HCMinLevel ? LZ4CompressFast(dest, descSize, src, srcSize) : LZ4CompressHC(dest, descSize, src, srcSize, level);
 			}
-				// case CompressionMode::LZ4:
-				// {
-				//     return LZ4_compress_default(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dest),
-				//                                 srcSize,
-				//                                 descSize);
-				// }
 		}
 
 		return 0;
@@ -30,14 +527,16 @@ namespace Skore
 	{
 		switch (mode)
 		{
+			case CompressionMode::None:
+				break;
 			case CompressionMode::ZSTD:
 			{
 				return ZSTD_compressBound(srcSize);
 			}
-				// case CompressionMode::LZ4:
-				// {
-				//     return LZ4_compressBound(srcSize);
-				// }
+			case CompressionMode::LZ4:
+			{
+				return srcSize + srcSize / 255 + 16;
+			}
 		}
 
 		return 0;
@@ -47,14 +546,17 @@ namespace Skore
 	{
 		switch (mode)
 		{
+			case CompressionMode::None:
+				break;
 			case CompressionMode::ZSTD:
 			{
-				return ZSTD_decompress(dest, descSize, src, srcSize);
+				usize size = ZSTD_decompress(dest, descSize, src, srcSize);
+				return ZSTD_isError(size) ? 0 : size;
+			}
+			case CompressionMode::LZ4:
+			{
+				return LZ4Decompress(dest, descSize, src, srcSize);
 			}
-				// case CompressionMode::LZ4:
-				// {
-				//     return LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dest), srcSize, descSize);
-				// }
 		}
 
 		return 0;
@@ -64,6 +566,9 @@ namespace Skore
 	{
 		switch (mode)
 		{
+			case CompressionMode::None:
+			case CompressionMode::LZ4: //not stored in lz4 blocks
+				break;
 			case CompressionMode::ZSTD:
 			{
 				return ZSTD_getFrameContentSize(src, srcSize);
@@ -71,4 +576,161 @@ namespace Skore
 		}
 		return 0;
 	}
-}
\ No newline at end of file
+
+	void Compression::TrainDictionary(Span<u8> samples, Span<usize> sampleSizes, Array<u8>& dictionary, usize maxSize)
+	{
+		dictionary.Clear();
+
+		FlatHashMap<u64, DictionarySegment> segments;
+		Array<DictionarySample>             candidates;
+
+		usize offset = 0;
+		for (u32 i = 0; i < sampleSizes.Size(); ++i)
+		{
+			usize size = sampleSizes[i];
+			SK_ASSERT(offset + size <= samples.Size(), "sample out of range");
+
+			for (usize p = 0; p + DictionarySegmentSize <= size; ++p)
+			{
+				DictionarySegment& segment = segments[LZ4Read64(samples.Data() + offset + p)];
+				if (segment.lastSample != i)
+				{
+					segment.lastSample = i;
+					segment.samples++;
+				}
+			}
+
+			//large samples compress fine on their own and would take most of the dictionary
+			if (size >= DictionarySegmentSize && size <= maxSize / 4)
+			{
+				candidates.EmplaceBack(DictionarySample{offset, size, 0.0});
+			}
+			offset += size;
+		}
+
+		auto score = [&](const DictionarySample& sample)
+		{
+			u64 total = 0;
+			for (usize p = 0; p + DictionarySegmentSize <= sample.size; ++p)
+			{
+				total += segments[LZ4Read64(samples.Data() + sample.offset + p)].samples - 1;
+			}
+			return static_cast<f64>(total) / sample.size;
+		};
+
+		for (DictionarySample& sample : candidates)
+		{
+			sample.density = score(sample);
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](const DictionarySample& a, const DictionarySample& b)
+		{
+			return a.density > b.density;
+		});
+
+		//greedy cover: segments already in the dictionary stop counting, so duplicated samples are only added once
+		Array<DictionarySample> selected;
+		usize                   totalSize = 0;
+		for (const DictionarySample& sample : candidates)
+		{
+			if (sample.density <= 0.0 || totalSize + sample.size > maxSize || score(sample) < sample.density / 2)
+			{
+				continue;
+			}
+
+			for (usize p = 0; p + DictionarySegmentSize <= sample.size; ++p)
+			{
+				segments[LZ4Read64(samples.Data() + sample.offset + p)].samples = 1;
+			}
+
+			selected.EmplaceBack(sample);
+			totalSize += sample.size;
+		}
+
+		//zstd finds closer matches cheaper, the best samples go to the end
+		dictionary.Resize(totalSize);
+		usize end = totalSize;
+		for (const DictionarySample& sample : selected)
+		{
+			end -= sample.size;
+			memcpy(dictionary.Data() + end, samples.Data() + sample.offset, sample.size);
+		}
+	}
+
+	CompressionDictionary* Compression::CreateDictionary(Span<u8> data, i32 level)
+	{
+		if (data.Empty())
+		{
+			return nullptr;
+		}
+
+		CompressionDictionary* dictionary = Alloc<CompressionDictionary>();
+		dictionary->data = Array<u8>(data);
+		dictionary->level = level;
+		dictionary->ddict = ZSTD_createDDict_advanced(dictionary->data.Data(), dictionary->data.Size(), ZSTD_dlm_byRef, ZSTD_dct_rawContent, ZSTD_defaultCMem);
+		if (dictionary->ddict == nullptr)
+		{
+			DestroyAndFree(dictionary);
+			return nullptr;
+		}
+		return dictionary;
+	}
+
+	void Compression::DestroyDictionary(CompressionDictionary* dictionary)
+	{
+		if (dictionary)
+		{
+			DestroyAndFree(dictionary);
+		}
+	}
+
+	usize Compression::Compress(u8* dest, usize descSize, const u8* src, usize srcSize, CompressionDictionary* dictionary)
+	{
+		if (dictionary == nullptr)
+		{
+			return Compress(dest, descSize, src, srcSize, CompressionMode::ZSTD);
+		}
+
+		std::call_once(dictionary->cdictFlag, [&]
+		{
+			ZSTD_compressionParameters params = ZSTD_getCParams(dictionary->level, ZSTD_CONTENTSIZE_UNKNOWN, dictionary->data.Size());
+			dictionary->cdict = ZSTD_createCDict_advanced(dictionary->data.Data(), dictionary->data.Size(), ZSTD_dlm_byRef, ZSTD_dct_rawContent, params, ZSTD_defaultCMem);
+		});
+
+		ZSTDContexts& contexts = GetZSTDContexts();
+		if (contexts.cctx == nullptr)
+		{
+			contexts.cctx = ZSTD_createCCtx();
+		}
+
+		if (dictionary->cdict == nullptr || contexts.cctx == nullptr)
+		{
+			return 0;
+		}
+
+		usize size = ZSTD_compress_usingCDict(contexts.cctx, dest, descSize, src, srcSize, dictionary->cdict);
+		return ZSTD_isError(size) ? 0 : size;
+	}
+
+	usize Compression::Decompress(u8* dest, usize descSize, const u8* src, usize srcSize, CompressionDictionary* dictionary)
+	{
+		if (dictionary == nullptr)
+		{
+			return Decompress(dest, descSize, src, srcSize, CompressionMode::ZSTD);
+		}
+
+		ZSTDContexts& contexts = GetZSTDContexts();
+		if (contexts.dctx == nullptr)
+		{
+			contexts.dctx = ZSTD_createDCtx();
+		}
+
+		if (contexts.dctx == nullptr)
+		{
+			return 0;
+		}
+
+		usize size = ZSTD_decompress_usingDDict(contexts.dctx, dest, descSize, src, srcSize, dictionary->ddict);
+		return ZSTD_isError(size) ? 0 : size;
+	}
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include "Skore/Common.hpp"
+#include "Skore/Core/Array.hpp"
+#include "Skore/Core/Span.hpp"
 
 
 namespace Skore
@@ -7,16 +9,41 @@ namespace Skore
 	enum class CompressionMode
 	{
 		None,
-		ZSTD
+		ZSTD,
+		LZ4 //lz4 block format, lower ratio than zstd but several times faster to decompress
 	};
 
 	constexpr i32 CompressionDefaultLevel = 3;
+	constexpr i32 CompressionLZ4HCLevel = 9; //lz4 levels from 4 use the slower high compression match finder, decoding speed is the same
+	constexpr usize CompressionDictionarySize = 64 * 1024;
+
+	//zstd raw content dictionary, the digested tables for decompression are built once and shared between threads.
+	struct CompressionDictionary;
+
+	struct CompressionSettings
+	{
+		enum
+		{
+			TextureCompression,    //Enum
+			HDRTextureCompression, //Enum
+		};
+	};
 }
 
 namespace Skore::Compression
 {
+	//returns 0 if compression fails or doesn't fit in dest, lz4 doesn't store the uncompressed size so it must be stored along with the data.
 	SK_API usize Compress(u8* dest, usize descSize, const u8* src, usize srcSize, CompressionMode mode, i32 level = CompressionDefaultLevel);
 	SK_API usize GetMaxCompressedBufferSize(usize srcSize, CompressionMode mode);
-	SK_API usize Decompress(u8* dest, usize descSize, const u8* src, usize srcSize, CompressionMode mode);
+	SK_API usize Decompress(u8* dest, usize descSize, const u8* src, usize srcSize, CompressionMode mode); //returns 0 on corrupted data
 	SK_API usize GetMaxDecompressedBufferSize(const u8* src, usize srcSize, CompressionMode mode);
+
+	//picks the content shared by most samples, dictionary is left empty if the samples have nothing in common.
+	SK_API void TrainDictionary(Span<u8> samples, Span<usize> sampleSizes, Array<u8>& dictionary, usize maxSize = CompressionDictionarySize);
+	SK_API CompressionDictionary* CreateDictionary(Span<u8> data, i32 level = CompressionDefaultLevel);
+	SK_API void DestroyDictionary(CompressionDictionary* dictionary);
+
+	//zstd with a dictionary, data compressed with a dictionary can only be decompressed with the same dictionary.
+	SK_API usize Compress(u8* dest, usize descSize, const u8* src, usize srcSize, CompressionDictionary* dictionary);
+	SK_API usize Decompress(u8* dest, usize descSize, const u8* src, usize srcSize, CompressionDictionary* dictionary);
 }
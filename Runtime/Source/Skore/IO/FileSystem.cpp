@@ -4,14 +4,27 @@
 
 
 #include "Skore/IO/Path.hpp"
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 #include "Skore/Core/Logger.hpp"
+#include "Skore/Core/Queue.hpp"
+#include "Skore/Platform/Platform.hpp"
 
 namespace fs = std::filesystem;
 
 namespace Skore
 {
+	typedef void (*FnFileReadComplete)(VoidPtr context, u64 bytesRead);
+
 	void FileSystemPlatformInit();
+	void FileSystemPlatformShutdown();
+
+	//queues the requests on the platform async api, contexts[i] is passed to complete when requests[i] is done.
+	//returns false if the platform can't read asynchronously, the requests are then read by the io threads.
+	bool FileSystemPlatformReadAsync(Span<FileReadRequest> requests, Span<VoidPtr> contexts, FnFileReadComplete complete);
 
 	namespace
 	{
@@ -19,6 +32,165 @@ namespace Skore
 		String tempFolder;
 
 		Logger& logger = Logger::GetLogger("Skore::FileSystem");
+
+		constexpr u32 MaxFileReadThreads = 4;
+
+		struct FileReadBatch;
+
+		struct FileReadEntry
+		{
+			FileReadBatch* batch;
+			u32            index;
+		};
+
+		struct FileReadBatch
+		{
+			Array<FileReadRequest>  requests;
+			Array<FileReadEntry>    entries;
+			FnFileReadCallback      callback;
+			VoidPtr                 userData;
+			usize                   pending;
+			std::atomic<u64>        bytesRead;
+			std::mutex              mutex;
+			std::condition_variable condition;
+		};
+
+		void CompleteFileRead(VoidPtr context, u64 bytesRead)
+		{
+			FileReadEntry* entry = static_cast<FileReadEntry*>(context);
+			FileReadBatch* batch = entry->batch;
+
+			if (batch->callback)
+			{
+				batch->callback(batch->requests[entry->index], bytesRead, batch->userData);
+			}
+			batch->bytesRead.fetch_add(bytesRead, std::memory_order_relaxed);
+
+			//the batch can be released as soon as the lock is released
+			std::lock_guard lock(batch->mutex);
+			if (--batch->pending == 0)
+			{
+				batch->condition.notify_all();
+			}
+		}
+
+		void ReadFileEntry(FileReadEntry* entry)
+		{
+			const FileReadRequest& request = entry->batch->requests[entry->index];
+			u64                    bytesRead = 0;
+			if (request.fileHandler)
+			{
+				bytesRead = FileSystem::ReadFileAt(request.fileHandler, request.data, request.size, request.offset);
+			}
+			CompleteFileRead(entry, bytesRead);
+		}
+
+		//blocking reads on dedicated threads, used when the platform has no async api.
+		struct FileReadThreads
+		{
+			std::mutex              mutex;
+			std::condition_variable condition;
+			Queue<FileReadEntry*>   queue;
+			Array<std::thread>      threads;
+			bool                    running = false;
+			bool                    stopped = false;
+
+			~FileReadThreads()
+			{
+				Shutdown();
+			}
+
+			void Init()
+			{
+				std::lock_guard lock(mutex);
+				stopped = false;
+			}
+
+			void Push(Span<FileReadEntry> entries)
+			{
+				bool readInline;
+				{
+					std::lock_guard lock(mutex);
+					readInline = stopped;
+					if (!readInline)
+					{
+						if (!running)
+						{
+							running = true;
+							u32 count = std::min(std::max(std::thread::hardware_concurrency() / 2, 1u), MaxFileReadThreads);
+							for (u32 i = 0; i < count; ++i)
+							{
+								std::thread thread([this]
+								{
+									Run();
+								});
+								auto name = fmt::format("FileRead {}", i);
+								Platform::SetThreadName(thread, {name.c_str(), name.size()});
+								threads.EmplaceBack(Traits::Move(thread));
+							}
+						}
+
+						for (FileReadEntry& entry : entries)
+						{
+							queue.Enqueue(&entry);
+						}
+					}
+				}
+
+				//threads are not respawned after shutdown, late requests are read on the caller thread
+				if (readInline)
+				{
+					for (FileReadEntry& entry : entries)
+					{
+						ReadFileEntry(&entry);
+					}
+					return;
+				}
+
+				condition.notify_all();
+			}
+
+			void Run()
+			{
+				while (true)
+				{
+					FileReadEntry* entry = nullptr;
+					{
+						std::unique_lock lock(mutex);
+						condition.wait(lock, [this]
+						{
+							return !queue.IsEmpty() || !running;
+						});
+
+						//requests queued before shutdown are still read
+						if (queue.IsEmpty())
+						{
+							return;
+						}
+						entry = queue.Dequeue();
+					}
+					ReadFileEntry(entry);
+				}
+			}
+
+			void Shutdown()
+			{
+				{
+					std::lock_guard lock(mutex);
+					running = false;
+					stopped = true;
+				}
+				condition.notify_all();
+
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+				threads.Clear();
+			}
+		};
+
+		FileReadThreads fileReadThreads;
 	}
 
 	void FileSystem::SetupTempFolder(StringView tempFolder_)
@@ -138,13 +310,70 @@ namespace Skore
 		}
 	}
 
-	void FileSystemInit()
+	void SK_API FileSystemInit()
 	{
 		FileSystemPlatformInit();
+		fileReadThreads.Init();
+	}
+
+	void SK_API FileSystemShutdown()
+	{
+		FileSystemPlatformShutdown();
+		fileReadThreads.Shutdown();
+	}
+
+	FileReadHandler FileSystem::ReadFileAsync(Span<FileReadRequest> requests, FnFileReadCallback callback, VoidPtr userData)
+	{
+		FileReadBatch* batch = Alloc<FileReadBatch>();
+		batch->requests = requests;
+		batch->callback = callback;
+		batch->userData = userData;
+		batch->pending = requests.Size();
+		batch->bytesRead = 0;
+
+		if (requests.Empty())
+		{
+			return {batch};
+		}
+
+		Array<VoidPtr> contexts;
+		contexts.Reserve(requests.Size());
+		batch->entries.Reserve(requests.Size());
+
+		for (u32 i = 0; i < requests.Size(); ++i)
+		{
+			contexts.EmplaceBack(&batch->entries.EmplaceBack(FileReadEntry{batch, i}));
+		}
+
+		if (!FileSystemPlatformReadAsync(batch->requests, contexts, CompleteFileRead))
+		{
+			fileReadThreads.Push(batch->entries);
+		}
+
+		return {batch};
+	}
+
+	bool FileSystem::IsFileReadCompleted(FileReadHandler handler)
+	{
+		FileReadBatch* batch = handler.ToPtr<FileReadBatch>();
+		std::lock_guard lock(batch->mutex);
+		return batch->pending == 0;
 	}
 
-	void FileSystemShutdown()
+	u64 FileSystem::WaitFileRead(FileReadHandler handler)
 	{
+		FileReadBatch* batch = handler.ToPtr<FileReadBatch>();
+		{
+			std::unique_lock lock(batch->mutex);
+			batch->condition.wait(lock, [batch]
+			{
+				return batch->pending == 0;
+			});
+		}
+
+		u64 bytesRead = batch->bytesRead.load(std::memory_order_relaxed);
+		DestroyAndFree(batch);
+		return bytesRead;
 	}
 
 	void FileSystem::Reset()
@@ -5,6 +5,7 @@
 #include "Skore/Core/StringView.hpp"
 #include "Skore/Core/Array.hpp"
 #include "Skore/Core/ByteBuffer.hpp"
+#include "Skore/Core/Span.hpp"
 
 namespace Skore
 {
@@ -33,6 +34,12 @@ namespace Skore
 		static u64         ReadFileAt(FileHandler fileHandler, VoidPtr data, usize size, usize offset);
 		static void        CloseFile(FileHandler fileHandler);
 
+		//reads the requests of the batch in parallel without blocking the caller, using io_uring on linux and io threads elsewhere.
+		//destinations and file handlers must stay valid until the batch is released by WaitFileRead.
+		static FileReadHandler ReadFileAsync(Span<FileReadRequest> requests, FnFileReadCallback callback = nullptr, VoidPtr userData = nullptr);
+		static bool            IsFileReadCompleted(FileReadHandler handler);
+		static u64             WaitFileRead(FileReadHandler handler); //returns the bytes read by the whole batch
+
 		static FileHandler CreateFileMapping(FileHandler fileHandler, AccessMode accessMode, usize size);
 		static VoidPtr     MapViewOfFile(FileHandler fileHandler);
 		static bool        UnmapViewOfFile(VoidPtr map);
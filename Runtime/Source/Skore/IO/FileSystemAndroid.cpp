@@ -33,6 +33,13 @@ namespace Skore
 		logger.Debug("asset manager found {} ", PtrToInt(g_assetManager));
 	}
 
+	void FileSystemPlatformShutdown() {}
+
+	bool FileSystemPlatformReadAsync(Span<FileReadRequest> requests, Span<VoidPtr> contexts, void (*complete)(VoidPtr context, u64 bytesRead))
+	{
+		return false;
+	}
+
 	DirIterator::DirIterator(const StringView& directory) : m_directory(directory),
 	                                                        m_handler(nullptr)
 	{
@@ -10,15 +10,27 @@
 #include <pwd.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <sys/mman.h>
+#include <mutex>
+
+#if __has_include(<linux/io_uring.h>)
+#include <atomic>
+#include <cerrno>
+#include <thread>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#define SK_IO_URING 1
+#endif
 
 #include "Skore/IO/FileSystem.hpp"
 #include "Skore/IO/Path.hpp"
+#include "Skore/Core/HashMap.hpp"
+#include "Skore/Core/Logger.hpp"
 
 namespace Skore
 {
 
-    void FileSystemPlatformInit() {}
-
     namespace
     {
         struct LinuxFileHandler
@@ -26,8 +38,436 @@ namespace Skore
             i32 handler{};
             String path{};
         };
+
+        struct LinuxFileMapping
+        {
+            i32 handler{};
+            i32 protection{};
+            usize size{};
+        };
+
+        //munmap needs the size of the view
+        std::mutex mappedViewsMutex;
+        HashMap<VoidPtr, usize> mappedViews;
+
+#if SK_IO_URING
+        Logger& logger = Logger::GetLogger("Skore::FileSystem");
+
+        constexpr u32 IoUringEntries = 256;
+
+        struct IoUringRead
+        {
+            i32     fd;
+            u8*     data;
+            usize   size;
+            u64     offset;
+            u64     done;
+            iovec   vec;
+            VoidPtr context;
+            void    (*complete)(VoidPtr context, u64 bytesRead);
+        };
+
+        // One ring shared by all threads, submissions are serialized and a single thread reaps completions.
+        // At most IoUringEntries reads are in flight, so the completion queue can't overflow, the others wait in a list.
+        struct IoUring
+        {
+            std::mutex          mutex;
+            bool                initialized = false;
+            bool                available = false;
+            bool                stopping = false;
+            bool                closed = false; //FileSystemShutdown was called, the ring is not started again
+            bool                broken = false; //a submission failed, new reads use the io threads
+            i32                 ringFd = -1;
+            std::thread         thread;
+            u32                 inFlight = 0;
+            Array<IoUringRead*> waiting;
+            Array<IoUringRead*> failed; //not submitted, read synchronously outside the lock
+
+            u8*           sqRing = nullptr;
+            usize         sqRingSize = 0;
+            u32*          sqTail = nullptr;
+            u32*          sqMask = nullptr;
+            u32*          sqArray = nullptr;
+            io_uring_sqe* sqes = nullptr;
+            usize         sqesSize = 0;
+            u32           toSubmit = 0;
+
+            u8*           cqRing = nullptr;
+            usize         cqRingSize = 0;
+            u32*          cqHead = nullptr;
+            u32*          cqTail = nullptr;
+            u32*          cqMask = nullptr;
+            io_uring_cqe* cqes = nullptr;
+
+            ~IoUring()
+            {
+                Shutdown();
+            }
+
+            bool Init()
+            {
+                initialized = true;
+                broken = false;
+
+                io_uring_params params{};
+                ringFd = static_cast<i32>(syscall(__NR_io_uring_setup, IoUringEntries, &params));
+                if (ringFd < 0)
+                {
+                    logger.Debug("io_uring is not available ({}), using io threads", strerror(errno));
+                    return false;
+                }
+
+                sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+                cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+                bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (singleMmap)
+                {
+                    sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+                }
+
+                VoidPtr sq = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+                VoidPtr cq = singleMmap ? sq : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+
+                sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                VoidPtr entries = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+
+                sqRing = sq != MAP_FAILED ? static_cast<u8*>(sq) : nullptr;
+                cqRing = cq != MAP_FAILED ? static_cast<u8*>(cq) : nullptr;
+                sqes = entries != MAP_FAILED ? static_cast<io_uring_sqe*>(entries) : nullptr;
+
+                if (!sqRing || !cqRing || !sqes)
+                {
+                    logger.Error("failed to map io_uring queues");
+                    Release();
+                    return false;
+                }
+
+                sqTail = reinterpret_cast<u32*>(sqRing + params.sq_off.tail);
+                sqMask = reinterpret_cast<u32*>(sqRing + params.sq_off.ring_mask);
+                sqArray = reinterpret_cast<u32*>(sqRing + params.sq_off.array);
+
+                cqHead = reinterpret_cast<u32*>(cqRing + params.cq_off.head);
+                cqTail = reinterpret_cast<u32*>(cqRing + params.cq_off.tail);
+                cqMask = reinterpret_cast<u32*>(cqRing + params.cq_off.ring_mask);
+                cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+                stopping = false;
+                thread = std::thread([this]
+                {
+                    Run();
+                });
+                return true;
+            }
+
+            void Release()
+            {
+                if (sqes) munmap(sqes, sqesSize);
+                if (cqRing && cqRing != sqRing) munmap(cqRing, cqRingSize);
+                if (sqRing) munmap(sqRing, sqRingSize);
+                if (ringFd >= 0) close(ringFd);
+
+                sqes = nullptr;
+                cqRing = nullptr;
+                sqRing = nullptr;
+                ringFd = -1;
+            }
+
+            //mutex must be locked
+            void Prepare(u8 opcode, IoUringRead* read)
+            {
+                u32 tail = *sqTail + toSubmit;
+                u32 index = tail & *sqMask;
+
+                io_uring_sqe& sqe = sqes[index];
+                memset(&sqe, 0, sizeof(io_uring_sqe));
+                sqe.opcode = opcode;
+                sqe.user_data = reinterpret_cast<u64>(read);
+
+                if (read)
+                {
+                    read->vec.iov_base = read->data + read->done;
+                    read->vec.iov_len = read->size - read->done;
+
+                    sqe.fd = read->fd;
+                    sqe.off = read->offset + read->done;
+                    sqe.addr = reinterpret_cast<u64>(&read->vec);
+                    sqe.len = 1;
+                }
+
+                sqArray[index] = index;
+                toSubmit++;
+            }
+
+            //mutex must be locked
+            void Submit()
+            {
+                if (toSubmit == 0)
+                {
+                    return;
+                }
+
+                std::atomic_ref<u32>(*sqTail).store(*sqTail + toSubmit, std::memory_order_release);
+                u32 count = toSubmit;
+                toSubmit = 0;
+
+                while (count > 0)
+                {
+                    i64 submitted = syscall(__NR_io_uring_enter, ringFd, count, 0, 0, nullptr, 0);
+                    if (submitted < 0)
+                    {
+                        if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        logger.Error("io_uring submission failed {}, reading synchronously", strerror(errno));
+
+                        //the last count entries were not consumed by the kernel, take them back from the queue
+                        u32 tail = *sqTail;
+                        for (u32 i = tail - count; i != tail; ++i)
+                        {
+                            if (IoUringRead* read = reinterpret_cast<IoUringRead*>(sqes[sqArray[i & *sqMask]].user_data))
+                            {
+                                inFlight--;
+                                failed.EmplaceBack(read);
+                            }
+                        }
+                        std::atomic_ref<u32>(*sqTail).store(tail - count, std::memory_order_release);
+
+                        broken = true;
+                        break;
+                    }
+                    count -= static_cast<u32>(submitted);
+                }
+            }
+
+            static void ReadSync(IoUringRead* read)
+            {
+                while (read->done < read->size)
+                {
+                    ssize_t bytesRead = pread(read->fd, read->data + read->done, read->size - read->done, read->offset + read->done);
+                    if (bytesRead < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (bytesRead <= 0)
+                    {
+                        break;
+                    }
+                    read->done += bytesRead;
+                }
+            }
+
+            void Push(IoUringRead* read)
+            {
+                if (inFlight < IoUringEntries)
+                {
+                    inFlight++;
+                    Prepare(IORING_OP_READV, read);
+                }
+                else
+                {
+                    waiting.EmplaceBack(read);
+                }
+            }
+
+            void Run()
+            {
+                Array<IoUringRead*> completed;
+                Array<IoUringRead*> unsubmitted;
+
+                while (true)
+                {
+                    u32 head = *cqHead;
+                    u32 tail = std::atomic_ref<u32>(*cqTail).load(std::memory_order_acquire);
+
+                    if (head == tail)
+                    {
+                        {
+                            std::lock_guard lock(mutex);
+                            if (stopping && inFlight == 0)
+                            {
+                                return;
+                            }
+                        }
+                        syscall(__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                        continue;
+                    }
+
+                    {
+                        std::lock_guard lock(mutex);
+                        for (; head != tail; ++head)
+                        {
+                            const io_uring_cqe& cqe = cqes[head & *cqMask];
+                            IoUringRead*        read = reinterpret_cast<IoUringRead*>(cqe.user_data);
+                            if (read == nullptr)
+                            {
+                                continue; //wake up from Shutdown
+                            }
+
+                            if (cqe.res > 0)
+                            {
+                                read->done += cqe.res;
+                            }
+
+                            //short reads continue where they stopped until the end of the file
+                            if ((cqe.res > 0 && read->done < read->size) || cqe.res == -EAGAIN || cqe.res == -EINTR)
+                            {
+                                Prepare(IORING_OP_READV, read);
+                                continue;
+                            }
+
+                            inFlight--;
+                            completed.EmplaceBack(read);
+                        }
+                        std::atomic_ref<u32>(*cqHead).store(head, std::memory_order_release);
+
+                        usize count = std::min<usize>(waiting.Size(), IoUringEntries - inFlight);
+                        for (usize i = 0; i < count; ++i)
+                        {
+                            Push(waiting[i]);
+                        }
+                        waiting.Erase(waiting.begin(), waiting.begin() + count);
+
+                        Submit();
+
+                        for (IoUringRead* read : failed)
+                        {
+                            unsubmitted.EmplaceBack(read);
+                        }
+                        failed.Clear();
+                    }
+
+                    for (IoUringRead* read : unsubmitted)
+                    {
+                        ReadSync(read);
+                        completed.EmplaceBack(read);
+                    }
+                    unsubmitted.Clear();
+
+                    for (IoUringRead* read : completed)
+                    {
+                        read->complete(read->context, read->done);
+                        DestroyAndFree(read);
+                    }
+                    completed.Clear();
+                }
+            }
+
+            void Shutdown()
+            {
+                {
+                    std::lock_guard lock(mutex);
+                    closed = true;
+                    if (!initialized)
+                    {
+                        return;
+                    }
+
+                    initialized = false;
+                    if (!available)
+                    {
+                        return;
+                    }
+
+                    available = false;
+                    stopping = true;
+
+                    //reads already submitted complete before the thread stops
+                    Prepare(IORING_OP_NOP, nullptr);
+                    Submit();
+                }
+
+                thread.join();
+                Release();
+            }
+        };
+
+        IoUring ioUring;
+#endif
+    }
+
+#if SK_IO_URING
+    void FileSystemPlatformInit()
+    {
+        std::lock_guard lock(ioUring.mutex);
+        ioUring.closed = false;
+    }
+
+    void FileSystemPlatformShutdown()
+    {
+        ioUring.Shutdown();
     }
 
+    bool FileSystemPlatformReadAsync(Span<FileReadRequest> requests, Span<VoidPtr> contexts, void (*complete)(VoidPtr context, u64 bytesRead))
+    {
+        std::unique_lock lock(ioUring.mutex);
+        if (ioUring.closed || ioUring.broken)
+        {
+            return false;
+        }
+
+        if (!ioUring.initialized)
+        {
+            ioUring.available = ioUring.Init();
+        }
+
+        if (!ioUring.available)
+        {
+            return false;
+        }
+
+        Array<usize> invalid;
+        for (usize i = 0; i < requests.Size(); ++i)
+        {
+            LinuxFileHandler* linuxFileHandler = static_cast<LinuxFileHandler*>(requests[i].fileHandler.ToPtr());
+            if (linuxFileHandler == nullptr || requests[i].size == 0)
+            {
+                invalid.EmplaceBack(i);
+                continue;
+            }
+
+            ioUring.Push(Alloc<IoUringRead>(IoUringRead{
+                .fd = linuxFileHandler->handler,
+                .data = static_cast<u8*>(requests[i].data),
+                .size = requests[i].size,
+                .offset = requests[i].offset,
+                .done = 0,
+                .vec = {},
+                .context = contexts[i],
+                .complete = complete
+            }));
+        }
+        ioUring.Submit();
+
+        Array<IoUringRead*> failed = Traits::Move(ioUring.failed);
+        ioUring.failed.Clear();
+        lock.unlock();
+
+        for (IoUringRead* read : failed)
+        {
+            IoUring::ReadSync(read);
+            read->complete(read->context, read->done);
+            DestroyAndFree(read);
+        }
+
+        for (usize i : invalid)
+        {
+            complete(contexts[i], 0);
+        }
+        return true;
+    }
+#else
+    void FileSystemPlatformInit() {}
+    void FileSystemPlatformShutdown() {}
+
+    bool FileSystemPlatformReadAsync(Span<FileReadRequest> requests, Span<VoidPtr> contexts, void (*complete)(VoidPtr context, u64 bytesRead))
+    {
+        return false;
+    }
+#endif
+
     DirIterator& DirIterator::operator++()
     {
         if (m_handler)
@@ -182,22 +622,85 @@ namespace Skore
 
     FileHandler FileSystem::CreateFileMapping(FileHandler fileHandler, AccessMode accessMode, usize size)
     {
-        return FileHandler{};
+        LinuxFileHandler* linuxFileHandler = static_cast<LinuxFileHandler*>(fileHandler.ToPtr());
+        if (linuxFileHandler == nullptr)
+        {
+            return FileHandler{};
+        }
+
+        i32 protection = 0;
+        switch (accessMode)
+        {
+            case AccessMode::None:
+                return FileHandler{};
+            case AccessMode::ReadOnly:
+                protection = PROT_READ;
+                break;
+            case AccessMode::WriteOnly:
+            case AccessMode::ReadAndWrite:
+                protection = PROT_READ | PROT_WRITE;
+                break;
+        }
+
+        //same as windows, size 0 maps the whole file
+        if (size == 0)
+        {
+            size = GetFileSize(fileHandler);
+        }
+        else if ((protection & PROT_WRITE) && GetFileSize(fileHandler) < size && ftruncate(linuxFileHandler->handler, size) != 0)
+        {
+            return FileHandler{};
+        }
+
+        if (size == 0)
+        {
+            return FileHandler{};
+        }
+
+        return {MemoryGlobals::GetDefaultAllocator()->Alloc<LinuxFileMapping>(linuxFileHandler->handler, protection, size)};
     }
 
     VoidPtr FileSystem::MapViewOfFile(FileHandler fileHandler)
     {
-        return nullptr;
+        LinuxFileMapping* mapping = static_cast<LinuxFileMapping*>(fileHandler.ToPtr());
+        if (mapping == nullptr)
+        {
+            return nullptr;
+        }
+
+        VoidPtr map = mmap(nullptr, mapping->size, mapping->protection, MAP_SHARED, mapping->handler, 0);
+        if (map == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        std::unique_lock lock(mappedViewsMutex);
+        mappedViews.Insert(map, mapping->size);
+        return map;
     }
 
     bool FileSystem::UnmapViewOfFile(VoidPtr map)
     {
-        return false;
+        usize size = 0;
+        {
+            std::unique_lock lock(mappedViewsMutex);
+            auto it = mappedViews.Find(map);
+            if (it == mappedViews.end())
+            {
+                return false;
+            }
+            size = it->second;
+            mappedViews.Erase(it);
+        }
+        return munmap(map, size) == 0;
     }
 
     void FileSystem::CloseFileMapping(FileHandler fileHandler)
     {
-
+        if (LinuxFileMapping* mapping = static_cast<LinuxFileMapping*>(fileHandler.ToPtr()))
+        {
+            DestroyAndFree(mapping);
+        }
     }
 
     void FileSystem::CloseFile(FileHandler fileHandler)
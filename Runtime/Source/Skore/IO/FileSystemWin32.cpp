@@ -29,6 +29,13 @@ namespace Skore
 
 	void FileSystemPlatformInit() {}
 
+	void FileSystemPlatformShutdown() {}
+
+	bool FileSystemPlatformReadAsync(Span<FileReadRequest> requests, Span<VoidPtr> contexts, void (*complete)(VoidPtr context, u64 bytesRead))
+	{
+		return false;
+	}
+
 	DirIterator& DirIterator::operator++()
 	{
 		if (m_handler)
@@ -260,9 +267,9 @@ namespace Skore
 				break;
 		}
 
-		HANDLE hout = ::CreateFileMappingA(fileHandler.ToPtr(), nullptr, protect, 0, size, nullptr);
+		HANDLE hout = ::CreateFileMappingA(fileHandler.ToPtr(), nullptr, protect, static_cast<u64>(size) >> 32, static_cast<u32>(size), nullptr);
 
-		if (hout == INVALID_HANDLE_VALUE)
+		if (hout == nullptr)
 		{
 			return FileHandler{};
 		}
@@ -271,7 +278,13 @@ namespace Skore
 
 	VoidPtr FileSystem::MapViewOfFile(FileHandler fileHandler)
 	{
-		return ::MapViewOfFile(fileHandler.ToPtr(), FILE_MAP_ALL_ACCESS, 0, 0, 0);
+		if (VoidPtr map = ::MapViewOfFile(fileHandler.ToPtr(), FILE_MAP_ALL_ACCESS, 0, 0, 0))
+		{
+			return map;
+		}
+
+		//read only mappings don't allow FILE_MAP_ALL_ACCESS
+		return ::MapViewOfFile(fileHandler.ToPtr(), FILE_MAP_READ, 0, 0, 0);
 	}
 
 	bool FileSystem::UnmapViewOfFile(VoidPtr map)
@@ -18,6 +18,18 @@ namespace Skore
 
 	SK_HANDLER(FileHandler);
 	SK_HANDLER(FileMappingHandler);
+	SK_HANDLER(FileReadHandler);
+
+	struct FileReadRequest
+	{
+		FileHandler fileHandler{};
+		u64         offset{};
+		usize       size{};
+		VoidPtr     data{};
+	};
+
+	//called from an io thread for each request, bytesRead is smaller than the requested size on error or end of file
+	typedef void (*FnFileReadCallback)(const FileReadRequest& request, u64 bytesRead, VoidPtr userData);
 
 	struct FileStatus
 	{
@@ -4,12 +4,14 @@
 #include "Skore/Core/Event.hpp"
 #include "Skore/Core/FixedArray.hpp"
 
+#include <cstring>
 #include <SDL3/SDL.h>
 
 #include "Skore/Events.hpp"
 #include "Skore/IO/InputEvents.hpp"
 #include "Skore/Core/Logger.hpp"
 #include "Skore/Graphics/Graphics.hpp"
+#include "Skore/IO/FileSystem.hpp"
 
 namespace Skore
 {
@@ -30,6 +32,58 @@ namespace Skore
 		CursorLockMode                                       currentCursorLockMode = CursorLockMode::Free;
 		FixedArray<u32, 512>                                 keyMap;
 
+		enum class InputRecordType : u8
+		{
+			Key,
+			MouseButton,
+			MouseMotion,
+			MouseWheel,
+			TextInput
+		};
+
+		struct InputRecordEvent
+		{
+			u32             frame;
+			InputRecordType type;
+			u8              down;
+			u8              repeat;
+			u8              padding;
+			u32             code;       //key, mouse button or text size
+			u32             textOffset;
+			Vec2            value;
+			Vec2            relative;
+		};
+
+		struct InputRecordHeader
+		{
+			u32 magic;
+			u32 version;
+			u32 tickRate;
+			u32 frameCount;
+			u64 randomSeed;
+			u64 eventCount;
+			u64 textSize;
+		};
+
+		constexpr u32 InputRecordMagic = 0x52494B53; //SKIR
+		constexpr u32 InputRecordVersion = 1;
+
+		//advanced on end frame like App::Frame, replay offsets don't depend on who drives the frames
+		u64                     inputFrame = 0;
+
+		bool                    recording = false;
+		String                  recordPath;
+		u64                     recordStartFrame = 0;
+		Array<InputRecordEvent> recordEvents;
+		Array<char>             recordText;
+
+		bool                    replaying = false;
+		u64                     replayStartFrame = 0;
+		u32                     replayFrameCount = 0;
+		usize                   replayCursor = 0;
+		Array<InputRecordEvent> replayEvents;
+		Array<char>             replayText;
+
 		Logger& logger = Logger::GetLogger("Skore::Input");
 
 		EventHandler<OnKeyDown>     onKeyDownHandler{};
@@ -38,6 +92,119 @@ namespace Skore
 		EventHandler<OnMouseMove>   onMouseMoveHandler{};
 		EventHandler<OnMouseButton> onMouseButtonHandler{};
 		EventHandler<OnMouseScroll> onMouseScrollHandler{};
+
+		void RecordEvent(InputRecordEvent event)
+		{
+			if (recording)
+			{
+				event.frame = static_cast<u32>(inputFrame - recordStartFrame);
+				recordEvents.EmplaceBack(event);
+			}
+		}
+
+		void ProcessKey(Key key, bool down, bool repeat)
+		{
+			RecordEvent({.type = InputRecordType::Key, .down = down, .repeat = repeat, .code = static_cast<u32>(key)});
+
+			if (inputDisabled && down)
+			{
+				return;
+			}
+			keyState[static_cast<usize>(key)] = down;
+			if (down)
+			{
+				onKeyDownHandler.Invoke(key, repeat);
+			}
+			else
+			{
+				onKeyUpHandler.Invoke(key);
+			}
+		}
+
+		void ProcessMouseButton(u32 button, bool down)
+		{
+			RecordEvent({.type = InputRecordType::MouseButton, .down = down, .code = button});
+
+			if (!inputDisabled || !down)
+			{
+				mouseButtonState[button] = down;
+			}
+			onMouseButtonHandler.Invoke(static_cast<MouseButton>(button), down);
+		}
+
+		void ProcessMouseMotion(Vec2 position, Vec2 relative)
+		{
+			RecordEvent({.type = InputRecordType::MouseMotion, .value = position, .relative = relative});
+
+			mousePosition = position;
+			mouseRelativePosition += relative;
+			mouseMoved = true;
+			onMouseMoveHandler.Invoke(mousePosition);
+		}
+
+		void ProcessMouseWheel(Vec2 wheel)
+		{
+			RecordEvent({.type = InputRecordType::MouseWheel, .value = wheel});
+
+			mouseWheel += wheel;
+			onMouseScrollHandler.Invoke(wheel);
+		}
+
+		void ProcessTextInput(StringView text)
+		{
+			if (recording)
+			{
+				RecordEvent({.type = InputRecordType::TextInput, .code = static_cast<u32>(text.Size()), .textOffset = static_cast<u32>(recordText.Size())});
+				recordText.Insert(recordText.end(), text.begin(), text.end());
+			}
+
+			if (!inputDisabled)
+			{
+				onTextInputHandler.Invoke(text);
+			}
+		}
+
+		void PlayEvent(const InputRecordEvent& event)
+		{
+			switch (event.type)
+			{
+				case InputRecordType::Key:
+					if (event.code < static_cast<u32>(Key::MAX))
+					{
+						ProcessKey(static_cast<Key>(event.code), event.down, event.repeat);
+					}
+					break;
+				case InputRecordType::MouseButton:
+					if (event.code < static_cast<u32>(MouseButton::MAX))
+					{
+						ProcessMouseButton(event.code, event.down);
+					}
+					break;
+				case InputRecordType::MouseMotion:
+					ProcessMouseMotion(event.value, event.relative);
+					break;
+				case InputRecordType::MouseWheel:
+					ProcessMouseWheel(event.value);
+					break;
+				case InputRecordType::TextInput:
+					if (static_cast<usize>(event.textOffset) + event.code <= replayText.Size())
+					{
+						ProcessTextInput(StringView{replayText.Data() + event.textOffset, event.code});
+					}
+					break;
+			}
+		}
+
+		void ResetInputState()
+		{
+			keyState = {};
+			prevKeyState = {};
+			mouseButtonState = {};
+			prevMouseButtonState = {};
+			mouseRelativePosition = {};
+			mouseWheel = {};
+			mouseMoved = false;
+		}
 	}
 
 	bool Input::IsKeyDown(Key key)
@@ -136,61 +303,219 @@ namespace Skore
 		}
 	}
 
-	void InputHandlerEvents(SDL_Event* event)
+	void SK_API InputHandlerEvents(SDL_Event* event)
 	{
+		//replayed events are fed on begin frame
+		if (replaying)
+		{
+			return;
+		}
+
 		switch (event->type)
 		{
 			case SDL_EVENT_KEY_UP:
 			case SDL_EVENT_KEY_DOWN:
-			{
-				const bool down = event->type == SDL_EVENT_KEY_DOWN;
-				if (inputDisabled && down)
-				{
-					break;
-				}
-				const Key key = FromSDL(event->key.scancode);
-				keyState[static_cast<usize>(key)] = down;
-				if (down)
-				{
-					onKeyDownHandler.Invoke(key, event->key.repeat);
-				}
-				else
-				{
-					onKeyUpHandler.Invoke(key);
-				}
+				ProcessKey(FromSDL(event->key.scancode), event->type == SDL_EVENT_KEY_DOWN, event->key.repeat);
 				break;
-			}
 			case SDL_EVENT_MOUSE_BUTTON_UP:
 			case SDL_EVENT_MOUSE_BUTTON_DOWN:
-			{
-				const bool down = event->type == SDL_EVENT_MOUSE_BUTTON_DOWN;
-				if (!inputDisabled || !down)
-				{
-					mouseButtonState[event->button.button] = down;
-				}
-				onMouseButtonHandler.Invoke(static_cast<MouseButton>(event->button.button), down);
+				ProcessMouseButton(event->button.button, event->type == SDL_EVENT_MOUSE_BUTTON_DOWN);
 				break;
-			}
 			case SDL_EVENT_MOUSE_MOTION:
-				mousePosition = Vec2{event->motion.x, event->motion.y};
-				mouseRelativePosition += Vec2{event->motion.xrel, event->motion.yrel};
-				mouseMoved = true;
-				onMouseMoveHandler.Invoke(mousePosition);
+				ProcessMouseMotion(Vec2{event->motion.x, event->motion.y}, Vec2{event->motion.xrel, event->motion.yrel});
 				break;
 			case SDL_EVENT_MOUSE_WHEEL:
-				mouseWheel += Vec2{event->wheel.x, event->wheel.y};
-				onMouseScrollHandler.Invoke(Vec2{event->wheel.x, event->wheel.y});
+				ProcessMouseWheel(Vec2{event->wheel.x, event->wheel.y});
 				break;
 			case SDL_EVENT_TEXT_INPUT:
-				if (!inputDisabled)
-				{
-					onTextInputHandler.Invoke(StringView{event->text.text});
-				}
+				ProcessTextInput(StringView{event->text.text});
 				break;
 		}
 	}
 
-	void InputOnEndFrame()
+	bool Input::StartRecording(StringView path)
+	{
+		if (replaying)
+		{
+			logger.Error("input cannot be recorded while replaying");
+			return false;
+		}
+
+		recording = true;
+		recordPath = path;
+		recordStartFrame = inputFrame;
+		recordEvents.Clear();
+		recordText.Clear();
+
+		//current state as the first events, the replay starts from a clean state
+		for (u32 i = 0; i < static_cast<u32>(Key::MAX); ++i)
+		{
+			if (keyState[i])
+			{
+				RecordEvent({.type = InputRecordType::Key, .down = true, .code = i});
+			}
+		}
+
+		for (u32 i = 0; i < static_cast<u32>(MouseButton::MAX); ++i)
+		{
+			if (mouseButtonState[i])
+			{
+				RecordEvent({.type = InputRecordType::MouseButton, .down = true, .code = i});
+			}
+		}
+
+		RecordEvent({.type = InputRecordType::MouseMotion, .value = mousePosition});
+
+		logger.Info("recording input to {}", recordPath);
+		return true;
+	}
+
+	void Input::StopRecording()
+	{
+		if (!recording)
+		{
+			return;
+		}
+		recording = false;
+
+		InputRecordHeader header{
+			.magic = InputRecordMagic,
+			.version = InputRecordVersion,
+			.tickRate = App::GetTickRate(),
+			.frameCount = static_cast<u32>(inputFrame - recordStartFrame),
+			.randomSeed = App::GetRandomSeed(),
+			.eventCount = recordEvents.Size(),
+			.textSize = recordText.Size()
+		};
+
+		Array<u8> bytes;
+		bytes.Resize(sizeof(InputRecordHeader) + recordEvents.Size() * sizeof(InputRecordEvent) + recordText.Size());
+
+		u8* data = bytes.Data();
+		memcpy(data, &header, sizeof(InputRecordHeader));
+		data += sizeof(InputRecordHeader);
+		if (!recordEvents.Empty())
+		{
+			memcpy(data, recordEvents.Data(), recordEvents.Size() * sizeof(InputRecordEvent));
+			data += recordEvents.Size() * sizeof(InputRecordEvent);
+		}
+		if (!recordText.Empty())
+		{
+			memcpy(data, recordText.Data(), recordText.Size());
+		}
+
+		if (!App::IsDeterministic())
+		{
+			logger.Warn("input recorded without deterministic mode, the replay may diverge");
+		}
+
+		FileSystem::SaveFileAsByteArray(recordPath, bytes);
+		logger.Info("recorded {} input events in {} frames to {}", recordEvents.Size(), header.frameCount, recordPath);
+
+		recordEvents.Clear();
+		recordText.Clear();
+	}
+
+	bool Input::IsRecording()
+	{
+		return recording;
+	}
+
+	bool Input::StartReplay(StringView path)
+	{
+		if (recording)
+		{
+			logger.Error("input cannot be replayed while recording");
+			return false;
+		}
+
+		Array<u8> bytes;
+		FileSystem::ReadFileAsByteArray(path, bytes);
+
+		InputRecordHeader header{};
+		if (bytes.Size() < sizeof(InputRecordHeader))
+		{
+			logger.Error("input record {} not found or invalid", path);
+			return false;
+		}
+		memcpy(&header, bytes.Data(), sizeof(InputRecordHeader));
+
+		if (header.magic != InputRecordMagic || header.version != InputRecordVersion ||
+			bytes.Size() != sizeof(InputRecordHeader) + header.eventCount * sizeof(InputRecordEvent) + header.textSize)
+		{
+			logger.Error("input record {} is invalid or from an incompatible version", path);
+			return false;
+		}
+
+		if (header.tickRate != App::GetTickRate() || header.randomSeed != App::GetRandomSeed() || !App::IsDeterministic())
+		{
+			logger.Warn("input record {} was captured with tick rate {} and seed {}, the replay may diverge", path, header.tickRate, header.randomSeed);
+		}
+
+		const u8* data = bytes.Data() + sizeof(InputRecordHeader);
+		replayEvents.Resize(header.eventCount);
+		if (header.eventCount > 0)
+		{
+			memcpy(replayEvents.Data(), data, header.eventCount * sizeof(InputRecordEvent));
+			data += header.eventCount * sizeof(InputRecordEvent);
+		}
+		replayText.Resize(header.textSize);
+		if (header.textSize > 0)
+		{
+			memcpy(replayText.Data(), data, header.textSize);
+		}
+
+		ResetInputState();
+
+		replaying = true;
+		replayStartFrame = inputFrame;
+		replayFrameCount = header.frameCount;
+		replayCursor = 0;
+
+		logger.Info("replaying {} input events in {} frames from {}", replayEvents.Size(), replayFrameCount, path);
+		return true;
+	}
+
+	void Input::StopReplay()
+	{
+		if (!replaying)
+		{
+			return;
+		}
+
+		replaying = false;
+		replayEvents.Clear();
+		replayText.Clear();
+		ResetInputState();
+	}
+
+	bool Input::IsReplaying()
+	{
+		return replaying;
+	}
+
+	void SK_API InputOnBeginFrame()
+	{
+		if (!replaying)
+		{
+			return;
+		}
+
+		u64 replayFrame = inputFrame - replayStartFrame;
+		if (replayFrame >= replayFrameCount)
+		{
+			logger.Info("input replay finished after {} frames", replayFrameCount);
+			Input::StopReplay();
+			return;
+		}
+
+		while (replayCursor < replayEvents.Size() && replayEvents[replayCursor].frame <= replayFrame)
+		{
+			PlayEvent(replayEvents[replayCursor++]);
+		}
+	}
+
+	void SK_API InputOnEndFrame()
 	{
 		mouseRelativePosition = {};
 		mouseWheel = {};
@@ -205,6 +530,8 @@ namespace Skore
 		{
 			prevMouseButtonState[i] = mouseButtonState[i];
 		}
+
+		inputFrame++;
 	}
 
 	Key FromSDL(u32 key)
@@ -355,7 +682,7 @@ namespace Skore
 		keyMap[SDL_SCANCODE_MENU] = static_cast<u32>(Key::Menu);
 	}
 
-	void InputInit()
+	void SK_API InputInit()
 	{
 		keyState = {};
 		prevKeyState = {};
@@ -363,6 +690,8 @@ namespace Skore
 
 		MapKeys();
 
+		Event::Bind<OnBeginFrame, InputOnBeginFrame>();
 		Event::Bind<OnEndFrame, InputOnEndFrame>();
+		Event::Bind<OnShutdown, &Input::StopRecording>();
 	}
 }
\ No newline at end of file
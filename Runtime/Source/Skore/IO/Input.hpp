@@ -2,6 +2,7 @@
 
 #include "InputTypes.hpp"
 #include "Skore/Core/Math.hpp"
+#include "Skore/Core/StringView.hpp"
 
 
 namespace Skore
@@ -23,5 +24,14 @@ namespace Skore
 		static Vec2           GetMouseAxis();
 		static void           DisableInputs(bool disable);
 		static void           SetTextInputActive(bool active);
+
+		//input events are recorded with the frame they happened and replayed at the same frame offset,
+		//live input is ignored while replaying. pair with AppConfig::deterministic to reproduce a session.
+		static bool StartRecording(StringView path);
+		static void StopRecording();
+		static bool IsRecording();
+		static bool StartReplay(StringView path);
+		static void StopReplay();
+		static bool IsReplaying();
 	};
 }
@@ -4,6 +4,8 @@
 #include "Skore/IO/Input.hpp"
 #include "Skore/IO/InputTypes.hpp"
 #include "Skore/Core/Reflection.hpp"
+#include "Skore/Core/Settings.hpp"
+#include "Skore/Resource/Resources.hpp"
 
 namespace Skore
 {
@@ -251,5 +253,25 @@ namespace Skore
 		auto compressionMode = Reflection::Type<CompressionMode>();
 		compressionMode.Value<CompressionMode::None>();
 		compressionMode.Value<CompressionMode::ZSTD>();
+		compressionMode.Value<CompressionMode::LZ4>();
+
+		ResourceType* compressionSettingsType = Resources::Type<CompressionSettings>()
+			.Field<CompressionSettings::TextureCompression>(ResourceFieldType::Enum, TypeInfo<CompressionMode>::ID())
+			.Field<CompressionSettings::HDRTextureCompression>(ResourceFieldType::Enum, TypeInfo<CompressionMode>::ID())
+			.Attribute<EditableSettings>(EditableSettings{
+				.path = "Engine/Compression",
+				.type = TypeInfo<ProjectSettings>::ID(),
+				.order = 20
+			})
+			.Build()
+			.GetResourceType();
+
+		//lz4 for data decompressed while streaming, zstd for large float textures where the ratio matters more
+		RID compressionSettings = Resources::Create<CompressionSettings>();
+		ResourceObject compressionSettingsObject = Resources::Write(compressionSettings);
+		compressionSettingsObject.SetEnum(CompressionSettings::TextureCompression, CompressionMode::LZ4);
+		compressionSettingsObject.SetEnum(CompressionSettings::HDRTextureCompression, CompressionMode::ZSTD);
+		compressionSettingsObject.Commit();
+		compressionSettingsType->SetDefaultValue(compressionSettings);
 	}
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #if defined(SK_LINUX)
 #include <limits.h>
 #include <unistd.h>
+#include <pthread.h>
 #endif
 #include <SDL3/SDL.h>
 #include "SDL3/SDL_vulkan.h"
@@ -380,6 +381,19 @@ namespace Skore
 		return n > 0 ? static_cast<u32>(n) : 1u;
 	}
 
+#if !defined(SK_WIN)
+	void Platform::SetThreadName(std::thread& thread, StringView name)
+	{
+#if defined(SK_LINUX)
+		// linux limits thread names to 15 chars + null terminator
+		char buffer[16]{};
+		usize size = name.Size() < 15 ? name.Size() : 15;
+		memcpy(buffer, name.Data(), size);
+		pthread_setname_np(thread.native_handle(), buffer);
+#endif
+	}
+#endif
+
 	void Platform::SaveDialog(std::function<void(StringView path)>&& func, Span<FileFilter> filters, StringView defaultPath, StringView fileName, Window window) {}
 
 
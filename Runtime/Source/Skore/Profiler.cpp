@@ -1,8 +1,13 @@
 #include "Skore/Profiler.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <cstring>
+#include <mutex>
+#include <thread>
 
+#include "Skore/Core/Algorithm.hpp"
+#include "Skore/Core/Allocator.hpp"
 #include "Skore/Graphics/Graphics.hpp"
 
 #ifdef SK_ENABLE_TRACY
@@ -15,6 +20,7 @@ namespace Skore
 	{
 		constexpr u32 MaxSamples   = 256;
 		constexpr u32 BufferCount  = 3;
+		constexpr u32 MaxThreads   = 64;
 
 		using Clock     = std::chrono::high_resolution_clock;
 		using TimePoint = Clock::time_point;
@@ -95,6 +101,25 @@ namespace Skore
 
 		f32                  timestampPeriod = 0.0f;
 
+		Profiler::MemoryStats frameAllocatorStats{};
+
+		// the main thread records into cpuCtx, any other thread into its own ThreadSamples.
+		// Finished samples of other threads are merged into cpuCtx at the start of each frame.
+		struct ThreadSamples
+		{
+			std::mutex        mutex;
+			Sample            open[MaxSamples]{};
+			i32               openDepth = 0;
+			Sample            finished[MaxSamples]{};
+			u32               finishedCount = 0;
+		};
+
+		std::thread::id      mainThreadId = std::this_thread::get_id();
+		TimePoint            threadEpoch = Clock::now();
+		ThreadSamples        threadSamples[MaxThreads];
+		std::atomic<u32>     threadSampleCount = 0;
+		thread_local i32     threadSampleIndex = -1;
+
 		u32 HashName(const char* name)
 		{
 			u32 hash = 2166136261u;
@@ -212,6 +237,85 @@ namespace Skore
 			}
 		}
 
+		ThreadSamples* GetThreadSamples()
+		{
+			if (threadSampleIndex < 0)
+			{
+				u32 index = threadSampleCount.fetch_add(1);
+				if (index >= MaxThreads) return nullptr;
+				threadSampleIndex = static_cast<i32>(index);
+			}
+			return threadSampleIndex < static_cast<i32>(MaxThreads) ? &threadSamples[threadSampleIndex] : nullptr;
+		}
+
+		f64 GetThreadSeconds()
+		{
+			return std::chrono::duration<f64>(Clock::now() - threadEpoch).count();
+		}
+
+		void BeginThreadSample(StringView name)
+		{
+			if (!active) return;
+
+#ifdef SK_ENABLE_TRACY
+			TracyMessageL(name.Data());
+#endif
+
+			ThreadSamples* thread = GetThreadSamples();
+			if (!thread) return;
+
+			std::lock_guard<std::mutex> lock(thread->mutex);
+			if (thread->openDepth >= static_cast<i32>(MaxSamples)) return;
+
+			auto& sample = thread->open[thread->openDepth];
+			strncpy(sample.name, name.Data(), sizeof(sample.name) - 1);
+			sample.name[std::min<usize>(name.Size(), sizeof(sample.name) - 1)] = '\0';
+			sample.cpuStart = GetThreadSeconds();
+			sample.hasGPU = false;
+			sample.depth = thread->openDepth++;
+		}
+
+		void EndThreadSample()
+		{
+			ThreadSamples* thread = GetThreadSamples();
+			if (!thread) return;
+
+			std::lock_guard<std::mutex> lock(thread->mutex);
+			if (thread->openDepth <= 0) return;
+
+			Sample& sample = thread->open[--thread->openDepth];
+			sample.cpuEnd = GetThreadSeconds();
+
+			if (active && thread->finishedCount < MaxSamples)
+			{
+				thread->finished[thread->finishedCount++] = sample;
+			}
+		}
+
+		// samples finish child first, BuildTasks expects them in the order they started
+		void MergeThreadSamples(ProfilerContext& ctx)
+		{
+			auto& buf = ctx.buffers[ctx.writeIdx];
+
+			u32 count = std::min(threadSampleCount.load(), MaxThreads);
+			for (u32 i = 0; i < count; i++)
+			{
+				ThreadSamples& thread = threadSamples[i];
+				std::lock_guard<std::mutex> lock(thread.mutex);
+
+				Sort(thread.finished, thread.finished + thread.finishedCount, [](const Sample& a, const Sample& b)
+				{
+					return a.cpuStart < b.cpuStart || (a.cpuStart == b.cpuStart && a.depth < b.depth);
+				});
+
+				for (u32 s = 0; s < thread.finishedCount && buf.sampleCount < MaxSamples; s++)
+				{
+					buf.samples[buf.sampleCount++] = thread.finished[s];
+				}
+				thread.finishedCount = 0;
+			}
+		}
+
 		void BuildTasks(ProfilerContext& ctx, bool gpu)
 		{
 			auto& buf = ctx.buffers[ctx.readIdx];
@@ -390,6 +494,8 @@ namespace Skore
 
 	void Profiler::Init()
 	{
+		mainThreadId = std::this_thread::get_id();
+
 		GPUDevice* device = Graphics::GetDevice();
 		if (!device) return;
 
@@ -423,11 +529,21 @@ namespace Skore
 
 	void Profiler::BeginCpuSample(StringView name)
 	{
+		if (std::this_thread::get_id() != mainThreadId)
+		{
+			BeginThreadSample(name);
+			return;
+		}
 		BeginSample(cpuCtx, name, nullptr);
 	}
 
 	void Profiler::EndCpuSample(StringView name)
 	{
+		if (std::this_thread::get_id() != mainThreadId)
+		{
+			EndThreadSample();
+			return;
+		}
 		EndSample(cpuCtx, nullptr);
 	}
 
@@ -449,6 +565,7 @@ namespace Skore
 		FrameMark;
 #endif
 
+		MergeThreadSamples(cpuCtx);
 		AdvanceContext(cpuCtx, false);
 		AdvanceContext(gpuCtx, true);
 
@@ -462,6 +579,19 @@ namespace Skore
 
 		frameStart = now;
 
+		FrameAllocatorStats stats = MemoryGlobals::GetFrameAllocatorStats();
+		frameAllocatorStats.current = stats.used;
+		frameAllocatorStats.reserved = stats.reserved;
+		if (stats.used > frameAllocatorStats.peak)
+		{
+			frameAllocatorStats.peak = stats.used;
+		}
+
+#ifdef SK_ENABLE_TRACY
+		TracyPlot("Frame Allocator", static_cast<i64>(stats.used));
+		TracyPlot("Frame Allocator Peak", static_cast<i64>(frameAllocatorStats.peak));
+#endif
+
 		frameNumber++;
 	}
 
@@ -491,8 +621,15 @@ namespace Skore
 		return FrameStats{gpuCtx.frameTimeCur, gpuCtx.frameTimeMin, gpuCtx.frameTimeMax, gpuCtx.frameTimeAvg, gpuCtx.frameTimeCount};
 	}
 
+	Profiler::MemoryStats Profiler::GetFrameAllocatorStats()
+	{
+		return frameAllocatorStats;
+	}
+
 	void Profiler::ResetStats()
 	{
+		frameAllocatorStats.peak = frameAllocatorStats.current;
+
 		ProfilerContext* contexts[] = {&cpuCtx, &gpuCtx};
 		for (ProfilerContext* ctx : contexts)
 		{
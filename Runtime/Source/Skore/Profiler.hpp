@@ -53,6 +53,13 @@ namespace Skore::Profiler
 		u32      count;
 	};
 
+	struct MemoryStats
+	{
+		usize    current;
+		usize    peak;
+		usize    reserved;
+	};
+
 	SK_API void Init();
 	SK_API void Shutdown();
 
@@ -73,6 +80,9 @@ namespace Skore::Profiler
 	SK_API FrameStats GetCpuFrameStats();
 	SK_API FrameStats GetGpuFrameStats();
 
+	// frame allocator usage of the last frame, peak is reset by ResetStats
+	SK_API MemoryStats GetFrameAllocatorStats();
+
 	SK_API void ResetStats();
 
 	SK_API void SetActive(bool active);
@@ -72,6 +72,46 @@ namespace Skore
 		return 0;
 	}
 
+	u64 ResourceBuffer::CopyData(Span<ResourceBufferCopy> copies) const
+	{
+		SK_ASSERT(m_instance, "Invalid buffer");
+		if (!m_instance || copies.Empty())
+		{
+			return 0;
+		}
+
+		FileHandler fileHandler = m_instance->handler;
+		if (!fileHandler && !m_instance->filePath.Empty())
+		{
+			fileHandler = FileSystem::OpenFile(m_instance->filePath, AccessMode::ReadOnly);
+		}
+
+		if (!fileHandler)
+		{
+			return 0;
+		}
+
+		Array<FileReadRequest> requests;
+		requests.Reserve(copies.Size());
+		for (const ResourceBufferCopy& copy : copies)
+		{
+			requests.EmplaceBack(FileReadRequest{
+				.fileHandler = fileHandler,
+				.offset = m_instance->offset + copy.offset,
+				.size = copy.size,
+				.data = copy.data
+			});
+		}
+
+		u64 bytesRead = FileSystem::WaitFileRead(FileSystem::ReadFileAsync(requests));
+
+		if (fileHandler != m_instance->handler)
+		{
+			FileSystem::CloseFile(fileHandler);
+		}
+		return bytesRead;
+	}
+
 	FileHandler ResourceBuffer::OpenFile(AccessMode accessMode) const
 	{
 		if (m_instance && !m_instance->readOnly && !m_instance->filePath.Empty())
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Skore/Common.hpp"
+#include "Skore/Core/Span.hpp"
 #include "Skore/Core/String.hpp"
 #include <memory>
 
@@ -18,6 +19,13 @@ namespace Skore
 		u64 offset = 0;
 	};
 
+	struct ResourceBufferCopy
+	{
+		VoidPtr data;
+		u64     size;
+		u64     offset;
+	};
+
 	class SK_API ResourceBuffer
 	{
 	public:
@@ -30,6 +38,7 @@ namespace Skore
 		void MapFile(FileHandler handler, bool readOnly, u64 offset, u64 size) const;
 		u64  GetSize() const;
 		u64  CopyData(VoidPtr data, u64 size, u64 offset = 0) const;
+		u64  CopyData(Span<ResourceBufferCopy> copies) const; //all copies are read in parallel, returns when they are done
 
 		//only works if the buffer is not readonly, and it's mapped to a file.
 		FileHandler OpenFile(AccessMode accessMode) const;
@@ -63,6 +63,15 @@ namespace Skore
 		MAX
 	};
 
+	enum class ResourceLoadMode
+	{
+		//every asset of the package is loaded by LoadResources
+		Eager,
+
+		//only the package table of contents is loaded, assets are loaded on first access
+		Lazy
+	};
+
 	enum class CompareSubObjectSetType
 	{
 		Added,
@@ -176,6 +185,7 @@ namespace Skore
 		ResourceStorage*              prototype = nullptr;
 		HashSet<RID>                  prototypeInstances;
 		std::mutex                    prototypeInstancesMutex;
+		u32                           typeIndex = U32_MAX; //position in resourceType resources, U32_MAX if not listed
 
 		Array<ResourceEvent> events[static_cast<u32>(ResourceEventType::MAX)];
 
@@ -13,11 +13,21 @@ namespace Skore
 	void ResourceCommit(ResourceStorage* storage, ResourceInstance instance, UndoRedoScope* scope);
 	void ResourceRemoveParent(RID rid);
 	void DestroyResourceInstance(ResourceType* resourceType, ResourceInstance instance);
+	void ResourceEpochPin();
+	void ResourceEpochUnpin();
+	ResourceInstance ResourceLoadInstance(const ResourceStorage* storage);
 
 
 	ResourceObject::ResourceObject() : m_storage(nullptr), m_currentInstance(nullptr) {}
 
-	ResourceObject::ResourceObject(ResourceStorage* storage, ResourceInstance writeInstance) : m_storage(storage), m_currentInstance(writeInstance) {}
+	//objects pin the resource epoch while alive, so instances replaced by other threads are not freed while they are being read
+	ResourceObject::ResourceObject(ResourceStorage* storage, ResourceInstance writeInstance) : m_storage(storage), m_currentInstance(writeInstance)
+	{
+		if (m_storage)
+		{
+			ResourceEpochPin();
+		}
+	}
 
 	ResourceObject::ResourceObject(ResourceObject&& resourceObject) noexcept
 	{
@@ -35,6 +45,10 @@ namespace Skore
 			{
 				DestroyResourceInstance(m_storage->resourceType, m_currentInstance);
 			}
+			if (m_storage)
+			{
+				ResourceEpochUnpin();
+			}
 			m_storage = resourceObject.m_storage;
 			m_currentInstance = resourceObject.m_currentInstance;
 			resourceObject.m_storage = nullptr;
@@ -49,6 +63,10 @@ namespace Skore
 		{
 			DestroyResourceInstance(m_storage->resourceType, m_currentInstance);
 		}
+		if (m_storage)
+		{
+			ResourceEpochUnpin();
+		}
 	}
 
 	void ResourceObject::SetBool(u32 index, bool value)
@@ -345,7 +363,7 @@ namespace Skore
 
 	bool ResourceObject::HasValueOnThisObject(u32 index) const
 	{
-		if (ResourceInstance instance = m_currentInstance ? m_currentInstance : m_storage->instance.load())
+		if (ResourceInstance instance = m_currentInstance ? m_currentInstance : ResourceLoadInstance(m_storage))
 		{
 			return *reinterpret_cast<bool*>(&instance[sizeof(ResourceInstanceInfo) + index]);
 		}
@@ -740,7 +758,7 @@ namespace Skore
 
 	ResourceInstance ResourceObject::GetInstance() const
 	{
-		return m_currentInstance ? m_currentInstance : m_storage->instance.load();
+		return m_currentInstance ? m_currentInstance : ResourceLoadInstance(m_storage);
 	}
 
 	void ResourceObject::Commit(UndoRedoScope* scope)
@@ -754,7 +772,7 @@ namespace Skore
 		{
 			return false;
 		}
-		return m_storage->instance.load() != nullptr || m_currentInstance != nullptr;
+		return m_currentInstance != nullptr || ResourceLoadInstance(m_storage) != nullptr;
 	}
 
 	bool ResourceObject::Compare(const ResourceObject& left, const ResourceObject& right, u32 index)
@@ -808,7 +826,7 @@ namespace Skore
 		{
 			while (storage != nullptr)
 			{
-				if (ResourceInstance instance = storage->instance.load())
+				if (ResourceInstance instance = ResourceLoadInstance(storage))
 				{
 					if (*reinterpret_cast<bool*>(&instance[sizeof(ResourceInstanceInfo) + index]))
 					{
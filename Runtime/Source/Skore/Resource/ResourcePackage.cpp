@@ -0,0 +1,429 @@
+#include "ResourcePackage.hpp"
+
+#include "Skore/Core/JobSystem.hpp"
+#include "Skore/Core/Logger.hpp"
+#include "Skore/IO/FileSystem.hpp"
+#include "Skore/IO/Path.hpp"
+
+namespace Skore
+{
+	namespace
+	{
+		Logger& logger = Logger::GetLogger("Skore::ResourcePackage");
+
+		//layout: [header][chunk data...][chunk entries][footer]
+		constexpr u32 PackageMagic = 0x4B504B53; //SKPK
+		constexpr u32 PackageVersion = 3; //2: chunk type, 3: chunk flags, same entry layout as 1
+		constexpr u8  PackageChunkDictionary = 1 << 0; //compressed with the package dictionary
+		constexpr u64 PackageAlignment = 8; //chunks and chunk table start aligned
+
+		struct PackageHeader
+		{
+			u32 magic;
+			u32 version;
+		};
+
+		struct PackageChunkEntry
+		{
+			u64 offset;
+			u64 size;
+			u64 uncompressedSize;
+			u8  mode;
+			u8  flags; //always 0 before version 3
+			u16 type;
+			u32 group;
+		};
+
+		struct PackageFooter
+		{
+			u64 tableOffset;
+			u32 chunkCount;
+			u32 magic;
+		};
+	}
+
+	ResourcePackageWriter::~ResourcePackageWriter()
+	{
+		Close();
+	}
+
+	bool ResourcePackageWriter::Open(StringView path)
+	{
+		Close();
+
+		if (!FileSystem::GetFileStatus(Path::Parent(path)).exists)
+		{
+			FileSystem::CreateDirectory(Path::Parent(path));
+		}
+
+		m_file = FileSystem::OpenFile(path, AccessMode::WriteOnly);
+		if (!m_file)
+		{
+			logger.Error("failed to create package {}", path);
+			return false;
+		}
+
+		PackageHeader header{
+			.magic = PackageMagic,
+			.version = PackageVersion
+		};
+		m_offset = FileSystem::WriteFile(m_file, &header, sizeof(PackageHeader));
+		return true;
+	}
+
+	void ResourcePackageWriter::SetCompressionThreads(u32 threads)
+	{
+		m_threads = threads;
+	}
+
+	void ResourcePackageWriter::BeginGroup()
+	{
+		if (!m_chunks.Empty() && m_chunks.Back().group == m_group)
+		{
+			m_group++;
+		}
+	}
+
+	void ResourcePackageWriter::AddChunk(Span<u8> data, CompressionMode mode, i32 level)
+	{
+		AddChunk(Array<u8>(data), mode, level);
+	}
+
+	void ResourcePackageWriter::AddChunk(Array<u8>&& data, CompressionMode mode, i32 level)
+	{
+		SK_ASSERT(m_file, "package is not open");
+
+		ResourcePackageChunk& chunk = m_chunks.EmplaceBack();
+		chunk.uncompressedSize = data.Size();
+		chunk.group = m_group;
+
+		m_pendingSize += data.Size();
+		m_pending.EmplaceBack(PendingChunk{
+			.index = static_cast<u32>(m_chunks.Size() - 1),
+			.data = Traits::Move(data),
+			.mode = mode,
+			.level = level,
+			.dictionary = mode == CompressionMode::ZSTD && m_dictionary != nullptr,
+			.compressed = {},
+			.compressedSize = 0
+		});
+
+		if (m_pendingSize >= ResourcePackageFlushSize)
+		{
+			Flush();
+		}
+	}
+
+	void ResourcePackageWriter::Flush()
+	{
+		if (m_pending.Empty())
+		{
+			return;
+		}
+
+		auto compress = [&](PendingChunk& pending)
+		{
+			if (pending.mode == CompressionMode::None || pending.data.Empty())
+			{
+				return;
+			}
+
+			pending.compressed.Resize(Compression::GetMaxCompressedBufferSize(pending.data.Size(), pending.mode));
+			pending.compressedSize = pending.dictionary
+				                         ? Compression::Compress(pending.compressed.Data(), pending.compressed.Size(), pending.data.Data(), pending.data.Size(), m_dictionary)
+				                         : Compression::Compress(pending.compressed.Data(), pending.compressed.Size(), pending.data.Data(), pending.data.Size(), pending.mode, pending.level);
+		};
+
+		//chunks are compressed independently, at most m_threads jobs split them
+		u32 count = static_cast<u32>(m_pending.Size());
+		u32 threads = m_threads > 0 ? m_threads : JobSystem::GetWorkerCount() + 1;
+		JobSystem::ParallelFor(count, (count + threads - 1) / threads, [&](u32 index)
+		{
+			compress(m_pending[index]);
+		});
+
+		for (PendingChunk& pending : m_pending)
+		{
+			WritePadding();
+
+			ResourcePackageChunk& chunk = m_chunks[pending.index];
+			chunk.offset = m_offset;
+
+			Span<u8> toWrite = pending.data;
+			if (pending.compressedSize > 0 && pending.compressedSize < pending.data.Size())
+			{
+				toWrite = Span<u8>(pending.compressed.Data(), pending.compressedSize);
+				chunk.mode = pending.mode;
+				chunk.dictionary = pending.dictionary;
+			}
+
+			chunk.size = FileSystem::WriteFile(m_file, toWrite.Data(), toWrite.Size());
+			m_offset += chunk.size;
+		}
+
+		m_pending.Clear();
+		m_pendingSize = 0;
+	}
+
+	void ResourcePackageWriter::AddTableOfContents(Span<u8> data)
+	{
+		AddChunk(data);
+		m_chunks.Back().type = ResourcePackageChunkType::TableOfContents;
+	}
+
+	void ResourcePackageWriter::AddDictionary(Span<u8> data, i32 level)
+	{
+		SK_ASSERT(m_dictionary == nullptr, "package already has a dictionary");
+
+		if (data.Empty())
+		{
+			return;
+		}
+
+		AddChunk(data, CompressionMode::None);
+		m_chunks.Back().type = ResourcePackageChunkType::Dictionary;
+		m_dictionary = Compression::CreateDictionary(data, level);
+	}
+
+	u32 ResourcePackageWriter::GetChunkCount() const
+	{
+		return static_cast<u32>(m_chunks.Size());
+	}
+
+	void ResourcePackageWriter::Close()
+	{
+		if (!m_file)
+		{
+			return;
+		}
+
+		Flush();
+		WritePadding();
+
+		for (const ResourcePackageChunk& chunk : m_chunks)
+		{
+			PackageChunkEntry entry{
+				.offset = chunk.offset,
+				.size = chunk.size,
+				.uncompressedSize = chunk.uncompressedSize,
+				.mode = static_cast<u8>(chunk.mode),
+				.flags = chunk.dictionary ? PackageChunkDictionary : u8{},
+				.type = static_cast<u16>(chunk.type),
+				.group = chunk.group
+			};
+			FileSystem::WriteFile(m_file, &entry, sizeof(PackageChunkEntry));
+		}
+
+		PackageFooter footer{
+			.tableOffset = m_offset,
+			.chunkCount = static_cast<u32>(m_chunks.Size()),
+			.magic = PackageMagic
+		};
+		FileSystem::WriteFile(m_file, &footer, sizeof(PackageFooter));
+		FileSystem::CloseFile(m_file);
+
+		m_file = {};
+		m_offset = 0;
+		m_group = 0;
+		m_chunks.Clear();
+
+		Compression::DestroyDictionary(m_dictionary);
+		m_dictionary = nullptr;
+	}
+
+	void ResourcePackageWriter::WritePadding()
+	{
+		constexpr u8 padding[PackageAlignment] = {};
+		if (u64 size = m_offset % PackageAlignment; size > 0)
+		{
+			m_offset += FileSystem::WriteFile(m_file, padding, PackageAlignment - size);
+		}
+	}
+
+	ResourcePackageReader::~ResourcePackageReader()
+	{
+		Close();
+	}
+
+	bool ResourcePackageReader::Open(StringView path)
+	{
+		Close();
+
+		m_file = FileSystem::OpenFile(path, AccessMode::ReadOnly);
+		if (!m_file)
+		{
+			return false;
+		}
+
+		m_size = FileSystem::GetFileSize(m_file);
+		if (m_size == 0)
+		{
+			Close();
+			return false;
+		}
+
+		if ((m_mapping = FileSystem::CreateFileMapping(m_file, AccessMode::ReadOnly, 0)))
+		{
+			m_view = static_cast<u8*>(FileSystem::MapViewOfFile(m_mapping));
+		}
+
+		if (m_view == nullptr)
+		{
+			m_fileData.Resize(m_size);
+			if (FileSystem::ReadFileAt(m_file, m_fileData.Data(), m_size, 0) != m_size)
+			{
+				logger.Error("failed to read package {}", path);
+				Close();
+				return false;
+			}
+			m_view = m_fileData.Data();
+		}
+
+		const PackageHeader* header = reinterpret_cast<const PackageHeader*>(m_view);
+		const PackageFooter* footer = m_size >= sizeof(PackageHeader) + sizeof(PackageFooter) ? reinterpret_cast<const PackageFooter*>(m_view + m_size - sizeof(PackageFooter)) : nullptr;
+
+		if (footer == nullptr || header->magic != PackageMagic || footer->magic != PackageMagic)
+		{
+			//packages exported before the chunked layout are a single zstd frame
+			u64 uncompressedSize = Compression::GetMaxDecompressedBufferSize(m_view, m_size, CompressionMode::ZSTD);
+			if (uncompressedSize == 0 || uncompressedSize >= U64_MAX - 1) //zstd unknown size or error
+			{
+				logger.Error("{} is not a resource package", path);
+				Close();
+				return false;
+			}
+
+			m_chunks.EmplaceBack(ResourcePackageChunk{
+				.offset = 0,
+				.size = m_size,
+				.uncompressedSize = uncompressedSize,
+				.mode = CompressionMode::ZSTD
+			});
+			return true;
+		}
+
+		if (header->version == 0 || header->version > PackageVersion)
+		{
+			logger.Error("package {} has unsupported version {}", path, header->version);
+			Close();
+			return false;
+		}
+
+		u64 tableEnd = m_size - sizeof(PackageFooter);
+		if (footer->tableOffset < sizeof(PackageHeader) || footer->tableOffset % PackageAlignment != 0 || footer->tableOffset > tableEnd || tableEnd - footer->tableOffset != static_cast<u64>(footer->chunkCount) * sizeof(PackageChunkEntry))
+		{
+			logger.Error("package {} has an invalid chunk table", path);
+			Close();
+			return false;
+		}
+
+		m_chunks.Reserve(footer->chunkCount);
+		for (u32 i = 0; i < footer->chunkCount; ++i)
+		{
+			const PackageChunkEntry* entry = reinterpret_cast<const PackageChunkEntry*>(m_view + footer->tableOffset) + i;
+			if (entry->offset < sizeof(PackageHeader) || entry->offset > footer->tableOffset || entry->size > footer->tableOffset - entry->offset || entry->mode > static_cast<u8>(CompressionMode::LZ4) || (entry->flags & ~PackageChunkDictionary) != 0 || entry->type > static_cast<u16>(ResourcePackageChunkType::Dictionary))
+			{
+				logger.Error("package {} has an invalid chunk {}", path, i);
+				Close();
+				return false;
+			}
+
+			m_chunks.EmplaceBack(ResourcePackageChunk{
+				.offset = entry->offset,
+				.size = entry->size,
+				.uncompressedSize = entry->uncompressedSize,
+				.mode = static_cast<CompressionMode>(entry->mode),
+				.group = entry->group,
+				.type = static_cast<ResourcePackageChunkType>(entry->type),
+				.dictionary = (entry->flags & PackageChunkDictionary) != 0
+			});
+		}
+
+		if (u32 index = FindChunk(ResourcePackageChunkType::Dictionary); index != U32_MAX)
+		{
+			const ResourcePackageChunk& chunk = m_chunks[index];
+			if (chunk.mode != CompressionMode::None || (m_dictionary = Compression::CreateDictionary(Span<u8>(m_view + chunk.offset, chunk.size))) == nullptr)
+			{
+				logger.Error("package {} has an invalid dictionary", path);
+				Close();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void ResourcePackageReader::Close()
+	{
+		if (m_view != nullptr && m_fileData.Empty())
+		{
+			FileSystem::UnmapViewOfFile(m_view);
+		}
+
+		if (m_mapping)
+		{
+			FileSystem::CloseFileMapping(m_mapping);
+		}
+
+		if (m_file)
+		{
+			FileSystem::CloseFile(m_file);
+		}
+
+		m_file = {};
+		m_mapping = {};
+		m_view = nullptr;
+		m_size = 0;
+		m_fileData.Clear();
+		m_chunks.Clear();
+
+		Compression::DestroyDictionary(m_dictionary);
+		m_dictionary = nullptr;
+	}
+
+	u32 ResourcePackageReader::GetChunkCount() const
+	{
+		return static_cast<u32>(m_chunks.Size());
+	}
+
+	const ResourcePackageChunk& ResourcePackageReader::GetChunk(u32 index) const
+	{
+		return m_chunks[index];
+	}
+
+	u32 ResourcePackageReader::FindChunk(ResourcePackageChunkType type) const
+	{
+		for (u32 i = 0; i < m_chunks.Size(); ++i)
+		{
+			if (m_chunks[i].type == type)
+			{
+				return i;
+			}
+		}
+		return U32_MAX;
+	}
+
+	Span<u8> ResourcePackageReader::ReadChunk(u32 index, Array<u8>& buffer) const
+	{
+		const ResourcePackageChunk& chunk = m_chunks[index];
+		if (chunk.mode == CompressionMode::None)
+		{
+			return Span<u8>(m_view + chunk.offset, chunk.size);
+		}
+
+		if (chunk.dictionary && m_dictionary == nullptr)
+		{
+			return {};
+		}
+
+		buffer.Resize(chunk.uncompressedSize);
+		usize size = chunk.dictionary
+			             ? Compression::Decompress(buffer.Data(), buffer.Size(), m_view + chunk.offset, chunk.size, m_dictionary)
+			             : Compression::Decompress(buffer.Data(), buffer.Size(), m_view + chunk.offset, chunk.size, chunk.mode);
+		if (size != chunk.uncompressedSize)
+		{
+			return {};
+		}
+		return Span<u8>(buffer.Data(), size);
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Skore/Common.hpp"
+#include "Skore/Core/Array.hpp"
+#include "Skore/Core/Span.hpp"
+#include "Skore/Core/StringView.hpp"
+#include "Skore/IO/Compression.hpp"
+#include "Skore/IO/FileTypes.hpp"
+
+namespace Skore
+{
+	// uncompressed size the exporter aims for when grouping assets in a chunk.
+	constexpr usize ResourcePackageChunkSize = 256 * 1024;
+
+	// chunks are compressed in parallel once this much uncompressed data is pending, or when the package is closed.
+	constexpr usize ResourcePackageFlushSize = 64 * 1024 * 1024;
+
+	// chunk size for assets loaded on demand, loading one of them only decompresses a small chunk.
+	// the package dictionary keeps these chunks compressing about as well as the large ones.
+	constexpr usize ResourcePackageSmallChunkSize = 16 * 1024;
+
+	enum class ResourcePackageChunkType : u16
+	{
+		Data,
+		TableOfContents, //maps asset paths and uuids to their chunk, used to load assets on demand
+		Dictionary       //zstd dictionary shared by the chunks compressed with it
+	};
+
+	struct ResourcePackageChunk
+	{
+		u64             offset = 0;
+		u64             size = 0;
+		u64             uncompressedSize = 0;
+		CompressionMode mode = CompressionMode::None;
+		u32             group = 0;
+		ResourcePackageChunkType type = ResourcePackageChunkType::Data;
+		bool            dictionary = false;
+	};
+
+	// Exported .resources files are made of chunks that are compressed independently, followed by a chunk table.
+	// Chunks that don't get smaller with compression are stored as-is.
+	// Chunks of the same group don't depend on each other, a group can depend on all the groups before it.
+	class SK_API ResourcePackageWriter
+	{
+	public:
+		ResourcePackageWriter() = default;
+		ResourcePackageWriter(const ResourcePackageWriter&) = delete;
+		ResourcePackageWriter& operator=(const ResourcePackageWriter&) = delete;
+		~ResourcePackageWriter();
+
+		bool Open(StringView path);
+		void SetCompressionThreads(u32 threads); //0 uses every job system worker, 1 compresses on the calling thread
+		void BeginGroup(); //chunks added after it are loaded after the previous chunks
+		void AddChunk(Span<u8> data, CompressionMode mode = CompressionMode::ZSTD, i32 level = CompressionDefaultLevel);
+		void AddChunk(Array<u8>&& data, CompressionMode mode = CompressionMode::ZSTD, i32 level = CompressionDefaultLevel);
+		void AddTableOfContents(Span<u8> data);
+		void AddDictionary(Span<u8> data, i32 level = CompressionDefaultLevel); //zstd chunks added after it are compressed with it
+		u32  GetChunkCount() const;
+		void Flush(); //compresses and writes the pending chunks
+		void Close();
+
+	private:
+		struct PendingChunk
+		{
+			u32             index;
+			Array<u8>       data;
+			CompressionMode mode;
+			i32             level;
+			bool            dictionary;
+			Array<u8>       compressed;
+			usize           compressedSize;
+		};
+
+		void WritePadding();
+
+		FileHandler                 m_file = {};
+		u64                         m_offset = 0;
+		u32                         m_group = 0;
+		u32                         m_threads = 0;
+		Array<ResourcePackageChunk> m_chunks;
+		Array<PendingChunk>         m_pending;
+		usize                       m_pendingSize = 0;
+		CompressionDictionary*      m_dictionary = nullptr;
+	};
+
+	// Reads packages through a file mapping, stored chunks are returned without copying and compressed chunks are
+	// decompressed on demand. Files written before the chunked layout are read as a single zstd chunk.
+	class SK_API ResourcePackageReader
+	{
+	public:
+		ResourcePackageReader() = default;
+		ResourcePackageReader(const ResourcePackageReader&) = delete;
+		ResourcePackageReader& operator=(const ResourcePackageReader&) = delete;
+		~ResourcePackageReader();
+
+		bool Open(StringView path);
+		void Close();
+
+		u32                         GetChunkCount() const;
+		const ResourcePackageChunk& GetChunk(u32 index) const;
+		u32                         FindChunk(ResourcePackageChunkType type) const; //U32_MAX if not found
+
+		// returns an empty span if the chunk is corrupted, buffer is only used for compressed chunks.
+		Span<u8> ReadChunk(u32 index, Array<u8>& buffer) const;
+
+	private:
+		FileHandler                 m_file = {};
+		FileHandler                 m_mapping = {};
+		u8*                         m_view = nullptr;
+		u64                         m_size = 0;
+		Array<u8>                   m_fileData; //used when the file can't be mapped
+		Array<ResourcePackageChunk> m_chunks;
+		CompressionDictionary*      m_dictionary = nullptr;
+	};
+}
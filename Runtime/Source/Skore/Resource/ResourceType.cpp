@@ -212,6 +212,43 @@ namespace Skore
 		return events[static_cast<u32>(eventType)];
 	}
 
+	void ResourceType::AddResource(ResourceStorage* storage)
+	{
+		std::unique_lock lock(resourcesMutex);
+		if (storage->typeIndex != U32_MAX) return;
+
+		storage->typeIndex = static_cast<u32>(resources.Size());
+		resources.EmplaceBack(storage);
+	}
+
+	void ResourceType::RemoveResource(ResourceStorage* storage)
+	{
+		std::unique_lock lock(resourcesMutex);
+		if (storage->typeIndex == U32_MAX) return;
+
+		//swap with the last one to keep the array dense
+		ResourceStorage* last = resources.Back();
+		resources[storage->typeIndex] = last;
+		last->typeIndex = storage->typeIndex;
+		resources.PopBack();
+		storage->typeIndex = U32_MAX;
+	}
+
+	usize ResourceType::GetResourceCount()
+	{
+		std::unique_lock lock(resourcesMutex);
+		return resources.Size();
+	}
+
+	void ResourceType::IterateResources(FnRIDCallback callback, VoidPtr userData)
+	{
+		std::unique_lock lock(resourcesMutex);
+		for (ResourceStorage* storage : resources)
+		{
+			callback(storage->rid, userData);
+		}
+	}
+
 	ConstPtr ResourceType::GetAttribute(TypeID attributeId) const
 	{
 		if (auto it = attributes.Find(attributeId))
@@ -75,6 +75,12 @@ namespace Skore
 		Span<ResourceEvent>  GetEvents(ResourceEventType eventType) const;
 		ConstPtr             GetAttribute(TypeID attributeId) const;
 
+		//live resources of this type, kept up to date on create, destroy and type migration
+		void                 AddResource(ResourceStorage* storage);
+		void                 RemoveResource(ResourceStorage* storage);
+		usize                GetResourceCount();
+		void                 IterateResources(FnRIDCallback callback, VoidPtr userData);
+
 
 		template<typename AttType>
 		const AttType* GetAttribute() const
@@ -99,6 +105,9 @@ namespace Skore
 		Array<ResourceField*>    fields;
 		Array<ResourceEvent>     events[static_cast<u32>(ResourceEventType::MAX)];
 		HashMap<TypeID, VoidPtr> attributes;
+
+		std::mutex              resourcesMutex;
+		Array<ResourceStorage*> resources;
 	};
 
 	struct ResourceInstanceInfo
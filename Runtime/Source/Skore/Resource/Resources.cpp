@@ -1,31 +1,49 @@
 #include "Skore/Resource/Resources.hpp"
 
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 #include <concurrentqueue.h>
 
 #include "Skore/Events.hpp"
 #include "Skore/Core/ByteBuffer.hpp"
 #include "Skore/Core/Event.hpp"
+#include "Skore/Core/FlatHashMap.hpp"
+#include "Skore/Core/JobSystem.hpp"
 #include "Skore/Core/Logger.hpp"
 #include "Skore/Core/Queue.hpp"
 
 #include "Skore/Core/Reflection.hpp"
 #include "Skore/Core/Serialization.hpp"
 #include "Skore/Core/Settings.hpp"
-#include "Skore/IO/Compression.hpp"
 #include "Skore/IO/FileSystem.hpp"
 #include "Skore/IO/Path.hpp"
+#include "Skore/Resource/ResourcePackage.hpp"
 
 #define SK_PAGE(value)    u32((value)/SK_PAGE_SIZE)
 #define SK_OFFSET(value)  (u32)((value) & (SK_PAGE_SIZE - 1))
 
 namespace Skore
 {
+	//field that differs between the instance before and after a change, values are copied into UndoRedoChange::values
+	struct UndoRedoFieldDelta
+	{
+		u32  index;
+		bool hasBefore;
+		bool hasAfter;
+		u32  beforeOffset;
+		u32  afterOffset;
+	};
+
 	struct UndoRedoChange
 	{
-		ResourceStorage* storage;
-		ResourceInstance before;
-		ResourceInstance after;
+		ResourceStorage*          storage;
+		ResourceType*             type = nullptr;
+		bool                      hasBefore = false;
+		bool                      hasAfter = false;
+		Array<UndoRedoFieldDelta> fields;
+		u8*                       values = nullptr;
+		usize                     memorySize = 0;
 
 		~UndoRedoChange();
 	};
@@ -44,12 +62,17 @@ namespace Skore
 		return instances;
 	}
 
+	void ResourceEpochPin();
+	void ResourceEpochUnpin();
+	ResourceInstance ResourceLoadInstance(const ResourceStorage* storage);
+
 	namespace
 	{
 		struct DestroyResourcePayload
 		{
 			ResourceType*    type;
 			ResourceInstance instance;
+			u64              epoch;
 		};
 
 		struct CloneContext
@@ -64,6 +87,7 @@ namespace Skore
 		};
 
 		std::mutex                             resourceTypeMutex{};
+		std::recursive_mutex                   createTypeMutex{};
 		HashMap<TypeID, Array<ResourceType*>>  typesById;
 		HashMap<String, Array<ResourceType*>>  typesByName;
 		HashMap<TypeID, HashSet<TypeID>>       typesByAttribute;
@@ -102,8 +126,8 @@ namespace Skore
 
 		struct ResourcePage
 		{
-			ResourceStorage elements[SK_PAGE_SIZE];
-			bool            used[SK_PAGE_SIZE];
+			ResourceStorage  elements[SK_PAGE_SIZE];
+			std::atomic_bool used[SK_PAGE_SIZE];
 		};
 
 
@@ -113,13 +137,146 @@ namespace Skore
 		std::mutex         pageMutex{};
 
 		std::mutex         byUUIDMutex{};
-		HashMap<UUID, RID> byUUID{};
+		FlatHashMap<UUID, RID> byUUID{};
 
 		std::mutex           byPathMutex{};
 		HashMap<String, RID> byPath{};
 
+		struct LoadedPackage
+		{
+			ResourcePackageReader reader;
+			FileHandler           bufferHandler;
+		};
+
+		//resources registered from a package table of contents, removed from the map once they are loaded
+		struct LazyResource
+		{
+			LoadedPackage*  package;
+			u32             chunk;
+			u32             entry;
+			bool            loading;
+			std::thread::id loadingThread;
+		};
+
+		//thread waiting for a resource another thread is loading
+		struct LazyWait
+		{
+			std::thread::id thread;
+			RID             rid;
+		};
+
+		std::mutex                     lazyMutex{};
+		std::condition_variable        lazyCondition{};
+		FlatHashMap<RID, LazyResource> lazyResources{};
+		std::atomic_size_t             lazyResourceCount{};
+		Array<LazyWait>                lazyWaits{};
+		Array<LoadedPackage*>          loadedPackages{};
+
+		void LoadLazyResource(RID rid);
+
+		SK_FINLINE void EnsureLoaded(RID rid, ResourceStorage* storage)
+		{
+			if (lazyResourceCount.load(std::memory_order_acquire) > 0 && storage->instance.load(std::memory_order_acquire) == nullptr)
+			{
+				LoadLazyResource(rid);
+			}
+		}
+
+		//rids found by uuid can be reserved without storage
+		SK_FINLINE void EnsureLoaded(RID rid)
+		{
+			if (rid && lazyResourceCount.load(std::memory_order_acquire) > 0)
+			{
+				LoadLazyResource(rid);
+			}
+		}
+
 		moodycamel::ConcurrentQueue<DestroyResourcePayload> toCollectItems = moodycamel::ConcurrentQueue<DestroyResourcePayload>(100);
 
+		//epoch based reclamation, threads reading resources pin the current epoch and retired instances are
+		//only freed when every pinned thread has an epoch newer than the one they were retired at.
+		struct EpochThread
+		{
+			std::atomic<u64> epoch{0}; //0 when the thread is not reading
+			std::atomic_bool used{false};
+			EpochThread*     next = nullptr;
+			u32              depth = 0;
+		};
+
+		struct EpochThreadHandle
+		{
+			EpochThread* thread = nullptr;
+
+			~EpochThreadHandle()
+			{
+				if (thread)
+				{
+					thread->epoch.store(0);
+					thread->used.store(false, std::memory_order_release);
+				}
+			}
+		};
+
+		std::atomic<u64>          globalEpoch{1};
+		std::atomic<EpochThread*> epochThreads{};
+		thread_local EpochThreadHandle epochThreadHandle{};
+
+		std::mutex                    collectMutex{};
+		Array<DestroyResourcePayload> retiredItems{};
+		std::atomic<u64>              dispatchedEpoch{0}; //pending events hold old instances, everything retired before it was dispatched
+
+		EpochThread* GetEpochThread()
+		{
+			if (epochThreadHandle.thread)
+			{
+				return epochThreadHandle.thread;
+			}
+
+			//records of finished threads are reused, the list only grows up to the max number of concurrent threads
+			for (EpochThread* thread = epochThreads.load(std::memory_order_acquire); thread != nullptr; thread = thread->next)
+			{
+				bool expected = false;
+				if (thread->used.compare_exchange_strong(expected, true))
+				{
+					epochThreadHandle.thread = thread;
+					return thread;
+				}
+			}
+
+			EpochThread* thread = Alloc<EpochThread>();
+			thread->used.store(true, std::memory_order_relaxed);
+			thread->next = epochThreads.load(std::memory_order_relaxed);
+			while (!epochThreads.compare_exchange_weak(thread->next, thread, std::memory_order_release, std::memory_order_relaxed)) {}
+
+			epochThreadHandle.thread = thread;
+			return thread;
+		}
+
+		//bumps the global epoch and returns the oldest epoch still pinned by a thread
+		u64 AdvanceEpoch()
+		{
+			u64 minEpoch = globalEpoch.fetch_add(1) + 1;
+			for (EpochThread* thread = epochThreads.load(std::memory_order_acquire); thread != nullptr; thread = thread->next)
+			{
+				u64 epoch = thread->epoch.load();
+				if (epoch != 0 && epoch < minEpoch)
+				{
+					minEpoch = epoch;
+				}
+			}
+			return minEpoch;
+		}
+
+		//must be called after the instance is no longer reachable from the storage
+		void RetireInstance(ResourceType* type, ResourceInstance instance)
+		{
+			toCollectItems.enqueue(DestroyResourcePayload{
+				.type = type,
+				.instance = instance,
+				.epoch = globalEpoch.load()
+			});
+		}
+
 		struct PendingEvent
 		{
 			ResourceEventType type;
@@ -132,6 +289,55 @@ namespace Skore
 
 		moodycamel::ConcurrentQueue<PendingEvent> pendingEvents = moodycamel::ConcurrentQueue<PendingEvent>(100);
 
+		struct TransactionChange
+		{
+			ResourceStorage* storage;
+			ResourceInstance oldInstance;
+			ResourceInstance newInstance;
+			UndoRedoScope*   scope;
+		};
+
+		//instance committed inside a transaction, only visible to the committing thread until it is published
+		struct StagedCommit
+		{
+			ResourceStorage* storage; //nullptr if the resource was destroyed or reset afterwards
+			ResourceInstance instance;
+		};
+
+		//commits of the current thread are staged and published together, with version updates and changed events,
+		//at the outermost EndTransaction
+		struct ResourceTransaction
+		{
+			u32                                  depth = 0;
+			Array<TransactionChange>             changes;
+			FlatHashMap<ResourceStorage*, usize> changeIndex;
+			Array<ResourceStorage*>              versionUpdates;
+			HashSet<ResourceStorage*>            versionUpdated;
+			Array<StagedCommit>                  staged;
+			FlatHashMap<ResourceStorage*, usize> stagedIndex;
+		};
+
+		thread_local ResourceTransaction transaction{};
+
+		//transactions of different threads don't interleave their swaps
+		std::mutex transactionPublishMutex{};
+
+		//removes the staged commit of the storage, the instance is returned and must be retired by the caller
+		ResourceInstance DropStagedCommit(ResourceStorage* storage)
+		{
+			if (transaction.depth == 0) return nullptr;
+
+			auto it = transaction.stagedIndex.Find(storage);
+			if (it == transaction.stagedIndex.end()) return nullptr;
+
+			StagedCommit& staged = transaction.staged[it->second];
+			ResourceInstance instance = staged.instance;
+			staged.storage = nullptr;
+			staged.instance = nullptr;
+			transaction.stagedIndex.Erase(it);
+			return instance;
+		}
+
 
 		RID GetFreeID()
 		{
@@ -144,23 +350,60 @@ namespace Skore
 			return &pages[SK_PAGE(rid.id)]->elements[SK_OFFSET(rid.id)];
 		}
 
+		//version the type will get once it is added, reflection types are only added after they are fully built
+		u32 NextTypeVersion(StringView name)
+		{
+			std::unique_lock lock(resourceTypeMutex);
+			auto             it = typesByName.Find(name);
+			return it != typesByName.end() ? static_cast<u32>(it->second.Size()) + 1 : 1;
+		}
+
+		//moves the storage to the resource list of the new type
+		void SetResourceType(ResourceStorage* storage, ResourceType* type)
+		{
+			if (storage->resourceType && storage->resourceType != type)
+			{
+				storage->resourceType->RemoveResource(storage);
+			}
+
+			storage->resourceType = type;
+
+			if (type)
+			{
+				type->AddResource(storage);
+			}
+		}
+
+		//undo and redo of create or destroy changes whether the resource is listed
+		void UpdateTypeResources(ResourceStorage* storage, ResourceInstance instance)
+		{
+			if (storage->resourceType == nullptr) return;
+
+			if (instance)
+			{
+				storage->resourceType->AddResource(storage);
+			}
+			else
+			{
+				storage->resourceType->RemoveResource(storage);
+			}
+		}
+
 		RID GetID(UUID uuid)
 		{
-			if (uuid)
+			if (!uuid)
 			{
-				std::unique_lock lock(byUUIDMutex);
-				if (auto it = byUUID.Find(uuid))
-				{
-					return it->second;
-				}
+				return GetFreeID();
 			}
-			RID rid = GetFreeID();
 
-			if (uuid)
+			//find and insert under the same lock, the same uuid can be reserved from multiple threads
+			std::unique_lock lock(byUUIDMutex);
+			if (auto it = byUUID.Find(uuid))
 			{
-				std::unique_lock lock(byUUIDMutex);
-				byUUID.Insert(uuid, rid);
+				return it->second;
 			}
+			RID rid = GetFreeID();
+			byUUID.Insert(uuid, rid);
 			return rid;
 		}
 
@@ -170,26 +413,39 @@ namespace Skore
 			auto page = SK_PAGE(rid.id);
 			auto offset = SK_OFFSET(rid.id);
 
-			if (pages[page] == nullptr)
+			//resources can be allocated from multiple threads while loading
+			std::atomic_ref<ResourcePage*> pageRef(pages[page]);
+			ResourcePage*                  resourcePage = pageRef.load(std::memory_order_acquire);
+
+			if (resourcePage == nullptr)
 			{
 				std::unique_lock lock(pageMutex);
-				if (pages[page] == nullptr)
+				resourcePage = pageRef.load(std::memory_order_relaxed);
+				if (resourcePage == nullptr)
 				{
-					pages[page] = Alloc<ResourcePage>();
+					resourcePage = Alloc<ResourcePage>();
+					for (std::atomic_bool& used : resourcePage->used)
+					{
+						used.store(false, std::memory_order_relaxed);
+					}
+					pageRef.store(resourcePage, std::memory_order_release);
 					pageCount++;
-					memset(pages[page]->used, 0, sizeof(pages[page]->used));
 				}
 			}
 
-			ResourceStorage* storage = &pages[page]->elements[offset];
+			ResourceStorage* storage = &resourcePage->elements[offset];
 
-			if (!pages[page]->used[offset])
+			if (!resourcePage->used[offset].load(std::memory_order_acquire))
 			{
-				pages[page]->used[offset] = true;
-				new(storage) ResourceStorage{
-					.rid = rid,
-					.uuid = uuid
-				};
+				std::unique_lock lock(pageMutex);
+				if (!resourcePage->used[offset].load(std::memory_order_relaxed))
+				{
+					new(storage) ResourceStorage{
+						.rid = rid,
+						.uuid = uuid
+					};
+					resourcePage->used[offset].store(true, std::memory_order_release);
+				}
 			}
 			return storage;
 		}
@@ -246,6 +502,18 @@ namespace Skore
 			}
 		}
 
+		void UpdateSubObjectParents(ResourceStorage* resourceStorage)
+		{
+			IterateSubObjects(resourceStorage, [&](u32 index, RID subObject)
+			{
+				ResourceStorage* subOjectStorage = GetStorage(subObject);
+				subOjectStorage->parent = resourceStorage;
+				subOjectStorage->parentFieldIndex = index;
+
+				return true;
+			});
+		}
+
 		void ExecuteEvents(ResourceEventType type, ResourceStorage* resourceStorage, ResourceObject&& oldValue, ResourceObject&& newValue, UndoRedoScope* scope)
 		{
 			ResourceStorage* oldStorage = oldValue.GetStorage();
@@ -343,19 +611,22 @@ namespace Skore
 
 			if (type == ResourceEventType::Changed)
 			{
-				IterateSubObjects(resourceStorage, [&](u32 index, RID subObject)
-				{
-					ResourceStorage* subOjectStorage = GetStorage(subObject);
-					subOjectStorage->parent = resourceStorage;
-					subOjectStorage->parentFieldIndex = index;
-
-					return true;
-				});
+				UpdateSubObjectParents(resourceStorage);
 			}
 		}
 
+		//inside a transaction the parent chain is walked once at the end
 		void UpdateVersion(ResourceStorage* resourceStorage)
 		{
+			if (transaction.depth > 0)
+			{
+				if (transaction.versionUpdated.Insert(resourceStorage).second)
+				{
+					transaction.versionUpdates.EmplaceBack(resourceStorage);
+				}
+				return;
+			}
+
 			ResourceStorage* current = resourceStorage;
 			while (current != nullptr)
 			{
@@ -371,6 +642,31 @@ namespace Skore
 			}
 		}
 
+		//inside a transaction only the first old instance and the last new instance of each storage are sent
+		void PublishChanged(ResourceStorage* storage, ResourceInstance oldInstance, ResourceInstance newInstance, UndoRedoScope* scope)
+		{
+			if (transaction.depth > 0)
+			{
+				if (auto it = transaction.changeIndex.Find(storage))
+				{
+					TransactionChange& change = transaction.changes[it->second];
+					change.newInstance = newInstance;
+					change.scope = scope;
+				}
+				else
+				{
+					transaction.changeIndex.Insert(storage, transaction.changes.Size());
+					transaction.changes.EmplaceBack(storage, oldInstance, newInstance, scope);
+				}
+
+				//parents are needed right away, subobjects can be destroyed before the transaction ends
+				UpdateSubObjectParents(storage);
+				return;
+			}
+
+			ExecuteEvents(ResourceEventType::Changed, storage, ResourceObject(storage, oldInstance), ResourceObject(storage, newInstance), scope);
+		}
+
 		template <typename T>
 		void IterateObjectSubObjects(ResourceStorage* resourceStorage, ResourceInstance instance, T&& func)
 		{
@@ -429,11 +725,11 @@ namespace Skore
 		ResourceStorage* originStorage = GetStorage(origin);
 
 		ResourceStorage* storage = GetOrAllocate(dest, uuid);
-		storage->resourceType = originStorage->resourceType;
+		SetResourceType(storage, originStorage->resourceType);
 		storage->resourceTypeVersion = originStorage->resourceTypeVersion;
 		storage->prototype = originStorage->prototype;
 
-		storage->instance = CreateResourceInstanceClone(context, storage, originStorage->instance.load(), scope);
+		storage->instance = CreateResourceInstanceClone(context, storage, ResourceLoadInstance(originStorage), scope);
 
 		if (scope)
 		{
@@ -561,9 +857,11 @@ namespace Skore
 		DestroyAndFree(instance);
 	}
 
+	//the type is only added to the lookups after it's fully built, other loading threads can't see it half done
 	ResourceType* Resources::CreateFromReflectType(ReflectType* reflectType)
 	{
-		ResourceTypeBuilder builder = Type(reflectType->GetProps().typeId, reflectType->GetName());
+		ResourceType*       type = Alloc<ResourceType>(reflectType->GetProps().typeId, reflectType->GetName());
+		ResourceTypeBuilder builder(type);
 		for (ReflectField* field : reflectType->GetFields())
 		{
 			builder.Field(field);
@@ -571,16 +869,16 @@ namespace Skore
 
 		builder.Build();
 
-		ResourceType* type = builder.GetResourceType();
 		type->reflectType = reflectType;
 		type->scope = reflectType->GetScope();
+		type->version = NextTypeVersion(type->GetName());
 
 		//default value
 		if (ReflectConstructor* defaultConstructor = reflectType->GetDefaultConstructor())
 		{
 			RID              rid = GetID({});
 			ResourceStorage* storage = GetOrAllocate(rid, {});
-			storage->resourceType = type;
+			SetResourceType(storage, type);
 			storage->resourceTypeVersion = type->version;
 			storage->instance = nullptr;
 
@@ -602,30 +900,48 @@ namespace Skore
 			}
 		}
 
+		AddType(type);
+
 		return type;
 	}
 
-	ResourceTypeBuilder Resources::Type(TypeID typeId, StringView name)
+	//resources can be deserialized from multiple threads, the type must be created only once
+	ResourceType* Resources::FindOrCreateFromReflectType(ReflectType* reflectType)
 	{
-		auto it = typesById.Find(typeId);
+		std::unique_lock lock(createTypeMutex);
+		if (ResourceType* type = FindTypeByID(reflectType->GetProps().typeId))
+		{
+			return type;
+		}
+		return CreateFromReflectType(reflectType);
+	}
+
+	void Resources::AddType(ResourceType* resourceType)
+	{
+		std::unique_lock lock(resourceTypeMutex);
+
+		auto it = typesById.Find(resourceType->GetID());
 		if (it == typesById.end())
 		{
-			it = typesById.Emplace(typeId, Array<ResourceType*>()).first;
+			it = typesById.Emplace(resourceType->GetID(), Array<ResourceType*>()).first;
 		}
 
-		auto it2 = typesByName.Find(name);
+		auto it2 = typesByName.Find(resourceType->GetName());
 		if (it2 == typesByName.end())
 		{
-			it2 = typesByName.Emplace(name, Array<ResourceType*>()).first;
+			it2 = typesByName.Emplace(resourceType->GetName(), Array<ResourceType*>()).first;
 		}
 
-		ResourceType* resourceType = Alloc<ResourceType>(typeId, name);
-
 		it->second.EmplaceBack(resourceType);
 		it2->second.EmplaceBack(resourceType);
 
 		resourceType->version = it2->second.Size();
+	}
 
+	ResourceTypeBuilder Resources::Type(TypeID typeId, StringView name)
+	{
+		ResourceType* resourceType = Alloc<ResourceType>(typeId, name);
+		AddType(resourceType);
 		return {resourceType};
 	}
 
@@ -654,7 +970,7 @@ namespace Skore
 		{
 			if (ReflectType* reflectType = Reflection::FindTypeById(typeId))
 			{
-				return CreateFromReflectType(reflectType);
+				return FindOrCreateFromReflectType(reflectType);
 			}
 		}
 
@@ -698,21 +1014,21 @@ namespace Skore
 		Array<RID> result;
 		if (type == nullptr) return result;
 
-		std::unique_lock lock(pageMutex);
-		for (u64 i = 0; i < counter; ++i)
+		std::unique_lock lock(type->resourcesMutex);
+		result.Reserve(type->resources.Size());
+		for (ResourceStorage* storage : type->resources)
 		{
-			if (pages[SK_PAGE(i)] == nullptr) continue;
-			if (!pages[SK_PAGE(i)]->used[SK_OFFSET(i)]) continue;
-
-			ResourceStorage& storage = pages[SK_PAGE(i)]->elements[SK_OFFSET(i)];
-			if (storage.resourceType == type)
-			{
-				result.EmplaceBack(storage.rid);
-			}
+			result.EmplaceBack(storage->rid);
 		}
 		return result;
 	}
 
+	void Resources::IterateResourcesByType(ResourceType* type, FnRIDCallback callback, VoidPtr userData)
+	{
+		if (type == nullptr) return;
+		type->IterateResources(callback, userData);
+	}
+
 	void ResourceAddTypeByAttribute(TypeID attributeId, TypeID resourceId)
 	{
 		std::unique_lock lock(resourceTypeMutex);
@@ -750,12 +1066,12 @@ namespace Skore
 		{
 			if (ReflectType* reflectType = Reflection::FindTypeById(typeId))
 			{
-				requestedType = CreateFromReflectType(reflectType);
+				requestedType = FindOrCreateFromReflectType(reflectType);
 			}
 		}
 
 		storage->instance = nullptr;
-		storage->resourceType = requestedType;
+		SetResourceType(storage, requestedType);
 
 		if (storage->resourceType)
 		{
@@ -797,7 +1113,7 @@ namespace Skore
 		RID rid = it->second.first;
 
 		ResourceStorage* storage = GetOrAllocate(rid, it->second.second);
-		storage->resourceType = prototype->resourceType;
+		SetResourceType(storage, prototype->resourceType);
 		storage->resourceTypeVersion = prototype->resourceTypeVersion;
 		storage->prototype = prototype;
 		{
@@ -886,13 +1202,23 @@ namespace Skore
 
 		ResourceInstance oldInstance = storage->instance.exchange(newInstance);
 
+		//resets are not staged, a commit staged before is discarded
+		if (ResourceInstance staged = DropStagedCommit(storage))
+		{
+			if (oldInstance)
+			{
+				RetireInstance(storage->resourceType, oldInstance);
+			}
+			oldInstance = staged;
+		}
+
 		if (scope)
 		{
 			scope->PushChange(storage, oldInstance, newInstance);
 		}
 
 		UpdateVersion(storage);
-		ExecuteEvents(ResourceEventType::Changed, storage, ResourceObject(storage, oldInstance), ResourceObject(storage, newInstance), scope);
+		PublishChanged(storage, oldInstance, newInstance, scope);
 	}
 
 	void Resources::Destroy(RID rid, UndoRedoScope* scope)
@@ -906,24 +1232,112 @@ namespace Skore
 			parentObject.Commit(scope);
 		}
 
-		if (ResourceInstance instance = storage->instance.exchange(nullptr))
+		if (storage->resourceType)
+		{
+			storage->resourceType->RemoveResource(storage);
+		}
+
+		//the retired instance is still read to destroy the subobjects
+		ResourceEpochPin();
+
+		ResourceInstance instance = storage->instance.exchange(nullptr);
+
+		//destroys are not staged, the subobjects of a commit staged before are the current ones
+		if (ResourceInstance staged = DropStagedCommit(storage))
+		{
+			if (instance)
+			{
+				RetireInstance(nullptr, instance);
+			}
+			instance = staged;
+		}
+
+		if (instance)
 		{
 			if (scope)
 			{
 				scope->PushChange(storage, instance, nullptr);
 			}
 
-			ExecuteEvents(ResourceEventType::Changed, storage, ResourceObject(storage, instance), ResourceObject(storage, nullptr), scope);
+			PublishChanged(storage, instance, nullptr, scope);
 
-			toCollectItems.enqueue(DestroyResourcePayload{
-				.instance = instance
-			});
+			RetireInstance(nullptr, instance);
 
 			IterateObjectSubObjects(storage, instance, [scope](u32 index, RID subobject)
 			{
 				Destroy(subobject, scope);
 			});
 		}
+		ResourceEpochUnpin();
+	}
+
+	void Resources::BeginTransaction()
+	{
+		if (transaction.depth++ == 0)
+		{
+			//old instances are kept until their events are queued
+			ResourceEpochPin();
+		}
+	}
+
+	void Resources::EndTransaction()
+	{
+		SK_ASSERT(transaction.depth > 0, "EndTransaction called without BeginTransaction");
+		if (--transaction.depth > 0) return;
+
+		//events can commit again, so the transaction is reset before sending them
+		Array<ResourceStorage*>  versionUpdates = Traits::Move(transaction.versionUpdates);
+		Array<TransactionChange> changes = Traits::Move(transaction.changes);
+		Array<StagedCommit>      staged = Traits::Move(transaction.staged);
+		transaction.versionUpdates.Clear();
+		transaction.versionUpdated.Clear();
+		transaction.changes.Clear();
+		transaction.changeIndex.Clear();
+		transaction.staged.Clear();
+		transaction.stagedIndex.Clear();
+
+		//all staged instances are swapped together, in commit order
+		{
+			std::unique_lock lock(transactionPublishMutex);
+			for (const StagedCommit& commit : staged)
+			{
+				if (commit.storage == nullptr) continue;
+
+				ResourceInstance oldInstance = commit.storage->instance.exchange(commit.instance);
+				if (oldInstance)
+				{
+					RetireInstance(commit.storage->resourceType, oldInstance);
+				}
+				else
+				{
+					//writing a destroyed resource brings it back
+					UpdateTypeResources(commit.storage, commit.instance);
+				}
+			}
+		}
+
+		HashSet<ResourceStorage*> updated;
+		for (ResourceStorage* storage : versionUpdates)
+		{
+			//stops at the first parent already updated, everything above it was updated with it
+			for (ResourceStorage* current = storage; current != nullptr && updated.Insert(current).second; current = current->parent)
+			{
+				++current->version;
+
+				ExecuteEvents(ResourceEventType::VersionUpdated,
+				              current,
+				              ResourceObject(nullptr, nullptr),
+				              ResourceObject(current, current->instance.load()),
+				              nullptr);
+			}
+		}
+
+		for (const TransactionChange& change : changes)
+		{
+			ExecuteEvents(ResourceEventType::Changed, change.storage, ResourceObject(change.storage, change.oldInstance), ResourceObject(change.storage, change.newInstance), change.scope);
+		}
+
+		ResourceEpochUnpin();
 	}
 
 	u64 Resources::GetVersion(RID rid)
@@ -934,11 +1348,14 @@ namespace Skore
 	ResourceObject Resources::Write(RID rid)
 	{
 		ResourceStorage* storage = GetStorage(rid);
+		EnsureLoaded(rid, storage);
 		SK_ASSERT(storage->resourceType, "type cannot be null");
 
 		ResourceInstance instance = nullptr;
 
-		if (ResourceInstance current = storage->instance.load())
+		ResourceEpochPin();
+		ResourceInstance current = ResourceLoadInstance(storage);
+		if (current)
 		{
 			instance = CreateResourceInstanceCopy(storage->resourceType, current);
 		}
@@ -946,10 +1363,12 @@ namespace Skore
 		{
 			instance = storage->resourceType->Allocate();
 		}
+		ResourceEpochUnpin();
 
+		//commit only succeeds if the storage still points to the instance that was copied
 		ResourceInstanceInfo& info = *reinterpret_cast<ResourceInstanceInfo*>(instance);
 		info.readOnly = false;
-		info.dataOnWrite = storage->instance.load();
+		info.dataOnWrite = current;
 
 		return ResourceObject{storage, instance};
 	}
@@ -957,13 +1376,15 @@ namespace Skore
 	ResourceObject Resources::Read(RID rid)
 	{
 		ResourceStorage* storage = GetStorage(rid);
+		EnsureLoaded(rid, storage);
 		return ResourceObject{storage, nullptr};
 	}
 
 	bool Resources::HasValue(RID rid)
 	{
 		ResourceStorage* storage = GetStorage(rid);
-		return storage->instance != nullptr;
+		EnsureLoaded(rid, storage);
+		return ResourceLoadInstance(storage) != nullptr;
 	}
 
 	RID Resources::GetParent(RID rid)
@@ -1008,15 +1429,18 @@ namespace Skore
 
 	RID Resources::FindByUUID(const UUID& uuid)
 	{
+		RID rid = {};
 		if (uuid)
 		{
 			std::unique_lock lock(byUUIDMutex);
 			if (auto it = byUUID.Find(uuid))
 			{
-				return it->second;
+				rid = it->second;
 			}
 		}
-		return {};
+
+		EnsureLoaded(rid);
+		return rid;
 	}
 
 	RID Resources::FindOrReserveByUUID(const UUID& uuid)
@@ -1057,12 +1481,17 @@ namespace Skore
 
 	RID Resources::FindByPath(StringView path)
 	{
-		std::unique_lock lock(byPathMutex);
-		if (auto it = byPath.Find(path))
+		RID rid = {};
 		{
-			return it->second;
+			std::unique_lock lock(byPathMutex);
+			if (auto it = byPath.Find(path))
+			{
+				rid = it->second;
+			}
 		}
-		return {};
+
+		EnsureLoaded(rid);
+		return rid;
 	}
 
 	void Resources::Serialize(RID ridx, ArchiveWriter& writer)
@@ -1360,15 +1789,16 @@ namespace Skore
 
 			ResourceStorage* storage = GetOrAllocate(rid, uuid);
 			storage->instance = nullptr;
-			storage->resourceType = FindTypeByName(typeName);
 
-			if (storage->resourceType == nullptr && !typeName.Empty())
+			ResourceType* resourceType = FindTypeByName(typeName);
+			if (resourceType == nullptr && !typeName.Empty())
 			{
 				if (ReflectType* reflectType = Reflection::FindTypeByName(typeName))
 				{
-					storage->resourceType = CreateFromReflectType(reflectType);
+					resourceType = FindOrCreateFromReflectType(reflectType);
 				}
 			}
+			SetResourceType(storage, resourceType);
 
 			if (storage->resourceType == nullptr)
 			{
@@ -1385,6 +1815,7 @@ namespace Skore
 			{
 				//it should be GetOrAllocate, but it's not working.
 				storage->prototype = GetOrAllocate(prototype, prototypeUUID);
+				EnsureLoaded(prototype, storage->prototype);
 				{
 					std::unique_lock lock(storage->prototype->prototypeInstancesMutex);
 					storage->prototype->prototypeInstances.Insert(rid);
@@ -1798,37 +2229,84 @@ namespace Skore
 	}
 
 
-	void Resources::GarbageCollect()
+	void ResourceEpochPin()
 	{
-		DestroyResourcePayload payload{};
-		while (toCollectItems.try_dequeue(payload))
+		EpochThread* thread = GetEpochThread();
+		if (thread->depth++ == 0)
 		{
-			DestroyResourceInstance(payload.type, payload.instance);
+			thread->epoch.store(globalEpoch.load());
 		}
 	}
 
-	void Resources::DispatchEvents()
+	void ResourceEpochUnpin()
 	{
-		PendingEvent pendingEvent{};
-		while (pendingEvents.try_dequeue(pendingEvent))
+		EpochThread* thread = epochThreadHandle.thread;
+		SK_ASSERT(thread && thread->depth > 0, "unbalanced resource epoch unpin");
+		if (--thread->depth == 0)
 		{
-			auto dispatch = [](ResourceEventType type, ResourceStorage* storage, ResourceObject&& oldValue, ResourceObject&& newValue)
-			{
-				for (const ResourceEvent& event : storage->events[static_cast<u32>(type)])
-				{
-					event.function(oldValue, newValue, event.userData);
-				}
+			thread->epoch.store(0, std::memory_order_release);
+		}
+	}
 
-				if (storage->resourceType != nullptr)
-				{
-					for (const ResourceEvent& event : storage->resourceType->GetEvents(type))
-					{
-						event.function(oldValue, newValue, event.userData);
-					}
-				}
-			};
+	void ResourceCollectGarbage(bool force)
+	{
+		std::unique_lock lock(collectMutex);
 
-			dispatch(pendingEvent.type,
+		//threads pinning from now on can't see anything retired before this point
+		u64 minEpoch = Math::Min(AdvanceEpoch(), dispatchedEpoch.load());
+
+		DestroyResourcePayload payload{};
+		while (toCollectItems.try_dequeue(payload))
+		{
+			retiredItems.EmplaceBack(payload);
+		}
+
+		usize kept = 0;
+		for (usize i = 0; i < retiredItems.Size(); ++i)
+		{
+			const DestroyResourcePayload& item = retiredItems[i];
+			if (force || item.epoch < minEpoch)
+			{
+				DestroyResourceInstance(item.type, item.instance);
+			}
+			else
+			{
+				retiredItems[kept++] = item;
+			}
+		}
+		retiredItems.Resize(kept);
+	}
+
+	void Resources::GarbageCollect()
+	{
+		ResourceCollectGarbage(false);
+	}
+
+	void Resources::DispatchEvents()
+	{
+		//events for instances retired before this epoch are either in the queue already or queued by a thread that is still pinned
+		u64 epoch = AdvanceEpoch();
+
+		PendingEvent pendingEvent{};
+		while (pendingEvents.try_dequeue(pendingEvent))
+		{
+			auto dispatch = [](ResourceEventType type, ResourceStorage* storage, ResourceObject&& oldValue, ResourceObject&& newValue)
+			{
+				for (const ResourceEvent& event : storage->events[static_cast<u32>(type)])
+				{
+					event.function(oldValue, newValue, event.userData);
+				}
+
+				if (storage->resourceType != nullptr)
+				{
+					for (const ResourceEvent& event : storage->resourceType->GetEvents(type))
+					{
+						event.function(oldValue, newValue, event.userData);
+					}
+				}
+			};
+
+			dispatch(pendingEvent.type,
 			         pendingEvent.subject,
 			         ResourceObject{pendingEvent.oldStorage, pendingEvent.oldInstance},
 			         ResourceObject{pendingEvent.newStorage, pendingEvent.newInstance}
@@ -1837,7 +2315,7 @@ namespace Skore
 			for (RID rid : pendingEvent.newStorage->GetPrototypeInstancesSafe())
 			{
 				ResourceStorage* prototypeInstanceStorage = GetStorage(rid);
-				ResourceInstance value = prototypeInstanceStorage->instance.load();
+				ResourceInstance value = ResourceLoadInstance(prototypeInstanceStorage);
 				dispatch(
 					pendingEvent.type,
 					prototypeInstanceStorage,
@@ -1846,6 +2324,8 @@ namespace Skore
 				);
 			}
 		}
+
+		dispatchedEpoch.store(epoch);
 	}
 
 	void Resources::EndFrame()
@@ -1968,7 +2448,7 @@ namespace Skore
 
 		if (oldInstance == nullptr)
 		{
-			storage->resourceType = newType;
+			SetResourceType(storage, newType);
 			storage->resourceTypeVersion = newType->GetVersion();
 			return;
 		}
@@ -1980,13 +2460,10 @@ namespace Skore
 		ResourceInstance expected = oldInstance;
 		if (storage->instance.compare_exchange_strong(expected, newInstance))
 		{
-			storage->resourceType = newType;
+			SetResourceType(storage, newType);
 			storage->resourceTypeVersion = newType->GetVersion();
 
-			toCollectItems.enqueue(DestroyResourcePayload{
-				.type = oldType,
-				.instance = oldInstance
-			});
+			RetireInstance(oldType, oldInstance);
 
 			UpdateVersion(storage);
 
@@ -2140,7 +2617,7 @@ namespace Skore
 
 	void SK_API ResourceShutdown()
 	{
-		Resources::GarbageCollect();
+		ResourceCollectGarbage(true);
 
 		for (u64 i = 0; i < counter; ++i)
 		{
@@ -2171,10 +2648,19 @@ namespace Skore
 			DestroyAndFree(it.second.instance);
 		}
 
+		for (LoadedPackage* package : loadedPackages)
+		{
+			DestroyAndFree(package);
+		}
+		loadedPackages.Clear();
+		lazyResources.Clear();
+		lazyResourceCount = 0;
+
 		for (const auto & handler : fileHandlers)
 		{
 			FileSystem::CloseFile(handler);
 		}
+		fileHandlers.Clear();
 
 		typesById.Clear();
 		typesByName.Clear();
@@ -2196,11 +2682,69 @@ namespace Skore
 		UpdateVersion(storage);
 	}
 
+	ResourceInstance ResourceLoadInstance(const ResourceStorage* storage)
+	{
+		if (transaction.depth > 0 && !transaction.stagedIndex.Empty())
+		{
+			if (auto it = transaction.stagedIndex.Find(const_cast<ResourceStorage*>(storage)))
+			{
+				return transaction.staged[it->second].instance;
+			}
+		}
+		return storage->instance.load();
+	}
+
+	namespace
+	{
+		void StageCommit(ResourceStorage* storage, ResourceInstance instance, UndoRedoScope* scope)
+		{
+			ResourceInstanceInfo& info = *reinterpret_cast<ResourceInstanceInfo*>(instance);
+			ResourceInstance      current = ResourceLoadInstance(storage);
+
+			//same rule as the swap outside transactions, a write based on an outdated instance is dropped
+			if (info.dataOnWrite && info.dataOnWrite != current)
+			{
+				RetireInstance(storage->resourceType, instance);
+				return;
+			}
+
+			if (scope)
+			{
+				scope->PushChange(storage, current, instance);
+			}
+
+			if (auto it = transaction.stagedIndex.Find(storage))
+			{
+				//never published, only this thread could have read it
+				RetireInstance(storage->resourceType, transaction.staged[it->second].instance);
+				transaction.staged[it->second].instance = instance;
+			}
+			else
+			{
+				transaction.stagedIndex.Insert(storage, transaction.staged.Size());
+				transaction.staged.EmplaceBack(StagedCommit{storage, instance});
+			}
+
+			UpdateVersion(storage);
+			PublishChanged(storage, current, instance, scope);
+		}
+	}
+
 	void ResourceCommit(ResourceStorage* storage, ResourceInstance instance, UndoRedoScope* scope)
 	{
 		ResourceInstanceInfo& info = *reinterpret_cast<ResourceInstanceInfo*>(instance);
 		info.readOnly = true;
 
+		//keeps the retired instance alive until the changed event is queued
+		ResourceEpochPin();
+
+		if (transaction.depth > 0)
+		{
+			StageCommit(storage, instance, scope);
+			ResourceEpochUnpin();
+			return;
+		}
+
 		if (info.dataOnWrite)
 		{
 			if (storage->instance.compare_exchange_strong(info.dataOnWrite, instance))
@@ -2210,10 +2754,7 @@ namespace Skore
 					scope->PushChange(storage, info.dataOnWrite, instance);
 				}
 
-				toCollectItems.enqueue(DestroyResourcePayload{
-					.type = storage->resourceType,
-					.instance = info.dataOnWrite
-				});
+				RetireInstance(storage->resourceType, info.dataOnWrite);
 			}
 		}
 		else
@@ -2223,16 +2764,166 @@ namespace Skore
 				scope->PushChange(storage, nullptr, instance);
 			}
 			storage->instance = instance;
+
+			//writing a destroyed resource brings it back
+			storage->resourceType->AddResource(storage);
 		}
 
 		UpdateVersion(storage);
-		ExecuteEvents(ResourceEventType::Changed, storage, ResourceObject(storage, info.dataOnWrite), ResourceObject(storage, instance), scope);
+		PublishChanged(storage, info.dataOnWrite, instance, scope);
+		ResourceEpochUnpin();
+	}
+
+	namespace
+	{
+		SK_FINLINE bool HasFieldValue(ResourceInstance instance, u32 index)
+		{
+			return instance != nullptr && *reinterpret_cast<bool*>(&instance[sizeof(ResourceInstanceInfo) + index]);
+		}
+
+		bool FieldValueEquals(ResourceFieldType type, ConstPtr left, ConstPtr right, usize size)
+		{
+			switch (type)
+			{
+				case ResourceFieldType::String:
+					return *static_cast<const String*>(left) == *static_cast<const String*>(right);
+				case ResourceFieldType::Blob:
+				{
+					const ByteBuffer& leftBuffer = *static_cast<const ByteBuffer*>(left);
+					const ByteBuffer& rightBuffer = *static_cast<const ByteBuffer*>(right);
+					return leftBuffer.Size() == rightBuffer.Size() && memcmp(leftBuffer.Data(), rightBuffer.Data(), leftBuffer.Size()) == 0;
+				}
+				case ResourceFieldType::ReferenceArray:
+					return *static_cast<const Array<RID>*>(left) == *static_cast<const Array<RID>*>(right);
+				case ResourceFieldType::SubObjectList:
+				{
+					const SubObjectList& leftList = *static_cast<const SubObjectList*>(left);
+					const SubObjectList& rightList = *static_cast<const SubObjectList*>(right);
+					if (leftList.subObjects != rightList.subObjects || leftList.prototypeRemoved.Size() != rightList.prototypeRemoved.Size())
+					{
+						return false;
+					}
+					for (RID rid : leftList.prototypeRemoved)
+					{
+						if (!rightList.prototypeRemoved.Has(rid))
+						{
+							return false;
+						}
+					}
+					return true;
+				}
+				default:
+					//trivial values, buffers are equal if they share the same instance
+					return memcmp(left, right, size) == 0;
+			}
+		}
+
+		//heap memory owned by a field value, used to account the undo memory
+		usize FieldHeapSize(ResourceFieldType type, ConstPtr value)
+		{
+			switch (type)
+			{
+				case ResourceFieldType::String:
+					return static_cast<const String*>(value)->Size();
+				case ResourceFieldType::Blob:
+					return static_cast<const ByteBuffer*>(value)->Size();
+				case ResourceFieldType::ReferenceArray:
+					return static_cast<const Array<RID>*>(value)->Size() * sizeof(RID);
+				case ResourceFieldType::SubObjectList:
+				{
+					const SubObjectList& list = *static_cast<const SubObjectList*>(value);
+					return (list.subObjects.Size() + list.prototypeRemoved.Size()) * sizeof(RID);
+				}
+				default:
+					return 0;
+			}
+		}
+
+		//builds the instance of one side of the change on top of the current one, only changed fields are touched
+		ResourceInstance ApplyUndoRedoChange(const UndoRedoChange& change, bool before)
+		{
+			ResourceType* type = change.storage->resourceType;
+			if (!(before ? change.hasBefore : change.hasAfter) || type == nullptr)
+			{
+				return nullptr;
+			}
+
+			ResourceInstance current = ResourceLoadInstance(change.storage);
+			ResourceInstance instance = current ? CreateResourceInstanceCopy(type, current) : type->Allocate();
+
+			Span<ResourceField*> fields = type->GetFields();
+			for (const UndoRedoFieldDelta& delta : change.fields)
+			{
+				//fields changed by a type migration after the change was recorded are skipped
+				ResourceField* field = delta.index < fields.Size() ? fields[delta.index] : nullptr;
+				if (field == nullptr || field->GetType() != change.type->GetFields()[delta.index]->GetType()) continue;
+
+				FieldProps props = field->GetTypeStaticProps();
+				bool&      hasValue = *reinterpret_cast<bool*>(&instance[sizeof(ResourceInstanceInfo) + delta.index]);
+
+				if (hasValue)
+				{
+					props.fnDestroy(&instance[field->GetOffset()]);
+					memset(&instance[field->GetOffset()], 0, field->GetSize());
+				}
+
+				hasValue = before ? delta.hasBefore : delta.hasAfter;
+				if (hasValue)
+				{
+					props.fnCopy(&instance[field->GetOffset()], &change.values[before ? delta.beforeOffset : delta.afterOffset]);
+				}
+			}
+
+			return instance;
+		}
+
+		void ReplayUndoRedoChange(const UndoRedoChange& change, bool before)
+		{
+			ResourceEpochPin();
+
+			ResourceInstance newInstance = ApplyUndoRedoChange(change, before);
+			ResourceInstance oldInstance = change.storage->instance.exchange(newInstance);
+			if (ResourceInstance staged = DropStagedCommit(change.storage))
+			{
+				if (oldInstance)
+				{
+					RetireInstance(change.storage->resourceType, oldInstance);
+				}
+				oldInstance = staged;
+			}
+			UpdateTypeResources(change.storage, newInstance);
+
+			UpdateVersion(change.storage);
+
+			PublishChanged(change.storage, oldInstance, newInstance, nullptr);
+
+			RetireInstance(change.storage->resourceType, oldInstance);
+
+			ResourceEpochUnpin();
+		}
 	}
 
 	UndoRedoChange::~UndoRedoChange()
 	{
-		DestroyResourceInstance(storage->resourceType, before);
-		DestroyResourceInstance(storage->resourceType, after);
+		if (type == nullptr) return;
+
+		for (const UndoRedoFieldDelta& delta : fields)
+		{
+			FieldProps props = type->GetFields()[delta.index]->GetTypeStaticProps();
+			if (delta.hasBefore)
+			{
+				props.fnDestroy(&values[delta.beforeOffset]);
+			}
+			if (delta.hasAfter)
+			{
+				props.fnDestroy(&values[delta.afterOffset]);
+			}
+		}
+
+		if (values)
+		{
+			MemFree(values);
+		}
 	}
 
 	UndoRedoScope::UndoRedoScope(StringView name) : name(name) {}
@@ -2242,12 +2933,72 @@ namespace Skore
 	void UndoRedoScope::PushChange(ResourceStorage* storage, ResourceInstance before, ResourceInstance after)
 	{
 		std::unique_ptr<UndoRedoChange> change = std::make_unique<UndoRedoChange>(storage);
+		change->type = storage->resourceType;
+		change->hasBefore = before != nullptr;
+		change->hasAfter = after != nullptr;
+		change->memorySize = sizeof(UndoRedoChange);
+
+		if (ResourceType* type = change->type)
+		{
+			//only fields that differ are stored, values are packed in a single allocation
+			usize valuesSize = 0;
+			auto  reserveValue = [&](const ResourceField* field) -> u32
+			{
+				usize alignment = Math::Max<usize>(field->GetTypeStaticProps().alignment, 1);
+				valuesSize = (valuesSize + alignment - 1) & ~(alignment - 1);
+				u32 offset = static_cast<u32>(valuesSize);
+				valuesSize += field->GetSize();
+				return offset;
+			};
 
-		change->before = CreateResourceInstanceCopy(storage->resourceType, before);
-		change->after = CreateResourceInstanceCopy(storage->resourceType, after);
+			for (ResourceField* field : type->GetFields())
+			{
+				if (field == nullptr) continue;
+
+				bool hasBefore = HasFieldValue(before, field->GetIndex());
+				bool hasAfter = HasFieldValue(after, field->GetIndex());
+
+				if (!hasBefore && !hasAfter) continue;
+				if (hasBefore && hasAfter && FieldValueEquals(field->GetType(), &before[field->GetOffset()], &after[field->GetOffset()], field->GetSize())) continue;
+
+				change->fields.EmplaceBack(UndoRedoFieldDelta{
+					.index = field->GetIndex(),
+					.hasBefore = hasBefore,
+					.hasAfter = hasAfter,
+					.beforeOffset = hasBefore ? reserveValue(field) : U32_MAX,
+					.afterOffset = hasAfter ? reserveValue(field) : U32_MAX
+				});
+			}
+
+			if (valuesSize > 0)
+			{
+				change->values = static_cast<u8*>(MemAlloc(valuesSize));
+				memset(change->values, 0, valuesSize);
+			}
+
+			for (const UndoRedoFieldDelta& delta : change->fields)
+			{
+				ResourceField* field = type->GetFields()[delta.index];
+				FieldProps     props = field->GetTypeStaticProps();
+
+				if (delta.hasBefore)
+				{
+					props.fnCopy(&change->values[delta.beforeOffset], &before[field->GetOffset()]);
+					change->memorySize += FieldHeapSize(field->GetType(), &before[field->GetOffset()]);
+				}
+				if (delta.hasAfter)
+				{
+					props.fnCopy(&change->values[delta.afterOffset], &after[field->GetOffset()]);
+					change->memorySize += FieldHeapSize(field->GetType(), &after[field->GetOffset()]);
+				}
+			}
+
+			change->memorySize += change->fields.Size() * sizeof(UndoRedoFieldDelta) + valuesSize;
+		}
 
 		{
 			std::unique_lock lock(mutex);
+			memorySize += change->memorySize;
 			changes.EmplaceBack(Traits::Move(change));
 		}
 	}
@@ -2257,19 +3008,7 @@ namespace Skore
 		std::unique_lock lock(mutex);
 		for (u32 i = changes.Size(); i > 0; --i)
 		{
-			const auto& action = changes[i - 1];
-
-			ResourceInstance newInstance = CreateResourceInstanceCopy(action->storage->resourceType, action->before);
-			ResourceInstance oldInstance = action->storage->instance.exchange(newInstance);
-
-			UpdateVersion(action->storage);
-
-			ExecuteEvents(ResourceEventType::Changed, action->storage, ResourceObject(action->storage, oldInstance), ResourceObject(action->storage, newInstance), nullptr);
-
-			toCollectItems.enqueue({
-				.type = action->storage->resourceType,
-				.instance = oldInstance
-			});
+			ReplayUndoRedoChange(*changes[i - 1], true);
 		}
 	}
 
@@ -2278,20 +3017,16 @@ namespace Skore
 		std::unique_lock lock(mutex);
 		for (const auto& action : changes)
 		{
-			ResourceInstance newInstance = CreateResourceInstanceCopy(action->storage->resourceType, action->after);
-			ResourceInstance oldInstance = action->storage->instance.exchange(newInstance);
-
-			UpdateVersion(action->storage);
-
-			ExecuteEvents(ResourceEventType::Changed, action->storage, ResourceObject(action->storage, oldInstance), ResourceObject(action->storage, newInstance), nullptr);
-
-			toCollectItems.enqueue({
-				.type = action->storage->resourceType,
-				.instance = oldInstance
-			});
+			ReplayUndoRedoChange(*action, false);
 		}
 	}
 
+	usize UndoRedoScope::GetMemorySize()
+	{
+		std::unique_lock lock(mutex);
+		return memorySize;
+	}
+
 
 	UndoRedoScope* UndoRedoScope::Create(StringView name)
 	{
@@ -2309,89 +3044,454 @@ namespace Skore
 	}
 
 
-	RID Resources::LoadResources(StringView filePath)
+	struct PackageChunkResult
 	{
-		Array<u8> compressedBuffer(MemoryGlobals::GetHeapAllocator());
-		FileSystem::ReadFileAsByteArray(filePath, compressedBuffer);
-		usize decompressedSize = Compression::GetMaxDecompressedBufferSize(compressedBuffer.Data(), compressedBuffer.Size(), CompressionMode::ZSTD);
+		RID        projectSettings;
+		Array<RID> assets;
+	};
 
-		Array<u8> uncompressedBuffer(MemoryGlobals::GetHeapAllocator());
-		uncompressedBuffer.Resize(decompressedSize);
-		Compression::Decompress(uncompressedBuffer.Data(), uncompressedBuffer.Size(), compressedBuffer.Data(), compressedBuffer.Size(), CompressionMode::ZSTD);
+	//reads the current entry of an "assets" sequence
+	static RID LoadPackageAsset(BinaryArchiveReader& reader, FileHandler bufferHandler)
+	{
+		reader.BeginMap();
+		String pathId = reader.ReadString("pathId");
+		RID    rid = Resources::Deserialize(reader);
+		logger.Debug("asset {} loaded with rid {} ", pathId, rid.id);
+		if (rid)
+		{
+			Resources::SetPath(rid, pathId);
+		}
 
-		BinaryArchiveReader reader{uncompressedBuffer};
+		struct BufferInfo
+		{
+			u64    offset;
+			u64    size;
+		};
+		HashMap<String, BufferInfo> buffers;
+
+		if (reader.ReadUInt("bufferCount") > 0)
+		{
+			reader.BeginSeq("buffers");
+
+			while (reader.NextSeqEntry())
+			{
+				reader.BeginMap();
+				buffers.Emplace(reader.ReadString("id"), BufferInfo{
+					                .offset = reader.ReadUInt("offset"),
+					                .size = reader.ReadUInt("size")
+				                });
+				reader.EndSeq();
+			}
+			reader.EndSeq();
+		}
 
-		RID projectSettings = {};
-		reader.BeginMap("projectSettings");
-		projectSettings = Settings::Load(reader, TypeInfo<ProjectSettings>::ID());
 		reader.EndMap();
 
-		String bufferFile = Path::Join(Path::Parent(filePath), Path::Name(filePath) + SK_BUFFER_EXT);
-		FileHandler bufferHandler = FileSystem::OpenFile(bufferFile, AccessMode::ReadOnly);
-		fileHandlers.EmplaceBack(bufferHandler);
+		if (ResourceObject resourceObject = Resources::Read(rid))
+		{
+			resourceObject.IterateAllBuffers([&](const ResourceBuffer& buffer)
+			{
+				if (auto it = buffers.Find(buffer.GetIdAsString()))
+				{
+					buffer.MapFile(bufferHandler, true, it->second.offset, it->second.size);
+					logger.Debug("buffer {} loaded with offset {}, size {}  ", it->first, it->second.offset, it->second.size);
+				}
+			});
+		}
+
+		return rid;
+	}
+
+	static void CallResourceLoader(RID rid)
+	{
+		if (ResourceStorage* storage = GetStorage(rid); storage != nullptr && storage->resourceType != nullptr)
+		{
+			if (const auto& it = resourceLoaders.Find(storage->resourceType->GetID()))
+			{
+				it->second.instance->LoadResource(rid);
+			}
+		}
+	}
 
-		reader.BeginSeq("assets");
+	//entries of a chunk registered from the table of contents
+	struct TableOfContentsChunk
+	{
+		HashSet<u32> lazyEntries;            //loaded on demand, not parsed with the chunk
+		bool         hasEagerEntries = false; //invalid entries are loaded with the chunk
+	};
+
+	static void LoadPackageChunk(const ResourcePackageReader& package, u32 index, FileHandler bufferHandler, const HashSet<u32>& lazyEntries, PackageChunkResult& result)
+	{
+		//only used while the chunk is parsed, LoadResources blocks until all chunks are done
+		Array<u8> chunkBuffer(MemoryGlobals::GetFrameAllocator());
+		Span<u8>  chunk = package.ReadChunk(index, chunkBuffer);
+		if (chunk.Empty())
 		{
+			logger.Error("resource package chunk {} is corrupted", index);
+			return;
+		}
+
+		BinaryArchiveReader reader{chunk};
+
+		if (reader.BeginMap("projectSettings"))
+		{
+			result.projectSettings = Settings::Load(reader, TypeInfo<ProjectSettings>::ID());
+			reader.EndMap();
+		}
+
+		if (reader.BeginSeq("assets"))
+		{
+			u32 entry = 0;
 			while (reader.NextSeqEntry())
 			{
-				reader.BeginMap();
-				String pathId = reader.ReadString("pathId");
-				RID    rid = Deserialize(reader);
-				logger.Debug("asset {} loaded with rid {} ", pathId, rid.id);
-				if (rid)
+				if (lazyEntries.Has(entry++))
 				{
-					SetPath(rid, pathId);
+					continue;
 				}
 
-				struct BufferInfo
+				if (RID rid = LoadPackageAsset(reader, bufferHandler))
 				{
-					u64    offset;
-					u64    size;
-				};
-				HashMap<String, BufferInfo> buffers;
+					result.assets.EmplaceBack(rid);
+				}
+			}
+			reader.EndSeq();
+		}
+	}
+
+	//reserves the rids of the assets listed in the table of contents, chunks only containing listed assets are not loaded upfront.
+	static u32 RegisterTableOfContents(LoadedPackage* package, Array<TableOfContentsChunk>& chunks)
+	{
+		u32 tableIndex = package->reader.FindChunk(ResourcePackageChunkType::TableOfContents);
+		if (tableIndex == U32_MAX)
+		{
+			return 0;
+		}
+
+		Array<u8> chunkBuffer(MemoryGlobals::GetFrameAllocator());
+		Span<u8>  chunk = package->reader.ReadChunk(tableIndex, chunkBuffer);
+		if (chunk.Empty())
+		{
+			logger.Error("resource package table of contents is corrupted");
+			return 0;
+		}
+
+		BinaryArchiveReader reader{chunk};
+		if (!reader.BeginSeq("assets"))
+		{
+			return 0;
+		}
+
+		u32 count = 0;
+		while (reader.NextSeqEntry())
+		{
+			reader.BeginMap();
+			String     pathId = reader.ReadString("pathId");
+			UUID       uuid = UUID::FromString(reader.ReadString("uuid"));
+			StringView typeName = reader.ReadString("type");
+			u64        chunkIndex = reader.ReadUInt("chunk");
+			u64        entryIndex = reader.ReadUInt("entry");
+			reader.EndMap();
 
-				if (reader.ReadUInt("bufferCount") > 0)
+			bool validChunk = chunkIndex < package->reader.GetChunkCount() && package->reader.GetChunk(chunkIndex).type == ResourcePackageChunkType::Data;
+			if (!uuid || !validChunk)
+			{
+				logger.Error("resource package table of contents has an invalid entry {}", pathId);
+				if (validChunk)
 				{
-					reader.BeginSeq("buffers");
+					chunks[chunkIndex].hasEagerEntries = true;
+				}
+				continue;
+			}
 
-					while (reader.NextSeqEntry())
+			chunks[chunkIndex].lazyEntries.Insert(static_cast<u32>(entryIndex));
+
+			RID              rid = GetID(uuid);
+			ResourceStorage* storage = GetOrAllocate(rid, uuid);
+			if (storage->instance.load() != nullptr)
+			{
+				continue;
+			}
+
+			//type is known before loading, so lazy resources are found by GetResourcesByType
+			if (storage->resourceType == nullptr)
+			{
+				SetResourceType(storage, Resources::FindTypeByName(typeName));
+			}
+
+			{
+				std::unique_lock lock(lazyMutex);
+				if (lazyResources.Insert(rid, LazyResource{package, static_cast<u32>(chunkIndex), static_cast<u32>(entryIndex), false, {}}).second)
+				{
+					lazyResourceCount.fetch_add(1, std::memory_order_release);
+					count++;
+				}
+			}
+
+			if (!pathId.Empty())
+			{
+				Resources::SetPath(rid, pathId);
+			}
+		}
+		reader.EndSeq();
+
+		return count;
+	}
+
+	static void LoadPackageEntry(const LazyResource& lazyResource)
+	{
+		Array<u8> chunkBuffer;
+		Span<u8>  chunk = lazyResource.package->reader.ReadChunk(lazyResource.chunk, chunkBuffer);
+		if (chunk.Empty())
+		{
+			logger.Error("resource package chunk {} is corrupted", lazyResource.chunk);
+			return;
+		}
+
+		BinaryArchiveReader reader{chunk};
+		if (!reader.BeginSeq("assets"))
+		{
+			return;
+		}
+
+		//skipping entries doesn't parse them
+		for (u32 i = 0; i <= lazyResource.entry; ++i)
+		{
+			if (!reader.NextSeqEntry())
+			{
+				logger.Error("resource package chunk {} has no entry {}", lazyResource.chunk, lazyResource.entry);
+				return;
+			}
+		}
+
+		if (RID rid = LoadPackageAsset(reader, lazyResource.package->bufferHandler))
+		{
+			CallResourceLoader(rid);
+		}
+		reader.EndSeq();
+	}
+
+	namespace
+	{
+		//true if the resource is being loaded by this thread, or by a thread waiting (directly or through other waiting threads)
+		//for a resource this thread is loading. lazyMutex must be locked.
+		bool IsLazyLoadingChain(RID rid)
+		{
+			std::thread::id thread = std::this_thread::get_id();
+
+			while (true)
+			{
+				auto it = lazyResources.Find(rid);
+				if (!it || !it->second.loading)
+				{
+					return false;
+				}
+
+				std::thread::id loadingThread = it->second.loadingThread;
+				if (loadingThread == thread)
+				{
+					return true;
+				}
+
+				const LazyWait* wait = nullptr;
+				for (const LazyWait& lazyWait : lazyWaits)
+				{
+					if (lazyWait.thread == loadingThread)
 					{
-						reader.BeginMap();
-						buffers.Emplace(reader.ReadString("id"), BufferInfo{
-							                .offset = reader.ReadUInt("offset"),
-							                .size = reader.ReadUInt("size")
-						                });
-						reader.EndSeq();
+						wait = &lazyWait;
+						break;
 					}
-					reader.EndSeq();
 				}
 
-				reader.EndMap();
+				if (wait == nullptr)
+				{
+					return false;
+				}
+				rid = wait->rid;
+			}
+		}
 
-				if (ResourceObject resourceObject = Read(rid))
+		void LoadLazyResource(RID rid)
+		{
+			LazyResource lazyResource;
+			{
+				std::unique_lock lock(lazyMutex);
+				auto             it = lazyResources.Find(rid);
+				if (!it)
 				{
-					resourceObject.IterateAllBuffers([&](const ResourceBuffer& buffer)
+					return;
+				}
+
+				if (it->second.loading)
+				{
+					//a thread reading the resource while loading it gets it partially loaded, other threads wait for it.
+					//waiting is skipped when the loading chain leads back to this thread (e.g. prototypes referencing each
+					//other loaded by two threads), the resource is returned partially loaded instead of deadlocking.
+					if (!IsLazyLoadingChain(rid))
 					{
-						if (auto it = buffers.Find(buffer.GetIdAsString()))
+						std::thread::id thread = std::this_thread::get_id();
+						lazyWaits.EmplaceBack(LazyWait{thread, rid});
+
+						lazyCondition.wait(lock, [rid]
 						{
-							buffer.MapFile(bufferHandler, true, it->second.offset, it->second.size);
-							logger.Debug("buffer {} loaded with offset {}, size {}  ", it->first, it->second.offset, it->second.size);
+							return !lazyResources.Has(rid);
+						});
+
+						for (usize i = 0; i < lazyWaits.Size(); ++i)
+						{
+							if (lazyWaits[i].thread == thread)
+							{
+								lazyWaits.RemoveAt(i);
+								break;
+							}
 						}
-					});
+					}
+					return;
+				}
+
+				it->second.loading = true;
+				it->second.loadingThread = std::this_thread::get_id();
+				lazyResource = it->second;
+			}
+
+			LoadPackageEntry(lazyResource);
+
+			{
+				std::unique_lock lock(lazyMutex);
+				lazyResources.Erase(rid);
+				lazyResourceCount.fetch_sub(1, std::memory_order_release);
+			}
+			lazyCondition.notify_all();
+		}
+	}
+
+	JobHandle Resources::LoadAsync(RID rid)
+	{
+		if (!rid || lazyResourceCount.load(std::memory_order_acquire) == 0)
+		{
+			return {};
+		}
+
+		{
+			std::unique_lock lock(lazyMutex);
+			auto             it = lazyResources.Find(rid);
+			if (!it || it->second.loading)
+			{
+				return {};
+			}
+		}
+
+		return JobSystem::Schedule([rid]
+		{
+			LoadLazyResource(rid);
+		});
+	}
+
+	JobHandle Resources::LoadAsync(StringView path)
+	{
+		RID rid = {};
+		{
+			std::unique_lock lock(byPathMutex);
+			if (auto it = byPath.Find(path))
+			{
+				rid = it->second;
+			}
+		}
+		return LoadAsync(rid);
+	}
+
+	RID Resources::LoadResources(StringView filePath, ResourceLoadMode mode)
+	{
+		LoadedPackage* loadedPackage = Alloc<LoadedPackage>();
+
+		const ResourcePackageReader& package = loadedPackage->reader;
+		if (!loadedPackage->reader.Open(filePath))
+		{
+			logger.Error("failed to open resource package {}", filePath);
+			DestroyAndFree(loadedPackage);
+			return {};
+		}
+
+		String bufferFile = Path::Join(Path::Parent(filePath), Path::Name(filePath) + SK_BUFFER_EXT);
+		FileHandler bufferHandler = FileSystem::OpenFile(bufferFile, AccessMode::ReadOnly);
+		if (bufferHandler)
+		{
+			fileHandlers.EmplaceBack(bufferHandler);
+		}
+		loadedPackage->bufferHandler = bufferHandler;
+
+		u32                       chunkCount = package.GetChunkCount();
+		Array<PackageChunkResult> results;
+		results.Resize(chunkCount);
+
+		Array<TableOfContentsChunk> tableOfContents;
+		tableOfContents.Resize(chunkCount);
+
+		u32 lazyCount = 0;
+		if (mode == ResourceLoadMode::Lazy)
+		{
+			lazyCount = RegisterTableOfContents(loadedPackage, tableOfContents);
+			logger.Debug("{} assets will be loaded on demand from {}", lazyCount, filePath);
+		}
+
+		Array<bool> skipChunks;
+		skipChunks.Resize(chunkCount, false);
+
+		for (u32 i = 0; i < chunkCount; ++i)
+		{
+			if (package.GetChunk(i).type != ResourcePackageChunkType::Data || (!tableOfContents[i].lazyEntries.Empty() && !tableOfContents[i].hasEagerEntries))
+			{
+				skipChunks[i] = true;
+			}
+		}
+
+		//chunks of a group are parsed in parallel, the loaders of a group run in export order before the next group is parsed
+		u32 begin = 0;
+		while (begin < chunkCount)
+		{
+			u32 end = begin + 1;
+			while (end < chunkCount && package.GetChunk(end).group == package.GetChunk(begin).group)
+			{
+				end++;
+			}
+
+			JobSystem::ParallelFor(end - begin, 1, [&](u32 index)
+			{
+				if (!skipChunks[begin + index])
+				{
+					LoadPackageChunk(package, begin + index, bufferHandler, tableOfContents[begin + index].lazyEntries, results[begin + index]);
 				}
+			});
 
-				if (ResourceStorage* storage = GetStorage(rid); storage != nullptr && storage->resourceType != nullptr)
+			for (u32 i = begin; i < end; ++i)
+			{
+				for (RID rid : results[i].assets)
 				{
-					if (const auto& it = resourceLoaders.Find(storage->resourceType->GetID()))
-					{
-						it->second.instance->LoadResource(rid);
-					}
+					CallResourceLoader(rid);
 				}
+			}
 
+			begin = end;
+		}
 
+		RID projectSettings = {};
+		for (const PackageChunkResult& result : results)
+		{
+			if (result.projectSettings)
+			{
+				projectSettings = result.projectSettings;
 			}
 		}
-		reader.EndSeq();
+
+		//lazy resources read from the package until shutdown
+		if (lazyCount > 0)
+		{
+			std::unique_lock lock(lazyMutex);
+			loadedPackages.EmplaceBack(loadedPackage);
+		}
+		else
+		{
+			DestroyAndFree(loadedPackage);
+		}
 
 		return projectSettings;
 	}
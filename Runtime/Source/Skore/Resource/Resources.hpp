@@ -6,6 +6,7 @@
 #include "ResourceCommon.hpp"
 #include "ResourceObject.hpp"
 #include "ResourceType.hpp"
+#include "Skore/Core/JobSystem.hpp"
 #include "Skore/Core/Serialization.hpp"
 #include "Skore/Core/UUID.hpp"
 #include "Skore/Core/StringView.hpp"
@@ -19,6 +20,7 @@ namespace Skore
 		String                                 name;
 		std::mutex                             mutex;
 		Array<std::unique_ptr<UndoRedoChange>> changes;
+		usize                                  memorySize = 0;
 
 		explicit UndoRedoScope(StringView name);
 		~UndoRedoScope();
@@ -27,6 +29,7 @@ namespace Skore
 		void       Undo();
 		void       Redo();
 		StringView GetName() const;
+		usize      GetMemorySize(); //bytes used by the stored field deltas
 		void       Destroy();
 
 		static UndoRedoScope* Create(StringView name = "");
@@ -88,6 +91,17 @@ namespace Skore
 		static bool             IsParentOf(RID parent, RID child);
 		static Array<RID>       GetResourcesByType(ResourceType* type);
 
+		//commits of the calling thread between begin and end bump versions once and send a single Changed event per resource,
+		//with the value before the first commit and after the last one. transactions can be nested.
+		//commits are staged: the calling thread reads its own staged values right away, other threads see none of them
+		//until the outermost EndTransaction publishes them together. a commit of another thread to the same resource in
+		//between is overwritten. destroy and reset are not staged, they discard a staged commit and apply right away.
+		static void BeginTransaction();
+		static void EndTransaction();
+
+		//callback runs with the type list locked, it must not create or destroy resources of the same type
+		static void IterateResourcesByType(ResourceType* type, FnRIDCallback callback, VoidPtr userData);
+
 		//path
 		static void       SetPath(RID rid, StringView path);
 		static StringView GetPath(RID rid);
@@ -112,7 +126,21 @@ namespace Skore
 			return Create(TypeInfo<T>::ID(), uuid, scope);
 		}
 
-		static RID  LoadResources(StringView filePath);
+		template <typename T>
+		static void IterateResourcesByType(ResourceType* type, T&& func)
+		{
+			IterateResourcesByType(type, [](RID rid, VoidPtr userData)
+			{
+				(*static_cast<Traits::RemoveAll<T>*>(userData))(rid);
+			}, &func);
+		}
+
+		static RID  LoadResources(StringView filePath, ResourceLoadMode mode = ResourceLoadMode::Eager);
+
+		//lazy loaded resources are loaded by Read, Write, HasValue, FindByUUID and FindByPath, LoadAsync loads them in a job instead.
+		//returns an empty handle if the resource is not waiting to be loaded.
+		static JobHandle LoadAsync(RID rid);
+		static JobHandle LoadAsync(StringView path);
 		static void GarbageCollect();
 		static void DispatchEvents();
 		static void EndFrame();
@@ -122,5 +150,7 @@ namespace Skore
 
 	private:
 		static ResourceType* CreateFromReflectType(ReflectType* reflectType);
+		static ResourceType* FindOrCreateFromReflectType(ReflectType* reflectType);
+		static void          AddType(ResourceType* resourceType);
 	};
 }
@@ -32,14 +32,26 @@ namespace Skore
 
 	void Component::RegisterEvents()
 	{
-		if (Tickable* tickable = dynamic_cast<Tickable*>(this))
+		if (m_registered) return;
+		m_registered = true;
+
+		ReflectType* type = GetType();
+
+		if (type && type->HasAttribute<ParallelTick>() && (dynamic_cast<Tickable*>(this) || dynamic_cast<FixedTickable*>(this)))
 		{
-			entity->m_scene->m_updateToAdd.Enqueue(tickable);
+			entity->m_scene->m_parallelTickToAdd.Enqueue(this);
 		}
-
-		if (FixedTickable* fixedTickable = dynamic_cast<FixedTickable*>(this))
+		else
 		{
-			entity->m_scene->m_fixedUpdateToAdd.Enqueue(fixedTickable);
+			if (Tickable* tickable = dynamic_cast<Tickable*>(this))
+			{
+				entity->m_scene->m_updateToAdd.Enqueue(tickable);
+			}
+
+			if (FixedTickable* fixedTickable = dynamic_cast<FixedTickable*>(this))
+			{
+				entity->m_scene->m_fixedUpdateToAdd.Enqueue(fixedTickable);
+			}
 		}
 
 		if (dynamic_cast<CollisionListener*>(this))
@@ -47,22 +59,37 @@ namespace Skore
 			entity->m_scene->physicsScene.RegisterCollisionCallbacks(entity);
 		}
 
-		if (ReflectType* type = GetType(); type && type->HasAttribute<Iterable>())
+		if (type && type->HasAttribute<Iterable>())
 		{
 			entity->m_scene->m_iterableComponents[type->GetProps().typeId].emplace(this);
 		}
+
+		entity->m_scene->OnQueryComponentAdded(this);
 	}
 
 	void Component::RemoveEvents()
 	{
-		if (Tickable* tickable = dynamic_cast<Tickable*>(this))
+		//components of deactivated entities were already removed
+		if (!m_registered) return;
+		m_registered = false;
+
+		ReflectType* type = GetType();
+
+		if (type && type->HasAttribute<ParallelTick>() && (dynamic_cast<Tickable*>(this) || dynamic_cast<FixedTickable*>(this)))
 		{
-			entity->m_scene->m_updateToRemove.Enqueue(tickable);
+			entity->m_scene->m_parallelTickToRemove.Enqueue(this);
 		}
-
-		if (FixedTickable* fixedTickable = dynamic_cast<FixedTickable*>(this))
+		else
 		{
-			entity->m_scene->m_fixedUpdateToRemove.Enqueue(fixedTickable);
+			if (Tickable* tickable = dynamic_cast<Tickable*>(this))
+			{
+				entity->m_scene->m_updateToRemove.Enqueue(tickable);
+			}
+
+			if (FixedTickable* fixedTickable = dynamic_cast<FixedTickable*>(this))
+			{
+				entity->m_scene->m_fixedUpdateToRemove.Enqueue(fixedTickable);
+			}
 		}
 
 		if (dynamic_cast<CollisionListener*>(this))
@@ -83,13 +110,15 @@ namespace Skore
 			}
 		}
 
-		if (ReflectType* type = GetType(); type && type->HasAttribute<Iterable>())
+		if (type && type->HasAttribute<Iterable>())
 		{
 			if (auto it = entity->m_scene->m_iterableComponents.Find(type->GetProps().typeId))
 			{
 				it->second.erase(this);
 			}
 		}
+
+		entity->m_scene->OnQueryComponentRemoved(this);
 	}
 
 	ComponentProxy::ComponentProxy(ReflectType* type, VoidPtr instance, VoidPtr api) : m_type(type), m_instance(instance), m_api(static_cast<ComponentProxyApi*>(api))
@@ -9,6 +9,7 @@ namespace Skore
 	class Scene;
 	class Entity;
 	class PhysicsScene;
+	class ComponentStorage;
 
 	using EmptyFp = void(*)(VoidPtr instance);
 	using EventFp = void(*)(VoidPtr instance, const EntityEventDesc& event);
@@ -54,6 +55,10 @@ namespace Skore
 		RID m_rid;
 		u32 m_typeVersion = 0;
 
+		ComponentStorage* m_storage = nullptr;
+
+		bool m_registered = false; //between RegisterEvents and RemoveEvents, only registered components match queries
+
 		void RegisterEvents();
 		void RemoveEvents();
 	};
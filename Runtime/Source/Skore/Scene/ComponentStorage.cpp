@@ -0,0 +1,161 @@
+#include "Skore/Scene/ComponentStorage.hpp"
+
+namespace Skore
+{
+	namespace
+	{
+		VoidPtr StorageAlloc(VoidPtr allocator, usize bytes)
+		{
+			ComponentStorage* storage = static_cast<ComponentStorage*>(allocator);
+			SK_ASSERT(bytes <= storage->GetComponentSize(), "component doesn't fit in the storage slot");
+			return storage->Allocate();
+		}
+
+		void StorageFree(VoidPtr allocator, VoidPtr ptr)
+		{
+			static_cast<ComponentStorage*>(allocator)->Free(ptr);
+		}
+
+		VoidPtr StorageRealloc(VoidPtr allocator, VoidPtr ptr, usize newSize)
+		{
+			SK_ASSERT(false, "components can't be reallocated");
+			return nullptr;
+		}
+	}
+
+	ComponentStorage::ComponentStorage(usize componentSize, usize alignment)
+	{
+		SK_ASSERT(alignment <= MaxAlignment, "chunks are only aligned to MaxAlignment");
+		alignment = MaxAlignment;
+		m_stride = (componentSize + alignment - 1) & ~(alignment - 1);
+
+		m_allocator.allocator = this;
+		m_allocator.MemAlloc = StorageAlloc;
+		m_allocator.MemFree = StorageFree;
+		m_allocator.MemRealloc = StorageRealloc;
+	}
+
+	ComponentStorage::~ComponentStorage()
+	{
+		SK_ASSERT(m_count == 0 || m_releasing, "component storage destroyed with live components");
+		for (Chunk& chunk : m_chunks)
+		{
+			MemFree(chunk.data);
+		}
+	}
+
+	VoidPtr ComponentStorage::Allocate()
+	{
+		if (m_freeChunks.Empty())
+		{
+			Chunk chunk = {static_cast<u8*>(MemAlloc(m_stride * ChunkCapacity)), 0};
+
+			usize index = 0;
+			while (index < m_chunks.Size() && m_chunks[index].data < chunk.data)
+			{
+				index++;
+			}
+			m_chunks.Insert(m_chunks.begin() + index, chunk);
+
+			//indexes after the new chunk were shifted
+			for (u32& freeChunk : m_freeChunks)
+			{
+				if (freeChunk >= index) freeChunk++;
+			}
+			m_freeChunks.EmplaceBack(static_cast<u32>(index));
+		}
+
+		u32    chunkIndex = m_freeChunks.Back();
+		Chunk& chunk = m_chunks[chunkIndex];
+
+		u32 slot = 0;
+		while (chunk.occupied & (1ull << slot))
+		{
+			slot++;
+		}
+
+		chunk.occupied |= 1ull << slot;
+		if (chunk.occupied == U64_MAX)
+		{
+			m_freeChunks.PopBack();
+		}
+
+		m_count++;
+		return chunk.data + slot * m_stride;
+	}
+
+	void ComponentStorage::Free(VoidPtr ptr)
+	{
+		if (ptr == nullptr || m_releasing) return;
+
+		usize chunkIndex = FindChunk(ptr);
+		SK_ASSERT(chunkIndex != U64_MAX, "pointer doesn't belong to this storage");
+
+		Chunk& chunk = m_chunks[chunkIndex];
+		u32    slot = static_cast<u32>((static_cast<u8*>(ptr) - chunk.data) / m_stride);
+
+		if (chunk.occupied == U64_MAX)
+		{
+			m_freeChunks.EmplaceBack(static_cast<u32>(chunkIndex));
+		}
+
+		chunk.occupied &= ~(1ull << slot);
+		m_count--;
+	}
+
+	bool ComponentStorage::Owns(VoidPtr ptr) const
+	{
+		return FindChunk(ptr) != U64_MAX;
+	}
+
+	void ComponentStorage::BeginRelease()
+	{
+		m_releasing = true;
+	}
+
+	Allocator* ComponentStorage::GetAllocator()
+	{
+		return &m_allocator;
+	}
+
+	usize ComponentStorage::GetComponentSize() const
+	{
+		return m_stride;
+	}
+
+	usize ComponentStorage::GetCount() const
+	{
+		return m_count;
+	}
+
+	usize ComponentStorage::GetChunkCount() const
+	{
+		return m_chunks.Size();
+	}
+
+	usize ComponentStorage::FindChunk(VoidPtr ptr) const
+	{
+		const u8* address = static_cast<const u8*>(ptr);
+
+		usize first = 0;
+		usize last = m_chunks.Size();
+		while (first < last)
+		{
+			usize middle = first + (last - first) / 2;
+			const Chunk& chunk = m_chunks[middle];
+			if (address < chunk.data)
+			{
+				last = middle;
+			}
+			else if (address >= chunk.data + m_stride * ChunkCapacity)
+			{
+				first = middle + 1;
+			}
+			else
+			{
+				return middle;
+			}
+		}
+		return U64_MAX;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Skore/Common.hpp"
+#include "Skore/Core/Allocator.hpp"
+#include "Skore/Core/Array.hpp"
+
+namespace Skore
+{
+	// Keeps objects of one size packed in fixed-size chunks. Freed slots are reused before a new chunk is allocated.
+	// Scenes use one storage per component type and one for entities.
+	// GetAllocator can be passed to ReflectType::NewObject, memory returned to it goes back to the storage.
+	class SK_API ComponentStorage
+	{
+	public:
+		SK_NO_COPY_CONSTRUCTOR(ComponentStorage);
+
+		static constexpr u32   ChunkCapacity = 64;
+		static constexpr usize MaxAlignment = 16;
+
+		ComponentStorage(usize componentSize, usize alignment);
+		~ComponentStorage();
+
+		VoidPtr Allocate();
+		void    Free(VoidPtr ptr);
+		bool    Owns(VoidPtr ptr) const;
+
+		// after BeginRelease, Free doesn't track slots anymore and all chunks are released together in the destructor.
+		void BeginRelease();
+
+		Allocator* GetAllocator();
+
+		usize GetComponentSize() const;
+		usize GetCount() const;
+		usize GetChunkCount() const;
+
+	private:
+		struct Chunk
+		{
+			u8* data;
+			u64 occupied;
+		};
+
+		usize        m_stride = 0;
+		usize        m_count = 0;
+		bool         m_releasing = false;
+		Array<Chunk> m_chunks;    //sorted by address
+		Array<u32>   m_freeChunks; //chunks with at least one free slot
+		Allocator    m_allocator{};
+
+		usize FindChunk(VoidPtr ptr) const;
+	};
+}
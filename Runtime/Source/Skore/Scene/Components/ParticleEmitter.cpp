@@ -12,7 +12,7 @@ namespace Skore
 {
 	void ParticleEmitter::EnsureGPUResources()
 	{
-		if (m_particleBuffer) return;
+		if (m_particleBuffer || Graphics::GetDevice() == nullptr) return;
 
 		m_particleBuffer = Graphics::CreateBuffer(BufferDesc{
 			.size = m_maxParticles * sizeof(GPUParticle),
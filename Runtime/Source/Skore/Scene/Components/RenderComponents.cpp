@@ -22,6 +22,7 @@ namespace Skore
 	{
 		renderable = scene->renderObjects.CreateRenderable();
 		PushStateToRenderable();
+		scene->spatialIndex.AddEntity(entity);
 	}
 
 	void RendererComponent::OnDestroy()
@@ -29,6 +30,7 @@ namespace Skore
 		if (renderable)
 		{
 			scene->renderObjects.DestroyRenderable(renderable);
+			scene->spatialIndex.RemoveEntity(entity);
 			renderable = {};
 		}
 	}
@@ -207,6 +209,8 @@ namespace Skore
 
 	void SkinnedMeshRenderer::EnsureBonesData()
 	{
+		if (Graphics::GetDevice() == nullptr) return;
+
 		if (m_bonesBuffers[0] == nullptr)
 		{
 			for (GPUBuffer*& buffer : m_bonesBuffers)
@@ -20,6 +20,30 @@ namespace Skore
 
 	void Transform::UpdateTransform(u32 flags)
 	{
+		if (scene->IsDeferredTransformUpdates())
+		{
+			m_pendingFlags |= flags;
+			if (!scene->physicsScene.IsWritingBackTransforms())
+			{
+				m_pendingPhysicsSync = true;
+			}
+
+			if (!m_transformDirty)
+			{
+				m_transformDirty = true;
+				if (scene->m_parallelTicking)
+				{
+					std::lock_guard<std::mutex> lock(scene->m_dirtyTransformsMutex);
+					scene->m_dirtyTransforms.EmplaceBack(this);
+				}
+				else
+				{
+					scene->m_dirtyTransforms.EmplaceBack(this);
+				}
+			}
+			return;
+		}
+
 		entity->SetWorldTransform(GetParentWorldTransform() * GetLocalTransform());
 
 		EntityEventDesc desc;
@@ -47,7 +71,7 @@ namespace Skore
 		}
 		else if (event.type == EntityEventType::TransformUpdated)
 		{
-			if (entity->HasFlag(EntityFlags::HasPhysics))
+			if (entity->HasFlag(EntityFlags::HasPhysics) && !(event.flags & UpdateTransform_SkipPhysicsSync))
 			{
 				if (UpdateTransform_Scale & event.flags)
 				{
@@ -61,6 +85,15 @@ namespace Skore
 		}
 	}
 
+	void Transform::OnDestroy()
+	{
+		if (m_transformDirty)
+		{
+			scene->m_dirtyTransforms.Remove(this);
+			m_transformDirty = false;
+		}
+	}
+
 	void Transform::RegisterType(NativeReflectType<Transform>& type)
 	{
 		type.Field<&Transform::m_position, &Transform::GetPosition, &Transform::SetPosition>("position");
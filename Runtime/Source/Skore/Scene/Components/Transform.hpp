@@ -24,6 +24,9 @@ namespace Skore
 			UpdateTransform_Rotation = 1 << 1,
 			UpdateTransform_Scale    = 1 << 2,
 			UpdateTransform_All      = UpdateTransform_Position | UpdateTransform_Rotation | UpdateTransform_Scale,
+
+			//set on coalesced updates that only came from physics write back, the bodies already have this transform
+			UpdateTransform_SkipPhysicsSync = 1 << 3,
 		};
 
 		enum
@@ -121,15 +124,23 @@ namespace Skore
 		const Mat4& GetParentWorldTransform() const;
 
 		void ProcessEvent(const EntityEventDesc& event) override;
+		void OnDestroy() override;
 
 		static void RegisterType(NativeReflectType<Transform>& type);
 
+		friend class Scene;
+
 	private:
 		Vec3 m_position{0, 0, 0};
 		Quat m_rotation{0, 0, 0, 1};
 		Vec3 m_scale{1, 1, 1};
 		EntityMobility m_mobility = EntityMobility::Static;
 
+		//deferred mode state, see Scene::SetDeferredTransformUpdates
+		u32  m_pendingFlags = 0;
+		bool m_transformDirty = false;
+		bool m_pendingPhysicsSync = false;
+
 		void UpdateTransform(u32 flags);
 	};
 
@@ -4,6 +4,7 @@
 #include "Skore/Scene/Scene.hpp"
 #include "Skore/Scene/SceneCommon.hpp"
 #include "Skore/Scene/SceneManager.hpp"
+#include "Skore/Scene/Components/Transform.hpp"
 #include "Skore/Core/Logger.hpp"
 #include "Skore/Core/Reflection.hpp"
 #include "Skore/Resource/Resources.hpp"
@@ -71,8 +72,7 @@ namespace Skore
 
 		if (entity == nullptr)
 		{
-			entity = static_cast<Entity*>(MemAlloc(sizeof(Entity)));
-			new(PlaceHolder{}, entity) Entity();
+			entity = scene->AllocateEntity();
 		}
 
 		Instantiate(entity, scene, parent, rid, instanceOfAsset);
@@ -142,6 +142,117 @@ namespace Skore
 		entity->m_scene->m_queueToStart.Enqueue(entity);
 	}
 
+	Array<Entity*> Entity::InstantiateBatch(RID rid, u32 count, Span<Mat4> transforms)
+	{
+		return InstantiateBatch(nullptr, rid, count, transforms);
+	}
+
+	Array<Entity*> Entity::InstantiateBatch(Entity* parent, RID rid, u32 count, Span<Mat4> transforms)
+	{
+		Array<Entity*> roots;
+
+		Scene* scene = parent ? parent->m_scene : SceneManager::GetActiveScene();
+		SK_ASSERT(scene, "Scene cannot be null");
+		if (scene == nullptr || !rid || count == 0)
+		{
+			return roots;
+		}
+
+		//the first root is allocated before the template so component entity references can be resolved on the scene
+		Entity* first = scene->AllocateEntity();
+		first->m_scene = scene;
+
+		Scene::PrefabTemplate* prefabTemplate = scene->FindOrCreatePrefabTemplate(rid, first);
+		if (prefabTemplate->nodes.Empty())
+		{
+			first->DestroyInternal(false);
+			return roots;
+		}
+
+		roots.Reserve(count);
+
+		if (parent)
+		{
+			parent->m_children.Reserve(parent->m_children.Size() + count);
+		}
+		else
+		{
+			scene->entities.Reserve(scene->entities.Size() + count);
+		}
+
+		Array<Entity*> nodes;
+		nodes.Resize(prefabTemplate->nodes.Size());
+
+		for (u32 i = 0; i < count; ++i)
+		{
+			for (u32 n = 0; n < nodes.Size(); ++n)
+			{
+				const Scene::PrefabNode& node = prefabTemplate->nodes[n];
+
+				Entity* entity = i == 0 && n == 0 ? first : scene->AllocateEntity();
+				entity->m_scene = scene;
+				entity->m_parent = node.parent != U32_MAX ? nodes[node.parent] : parent;
+				entity->m_name = node.name;
+				entity->m_layer = node.layer;
+
+				if (entity->m_parent)
+				{
+					entity->m_parentActive = entity->m_parent->IsActive();
+				}
+
+				entity->m_components.Reserve(node.componentCount);
+				entity->m_children.Reserve(node.childCount);
+
+				for (u32 c = node.firstComponent; c < node.firstComponent + node.componentCount; ++c)
+				{
+					const Scene::PrefabComponent& component = prefabTemplate->components[c];
+					entity->AddComponentCopy(component.reflectType, component.prototype);
+				}
+
+				if (node.parent != U32_MAX)
+				{
+					entity->m_parent->m_children.EmplaceBack(entity);
+				}
+
+				nodes[n] = entity;
+			}
+
+			//children are activated and queued before their parents, same as Instantiate
+			for (u32 n = nodes.Size(); n > 0; --n)
+			{
+				nodes[n - 1]->SetActive(!prefabTemplate->nodes[n - 1].deactivated);
+				scene->m_queueToStart.Enqueue(nodes[n - 1]);
+			}
+
+			Entity* root = nodes[0];
+
+			if (i < transforms.Size())
+			{
+				if (Transform* transform = root->GetComponent<Transform>())
+				{
+					Vec3 position;
+					Vec3 rotation;
+					Vec3 scale;
+					Mat4::Decompose(transforms[i], position, rotation, scale);
+					transform->SetTransform(position, Quat(rotation), scale);
+				}
+			}
+
+			if (parent)
+			{
+				parent->m_children.EmplaceBack(root);
+			}
+			else
+			{
+				scene->entities.EmplaceBack(root);
+			}
+
+			roots.EmplaceBack(root);
+		}
+
+		return roots;
+	}
+
 	Scene* Entity::GetScene() const
 	{
 		return m_scene;
@@ -319,10 +430,8 @@ namespace Skore
 	Component* Entity::AddComponent(ReflectType* reflectType, RID rid)
 	{
 		if (!reflectType) return nullptr;
-		ReflectConstructor* constructor = reflectType->GetDefaultConstructor();
-		if (constructor == nullptr) return nullptr;
-
-		Component* component = constructor->NewObject(MemoryGlobals::GetDefaultAllocator(), nullptr)->SafeCast<Component>();
+		Component* component = m_scene->AllocateComponent(reflectType);
+		if (component == nullptr) return nullptr;
 
 		component->entity = this;
 		component->scene = m_scene;
@@ -356,6 +465,30 @@ namespace Skore
 		return component;
 	}
 
+	Component* Entity::AddComponentCopy(ReflectType* reflectType, const Component* prototype)
+	{
+		Component* component = m_scene->AllocateComponent(reflectType);
+		if (component == nullptr) return nullptr;
+
+		component->entity = this;
+		component->scene = m_scene;
+		component->m_typeVersion = reflectType->GetVersion();
+
+		reflectType->DeepCopy(prototype, component);
+
+		component->OnCreate();
+		component->RegisterEvents();
+
+		m_components.EmplaceBack(component);
+
+		if (m_started)
+		{
+			m_scene->m_componentsToStart.Enqueue(component);
+		}
+
+		return component;
+	}
+
 	Component* Entity::GetComponent(TypeID typeId) const
 	{
 		for (int i = 0; i < m_components.Size(); ++i)
@@ -484,7 +617,8 @@ namespace Skore
 		if (m_scene)
 		{
 
-			if (!m_name.Empty())
+			//lookups are cleared at once when the scene is destroyed
+			if (!m_name.Empty() && !m_scene->m_destroying)
 			{
 				m_scene->entitiesByName[m_name].Remove(this);
 			}
@@ -493,13 +627,23 @@ namespace Skore
 			{
 				if (m_rid)
 				{
-					m_scene->entitiesByRID.Erase(m_rid);
+					if (!m_scene->m_destroying)
+					{
+						m_scene->entitiesByRID.Erase(m_rid);
+					}
 					Resources::GetStorage(m_rid)->UnregisterEvent(ResourceEventType::Changed, OnEntityResourceChange, this);
 				}
 			}
 		}
 
-		DestroyAndFree(this);
+		if (m_storage)
+		{
+			m_storage->GetAllocator()->DestroyAndFree(this);
+		}
+		else
+		{
+			DestroyAndFree(this);
+		}
 	}
 
 	void Entity::DoStart(bool executeComponentUpdates)
@@ -535,7 +679,7 @@ namespace Skore
 		{
 			Resources::GetStorage(component->m_rid)->UnregisterEvent(ResourceEventType::VersionUpdated, OnComponentResourceChange, component);
 		}
-		DestroyAndFree(component);
+		m_scene->FreeComponent(component);
 	}
 
 	void Entity::OnEntityResourceChange(ResourceObject& oldValue, ResourceObject& newValue, VoidPtr userData)
@@ -681,9 +825,10 @@ namespace Skore
 			ReflectType* reflectType = component->GetType();
 			if (component->m_typeVersion < reflectType->GetVersion())
 			{
+				bool registered = component->m_registered;
 				component->RemoveEvents();
 
-				Component* newComponent = reflectType->NewObject()->SafeCast<Component>();
+				Component* newComponent = m_scene->AllocateComponent(reflectType);
 				newComponent->entity = this;
 				newComponent->scene = m_scene;
 				newComponent->m_typeVersion = reflectType->GetVersion();
@@ -693,9 +838,12 @@ namespace Skore
 
 				m_components[i] = newComponent;
 
-				DestroyAndFree(component);
+				m_scene->FreeComponent(component);
 
-				newComponent->RegisterEvents();
+				if (registered)
+				{
+					newComponent->RegisterEvents();
+				}
 			}
 		}
 
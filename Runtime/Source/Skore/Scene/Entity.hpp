@@ -8,6 +8,7 @@ namespace Skore
 {
 	class Component;
 	class Scene;
+	class ComponentStorage;
 
 	class SK_API Entity final : public Object
 	{
@@ -92,6 +93,11 @@ namespace Skore
 		static Entity* Instantiate(Entity* parent);
 		static Entity* Instantiate(Entity* parent, RID rid);
 
+		//creates count copies of the entity resource from a cached plan, without resource links.
+		//transforms[i] is applied to the Transform of the root i, extra roots keep the prefab transform.
+		static Array<Entity*> InstantiateBatch(RID rid, u32 count, Span<Mat4> transforms = {});
+		static Array<Entity*> InstantiateBatch(Entity* parent, RID rid, u32 count, Span<Mat4> transforms = {});
+
 		static void RegisterType(NativeReflectType<Entity>& type);
 
 		friend class Scene;
@@ -120,7 +126,8 @@ namespace Skore
 		bool m_started = false;
 		bool m_destroyRequested = false;
 
-		Scene*         m_scene = nullptr;
+		Scene*            m_scene = nullptr;
+		ComponentStorage* m_storage = nullptr;
 		Entity*        m_parent = nullptr;
 		Array<Entity*> m_children;
 
@@ -129,6 +136,8 @@ namespace Skore
 
 		void DestroyInternal(bool removeFromParent = true);
 
+		Component* AddComponentCopy(ReflectType* reflectType, const Component* prototype);
+
 		void DoStart(bool executeComponentUpdates);
 		void DestroyComponent(Component* component) const;
 		void ReflectionReload();
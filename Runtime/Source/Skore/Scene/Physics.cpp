@@ -4,7 +4,8 @@
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
@@ -23,7 +24,9 @@
 #include <Jolt/Physics/Body/BodyFilter.h>
 #include "Jolt/Renderer/DebugRenderer.h"
 
+#include <atomic>
 #include <concurrentqueue.h>
+#include <functional>
 #include <mutex>
 
 #include "Skore/Scene/Component.hpp"
@@ -38,6 +41,7 @@
 #include "Skore/Events.hpp"
 #include "Skore/Profiler.hpp"
 #include "Skore/Core/Event.hpp"
+#include "Skore/Core/JobSystem.hpp"
 #include "Skore/Core/Logger.hpp"
 #include "Skore/Core/Math.hpp"
 #include "Skore/Core/Queue.hpp"
@@ -53,6 +57,7 @@ namespace Skore
 	static u32           maxBodyPairs = 65536;
 	static u32           maxContactConstraints = 10240;
 	static u32           physicsTicksPerSeconds = 75;
+	static bool          asyncSimulation = false;
 	static PhysicsScene* currentPhysicsScene = nullptr;
 	static u64           collisionMatrix[MaxLayers];
 
@@ -323,6 +328,35 @@ namespace Skore
 		u64 m_layerMask;
 	};
 
+	struct RayCastHitResult
+	{
+		JPH::BodyID     bodyID;
+		JPH::SubShapeID subShapeID;
+		f32             fraction;
+	};
+
+	//collects all hits of a ray in frame allocated memory, instead of a heap array per query
+	class FrameRayCastCollector : public JPH::CastRayCollector
+	{
+	public:
+		FrameRayCastCollector() : hits(MemoryGlobals::GetFrameAllocator()) {}
+
+		void AddHit(const JPH::RayCastResult& inResult) override
+		{
+			hits.EmplaceBack(RayCastHitResult{inResult.mBodyID, inResult.mSubShapeID2, inResult.mFraction});
+		}
+
+		void Sort()
+		{
+			JPH::QuickSort(hits.begin(), hits.end(), [](const RayCastHitResult& left, const RayCastHitResult& right)
+			{
+				return left.fraction < right.fraction;
+			});
+		}
+
+		Array<RayCastHitResult> hits;
+	};
+
 	struct ContactPairInfo
 	{
 		Entity* entity1 = nullptr;
@@ -463,6 +497,101 @@ namespace Skore
 		}
 	};
 
+	// Runs Jolt jobs on the engine job system instead of a separate thread pool.
+	class PhysicsJobSystem final : public JPH::JobSystemWithBarrier
+	{
+	public:
+		PhysicsJobSystem() : JobSystemWithBarrier(JPH::cMaxPhysicsBarriers)
+		{
+			jobs.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsJobs);
+		}
+
+		~PhysicsJobSystem() override
+		{
+			// queued wrappers release their job reference after the barrier is already done
+			while (inFlight.load(std::memory_order_acquire) > 0)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		int GetMaxConcurrency() const override
+		{
+			return static_cast<int>(Skore::JobSystem::GetWorkerCount()) + 1;
+		}
+
+		JobHandle CreateJob(const char* name, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 numDependencies) override
+		{
+			JPH::uint32 index;
+			while ((index = jobs.ConstructObject(name, color, this, jobFunction, numDependencies)) == AvailableJobs::cInvalidObjectIndex)
+			{
+				std::this_thread::yield();
+			}
+
+			Job*      job = &jobs.Get(index);
+			JobHandle handle(job);
+			if (numDependencies == 0)
+			{
+				QueueJob(job);
+			}
+			return handle;
+		}
+
+	protected:
+		void QueueJob(Job* job) override
+		{
+			job->AddRef();
+			inFlight.fetch_add(1, std::memory_order_acq_rel);
+			Skore::JobSystem::Schedule([this, job]
+			{
+				job->Execute();
+				job->Release();
+				inFlight.fetch_sub(1, std::memory_order_acq_rel);
+			});
+		}
+
+		void QueueJobs(Job** jobsToQueue, JPH::uint numJobs) override
+		{
+			for (JPH::uint i = 0; i < numJobs; ++i)
+			{
+				QueueJob(jobsToQueue[i]);
+			}
+		}
+
+		void FreeJob(Job* job) override
+		{
+			jobs.DestructObject(job);
+		}
+
+	private:
+		using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+		AvailableJobs    jobs;
+		std::atomic<u32> inFlight{0};
+	};
+
+	enum class PhysicsCommandType : u8
+	{
+		UpdateTransform,
+		SetLinearVelocity,
+		SetAngularVelocity,
+		AddForce,
+		AddForceAtPosition,
+		AddImpulse,
+		AddImpulseAtPosition,
+		AddTorque,
+		AddAngularImpulse,
+		RegisterCollisionCallbacks,
+		UnregisterCollisionCallbacks
+	};
+
+	struct PhysicsCommand
+	{
+		PhysicsCommandType type;
+		Entity*            entity = nullptr;
+		Vec3               value{};
+		Vec3               position{};
+	};
+
 	struct CharacterContactInfo
 	{
 		JPH::BodyID bodyId;
@@ -480,7 +609,7 @@ namespace Skore
 		ObjectVsBroadPhaseLayerFilterImpl objectVsBroadPhaseLayerFilterImpl = {};
 		ObjectLayerPairFilterImpl         objectLayerPairFilterImpl = {};
 
-		JPH::JobSystemThreadPool        jobSystem = JPH::JobSystemThreadPool(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+		PhysicsJobSystem                jobSystem{};
 		HashSet<JPH::CharacterVirtual*> virtualCharacters;
 		Queue<Entity*> requireUpdate;
 
@@ -498,8 +627,30 @@ namespace Skore
 
 		// Guard against circular feedback during physics writeback
 		bool writingBackTransforms = false;
+
+		// Async step, commands issued while stepping are applied on sync
+		// stepping is read by ParallelTick workers buffering commands
+		bool                         asyncStep = false;
+		std::atomic_bool             stepping = false;
+		JobHandle                    stepJob{};
+		std::mutex                   commandMutex;
+		Array<PhysicsCommand>        commands;
+		Array<std::function<void()>> afterStep;
 	};
 
+	static bool BufferCommand(PhysicsScene::Context* context, PhysicsCommandType type, Entity* entity, const Vec3& value = {}, const Vec3& position = {})
+	{
+		if (!context->stepping) return false;
+
+		std::lock_guard<std::mutex> lock(context->commandMutex);
+
+		//the step can be synced between the check and the lock
+		if (!context->stepping) return false;
+
+		context->commands.EmplaceBack(PhysicsCommand{type, entity, value, position});
+		return true;
+	}
+
 	RID physicsSettingsRID = {};
 
 	void OnPhysicsSettingsLoaded();
@@ -534,6 +685,8 @@ namespace Skore
 				maxContactConstraints = static_cast<u32>(settings.GetUInt(PhysicsSettings::MaxContactConstraints));
 			if (settings.HasValue(PhysicsSettings::PhysicsTicksPerSeconds))
 				physicsTicksPerSeconds = static_cast<u32>(settings.GetUInt(PhysicsSettings::PhysicsTicksPerSeconds));
+			if (settings.HasValue(PhysicsSettings::AsyncSimulation))
+				asyncSimulation = settings.GetBool(PhysicsSettings::AsyncSimulation);
 
 			settings.IterateSubObjectList(PhysicsSettings::CollisionMatrix, [&](RID itemRID)
 			{
@@ -549,7 +702,7 @@ namespace Skore
 		}
 	}
 
-	void PhysicsInit()
+	void SK_API PhysicsInit()
 	{
 		JPH::RegisterDefaultAllocator();
 		JPH::Factory::sInstance = new JPH::Factory();
@@ -562,7 +715,7 @@ namespace Skore
 		debugRenderer = new JoltDebugRenderer();
 	}
 
-	void PhysicsShutdown()
+	void SK_API PhysicsShutdown()
 	{
 		Event::Unbind<OnSettingsLoaded, &OnPhysicsSettingsLoaded>();
 
@@ -587,6 +740,7 @@ namespace Skore
 		}
 
 		context->stepSize = 1.0f / (f32)physicsTicksPerSeconds;
+		context->asyncStep = asyncSimulation;
 
 		context->physicsSystem.Init(
 			maxBodies,
@@ -608,6 +762,7 @@ namespace Skore
 	{
 		if (context)
 		{
+			WaitStep();
 			DestroyAndFree(context);
 		}
 	}
@@ -657,6 +812,8 @@ namespace Skore
 		if (!shape || !shape->ref) return JPH::BodyID::cInvalidBodyID;
 		if (!context) return JPH::BodyID::cInvalidBodyID;
 
+		WaitStep();
+
 		JPH::BodyCreationSettings settings(shape->ref, Cast(position), Cast(rotation), JPH::EMotionType::Static, PhysicsLayers::Encode(layer, false));
 		settings.mUserData = 0;
 
@@ -676,6 +833,8 @@ namespace Skore
 		JPH::BodyID id(bodyHandle);
 		if (id.IsInvalid()) return;
 
+		WaitStep();
+
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 		auto&               pending       = context->pendingBodiesToAdd;
 		auto                it            = std::find(pending.begin(), pending.end(), id);
@@ -694,6 +853,8 @@ namespace Skore
 	{
 		entity->m_physicsUpdatedFrame = App::Frame();
 
+		WaitStep();
+
 		static ShapeCollector collector;
 		collector.shapes.Clear();
 
@@ -892,6 +1053,21 @@ namespace Skore
 	{
 		if (entity->m_physicsId != U64_MAX)
 		{
+			WaitStep();
+
+			// buffered commands can't outlive the body
+			if (context->stepping)
+			{
+				std::lock_guard<std::mutex> lock(context->commandMutex);
+				for (usize i = context->commands.Size(); i > 0; --i)
+				{
+					if (context->commands[i - 1].entity == entity)
+					{
+						context->commands.RemoveAt(i - 1);
+					}
+				}
+			}
+
 			// Clean up any active contacts involving this entity before removing the body
 			// This prevents stale entity pointers in OnContactRemoved
 			{
@@ -949,9 +1125,15 @@ namespace Skore
 		}
 	}
 
+	bool PhysicsScene::IsWritingBackTransforms() const
+	{
+		return context && context->writingBackTransforms;
+	}
+
 	void PhysicsScene::UpdateTransform(Entity* entity)
 	{
 		if (entity->m_physicsId == U64_MAX || context->writingBackTransforms) return;
+		if (BufferCommand(context, PhysicsCommandType::UpdateTransform, entity)) return;
 
 		const Mat4& worldTransform = entity->GetWorldTransform();
 		if (entity->HasFlag(EntityFlags::HasCharacterController))
@@ -973,6 +1155,8 @@ namespace Skore
 	{
 		if (!context) return;
 
+		WaitStep();
+
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 
 		debugRenderer->cmd = cmd;
@@ -1004,6 +1188,8 @@ namespace Skore
 		if (!context) return;
 		if (entity->m_physicsId == U64_MAX) return;
 
+		WaitStep();
+
 		debugRenderer->cmd = cmd;
 		debugRenderer->pipeline = pipeline;
 
@@ -1042,6 +1228,8 @@ namespace Skore
 
 	void PhysicsScene::UpdateCharacterControllers()
 	{
+		if (!context) return;
+
 		SK_SCOPED_CPU_ZONE("Physics - UpdateCharacterControllers");
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
@@ -1217,8 +1405,124 @@ namespace Skore
 			&context->jobSystem);
 	}
 
+	void PhysicsScene::BeginFixedUpdate(f32 stepSize)
+	{
+		context->stepping = true;
+		context->stepJob = JobSystem::Schedule([this, stepSize]
+		{
+			DoFixedUpdate(stepSize);
+		});
+	}
+
+	bool PhysicsScene::SyncStep()
+	{
+		if (!context || !context->stepping) return false;
+
+		SK_SCOPED_CPU_ZONE("Physics - SyncStep");
+
+		JobSystem::Wait(context->stepJob);
+		context->stepJob = {};
+		{
+			std::lock_guard<std::mutex> lock(context->commandMutex);
+			context->stepping = false;
+		}
+
+		for (const PhysicsCommand& command : context->commands)
+		{
+			switch (command.type)
+			{
+				case PhysicsCommandType::UpdateTransform:
+					UpdateTransform(command.entity);
+					break;
+				case PhysicsCommandType::SetLinearVelocity:
+					SetLinearVelocity(command.entity, command.value);
+					break;
+				case PhysicsCommandType::SetAngularVelocity:
+					SetAngularVelocity(command.entity, command.value);
+					break;
+				case PhysicsCommandType::AddForce:
+					AddForce(command.entity, command.value);
+					break;
+				case PhysicsCommandType::AddForceAtPosition:
+					AddForceAtPosition(command.entity, command.value, command.position);
+					break;
+				case PhysicsCommandType::AddImpulse:
+					AddImpulse(command.entity, command.value);
+					break;
+				case PhysicsCommandType::AddImpulseAtPosition:
+					AddImpulseAtPosition(command.entity, command.value, command.position);
+					break;
+				case PhysicsCommandType::AddTorque:
+					AddTorque(command.entity, command.value);
+					break;
+				case PhysicsCommandType::AddAngularImpulse:
+					AddAngularImpulse(command.entity, command.value);
+					break;
+				case PhysicsCommandType::RegisterCollisionCallbacks:
+					RegisterCollisionCallbacks(command.entity);
+					break;
+				case PhysicsCommandType::UnregisterCollisionCallbacks:
+					UnregisterCollisionCallbacks(command.entity);
+					break;
+			}
+		}
+		context->commands.Clear();
+
+		//queries deferred during the step see the bodies after the buffered commands
+		Array<std::function<void()>> afterStep = Traits::Move(context->afterStep);
+		context->afterStep.Clear();
+		for (const std::function<void()>& callback : afterStep)
+		{
+			callback();
+		}
+
+		return true;
+	}
+
+	void PhysicsScene::RunAfterStep(const std::function<void()>& callback)
+	{
+		if (context && context->stepping)
+		{
+			std::lock_guard<std::mutex> lock(context->commandMutex);
+			if (context->stepping)
+			{
+				context->afterStep.EmplaceBack(callback);
+				return;
+			}
+		}
+		callback();
+	}
+
+	void PhysicsScene::SetAsyncStep(bool asyncStep)
+	{
+		if (context)
+		{
+			context->asyncStep = asyncStep;
+		}
+	}
+
+	bool PhysicsScene::IsAsyncStep() const
+	{
+		return context && context->asyncStep;
+	}
+
+	bool PhysicsScene::IsStepping() const
+	{
+		return context && context->stepping;
+	}
+
+	void PhysicsScene::WaitStep()
+	{
+		if (context && context->stepJob)
+		{
+			JobSystem::Wait(context->stepJob);
+		}
+	}
+
 	void PhysicsScene::WriteBackTransforms()
 	{
+		if (!context) return;
+
 		SK_SCOPED_CPU_ZONE("Physics - WriteBackTransforms");
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
@@ -1274,12 +1578,15 @@ namespace Skore
 
 	JPH::PhysicsSystem* PhysicsScene::GetPhysicsSystem()
 	{
+		//callers query or modify the system directly, the in-flight step has to finish first (see RunAfterStep)
+		WaitStep();
 		return &context->physicsSystem;
 	}
 
 	void PhysicsScene::SetLinearVelocity(Entity* entity, const Vec3& velocity)
 	{
 		if (entity->m_physicsId == U64_MAX || entity->HasFlag(EntityFlags::HasCharacterController)) return;
+		if (BufferCommand(context, PhysicsCommandType::SetLinearVelocity, entity, velocity)) return;
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 		JPH::BodyID bodyId = JPH::BodyID(entity->m_physicsId);
@@ -1289,6 +1596,7 @@ namespace Skore
 	void PhysicsScene::SetAngularVelocity(Entity* entity, const Vec3& velocity)
 	{
 		if (entity->m_physicsId == U64_MAX || entity->HasFlag(EntityFlags::HasCharacterController)) return;
+		if (BufferCommand(context, PhysicsCommandType::SetAngularVelocity, entity, velocity)) return;
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 		JPH::BodyID bodyId = JPH::BodyID(entity->m_physicsId);
@@ -1298,6 +1606,7 @@ namespace Skore
 	void PhysicsScene::AddForce(Entity* entity, const Vec3& force)
 	{
 		if (entity->m_physicsId == U64_MAX || entity->HasFlag(EntityFlags::HasCharacterController)) return;
+		if (BufferCommand(context, PhysicsCommandType::AddForce, entity, force)) return;
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 		JPH::BodyID bodyId = JPH::BodyID(entity->m_physicsId);
@@ -1307,6 +1616,7 @@ namespace Skore
 	void PhysicsScene::AddForceAtPosition(Entity* entity, const Vec3& force, const Vec3& position)
 	{
 		if (entity->m_physicsId == U64_MAX || entity->HasFlag(EntityFlags::HasCharacterController)) return;
+		if (BufferCommand(context, PhysicsCommandType::AddForceAtPosition, entity, force, position)) return;
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 		JPH::BodyID bodyId = JPH::BodyID(entity->m_physicsId);
@@ -1316,6 +1626,7 @@ namespace Skore
 	void PhysicsScene::AddImpulse(Entity* entity, const Vec3& impulse)
 	{
 		if (entity->m_physicsId == U64_MAX || entity->HasFlag(EntityFlags::HasCharacterController)) return;
+		if (BufferCommand(context, PhysicsCommandType::AddImpulse, entity, impulse)) return;
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 		JPH::BodyID bodyId = JPH::BodyID(entity->m_physicsId);
@@ -1325,6 +1636,7 @@ namespace Skore
 	void PhysicsScene::AddImpulseAtPosition(Entity* entity, const Vec3& impulse, const Vec3& position)
 	{
 		if (entity->m_physicsId == U64_MAX || entity->HasFlag(EntityFlags::HasCharacterController)) return;
+		if (BufferCommand(context, PhysicsCommandType::AddImpulseAtPosition, entity, impulse, position)) return;
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 		JPH::BodyID bodyId = JPH::BodyID(entity->m_physicsId);
@@ -1334,6 +1646,7 @@ namespace Skore
 	void PhysicsScene::AddTorque(Entity* entity, const Vec3& torque)
 	{
 		if (entity->m_physicsId == U64_MAX || entity->HasFlag(EntityFlags::HasCharacterController)) return;
+		if (BufferCommand(context, PhysicsCommandType::AddTorque, entity, torque)) return;
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 		JPH::BodyID bodyId = JPH::BodyID(entity->m_physicsId);
@@ -1343,6 +1656,7 @@ namespace Skore
 	void PhysicsScene::AddAngularImpulse(Entity* entity, const Vec3& angularImpulse)
 	{
 		if (entity->m_physicsId == U64_MAX || entity->HasFlag(EntityFlags::HasCharacterController)) return;
+		if (BufferCommand(context, PhysicsCommandType::AddAngularImpulse, entity, angularImpulse)) return;
 
 		JPH::BodyInterface& bodyInterface = context->physicsSystem.GetBodyInterface();
 		JPH::BodyID bodyId = JPH::BodyID(entity->m_physicsId);
@@ -1351,16 +1665,21 @@ namespace Skore
 
 	void PhysicsScene::RegisterCollisionCallbacks(Entity* entity)
 	{
+		//the contact listener reads the flag while stepping
+		if (context && BufferCommand(context, PhysicsCommandType::RegisterCollisionCallbacks, entity)) return;
 		entity->AddFlag(EntityFlags::HasCollisionCallbacks);
 	}
 
 	void PhysicsScene::UnregisterCollisionCallbacks(Entity* entity)
 	{
+		if (context && BufferCommand(context, PhysicsCommandType::UnregisterCollisionCallbacks, entity)) return;
 		entity->RemoveFlag(EntityFlags::HasCollisionCallbacks);
 	}
 
 	void PhysicsScene::ProcessCollisionEvents()
 	{
+		if (!context) return;
+
 		SK_SCOPED_CPU_ZONE("Physics - Process Collision Events");
 
 		CollisionEvent event;
@@ -1411,6 +1730,8 @@ namespace Skore
 
 	void PhysicsScene::ProcessPendingBodiesToAdd()
 	{
+		if (!context) return;
+
 		SK_SCOPED_CPU_ZONE("Physics - Process Pending Bodies To Add");
 
 		if (context->pendingBodiesToAdd.empty()) return;
@@ -1480,13 +1801,13 @@ namespace Skore
 		if (!physicsSystem) return false;
 
 		JPH::RRayCast ray{Cast(origin), Cast(direction * maxDistance)};
-		JPH::AllHitCollisionCollector<JPH::CastRayCollector> collector;
+		FrameRayCastCollector collector;
 
 		LayerMaskBodyFilter bodyFilter(layerMask);
 
 		physicsSystem->GetNarrowPhaseQuery().CastRay(ray, JPH::RayCastSettings{}, collector, {}, {}, bodyFilter);
 
-		if (!collector.HadHit())
+		if (collector.hits.Empty())
 		{
 			return false;
 		}
@@ -1495,16 +1816,17 @@ namespace Skore
 
 		JPH::BodyInterface& bodyInterface = physicsSystem->GetBodyInterface();
 
-		for (const JPH::RayCastResult& result : collector.mHits)
+		hits.Reserve(hits.Size() + collector.hits.Size());
+		for (const RayCastHitResult& result : collector.hits)
 		{
 			RaycastHit hit;
-			hit.distance = result.mFraction * maxDistance;
+			hit.distance = result.fraction * maxDistance;
 			hit.point = origin + direction * hit.distance;
 
-			JPH::RVec3 surfaceNormal = bodyInterface.GetShape(result.mBodyID)->GetSurfaceNormal(result.mSubShapeID2, ray.GetPointOnRay(result.mFraction));
+			JPH::RVec3 surfaceNormal = bodyInterface.GetShape(result.bodyID)->GetSurfaceNormal(result.subShapeID, ray.GetPointOnRay(result.fraction));
 			hit.normal = Cast(JPH::Vec3(surfaceNormal));
 
-			hit.entity = reinterpret_cast<Entity*>(bodyInterface.GetUserData(result.mBodyID));
+			hit.entity = reinterpret_cast<Entity*>(bodyInterface.GetUserData(result.bodyID));
 
 			hits.EmplaceBack(hit);
 		}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "Entity.hpp"
@@ -45,6 +46,7 @@ namespace Skore
 			MaxContactConstraints,  //UInt
 			PhysicsTicksPerSeconds, //UInt
 			CollisionMatrix,			  //Subobject
+			AsyncSimulation,        //Bool
 		};
 	};
 
@@ -95,6 +97,7 @@ namespace Skore
 		void UnregisterPhysicsEntity(Entity* entity);
 		void PhysicsEntityRequireUpdate(Entity* entity);
 		void UpdateTransform(Entity* entity);
+		bool IsWritingBackTransforms() const;
 
 		CollisionShapePtr CreateStaticMeshShape(Span<Vec3> vertices, Span<u32> indices);
 		u32               AddStaticMeshBody(const CollisionShapePtr& shape, const Vec3& position, const Quat& rotation, u8 layer = 0);
@@ -119,6 +122,18 @@ namespace Skore
 		void ProcessCollisionEvents();
 		void ProcessPendingBodiesToAdd();
 
+		//opt-in, the last fixed step of a frame runs on the job system while OnUpdate runs and is synced on the next Scene::Update.
+		//velocity, force, transform and collision callback changes made during the step are buffered until the sync.
+		//queries (GetPhysicsSystem and the Physics casts), body creation and removal block until the step finishes,
+		//use RunAfterStep to run them at the sync instead of stalling OnUpdate.
+		void SetAsyncStep(bool asyncStep);
+		bool IsAsyncStep() const;
+		bool IsStepping() const;
+		void WaitStep();
+
+		//runs the callback when the in-flight step is synced, after the buffered commands, or right away if there is none
+		void RunAfterStep(const std::function<void()>& callback);
+
 		friend class Scene;
 		friend class Physics;
 	private:
@@ -127,6 +142,8 @@ namespace Skore
 		void ExecuteEvents();
 		void UpdateCharacterControllers();
 		void DoFixedUpdate(f32 stepSize);
+		void BeginFixedUpdate(f32 stepSize);
+		bool SyncStep();
 		void WriteBackTransforms();
 		void OnSceneActivated();
 		void OnSceneDeactivated();
@@ -165,6 +182,8 @@ namespace Skore
 		static void SetCurrentScene(PhysicsScene* physicsScene);
 		static PhysicsScene* GetCurrentScene();
 
+		//casts wait for an in-flight async step, see PhysicsScene::RunAfterStep
+
 		static bool Raycast(const Vec3& origin, const Vec3& direction, f32 maxDistance, RaycastHit& hit, u64 layerMask = AllLayersMask);
 		static bool RaycastAll(const Vec3& origin, const Vec3& direction, f32 maxDistance, Array<RaycastHit>& hits, u64 layerMask = AllLayersMask);
 
@@ -6,19 +6,68 @@
 #include "Skore/Events.hpp"
 #include "Skore/Profiler.hpp"
 #include "Skore/Core/Event.hpp"
+#include "Skore/Core/JobSystem.hpp"
 #include "Skore/Core/Reflection.hpp"
+#include "Skore/Scene/Components/Transform.hpp"
 
 
 namespace Skore
 {
-	Scene::Scene()
+	namespace
+	{
+		constexpr u32 ParallelTickBatchSize = 32;
+
+		bool ContainsType(const Array<TypeID>& types, TypeID typeId)
+		{
+			for (TypeID type : types)
+			{
+				if (type == typeId)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool Accesses(TypeID typeId, const ParallelTick* parallelTick, TypeID other)
+		{
+			return typeId == other || ContainsType(parallelTick->reads, other) || ContainsType(parallelTick->writes, other);
+		}
+
+		bool WritesConflict(TypeID typeId, const ParallelTick* parallelTick, TypeID otherId, const ParallelTick* otherParallelTick)
+		{
+			if (Accesses(otherId, otherParallelTick, typeId))
+			{
+				return true;
+			}
+
+			for (TypeID write : parallelTick->writes)
+			{
+				if (Accesses(otherId, otherParallelTick, write))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool ParallelTickConflicts(TypeID typeId, const ParallelTick* parallelTick, TypeID otherId, const ParallelTick* otherParallelTick)
+		{
+			return WritesConflict(typeId, parallelTick, otherId, otherParallelTick) || WritesConflict(otherId, otherParallelTick, typeId, parallelTick);
+		}
+	}
+
+	Scene::Scene() : m_entityStorage(sizeof(Entity), alignof(Entity))
 	{
 		InitUI();
 	}
 
-	Scene::Scene(RID rid, bool enableResourceSync) : m_enableResourceSync(enableResourceSync), m_sceneRID(rid)
+	Scene::Scene(RID rid, bool enableResourceSync) : m_enableResourceSync(enableResourceSync), m_sceneRID(rid), m_entityStorage(sizeof(Entity), alignof(Entity))
 	{
 		InitUI();
+
+		//world transforms of the loaded hierarchy are computed once, parents before children
+		SetDeferredTransformUpdates(true);
 		if (ResourceObject sceneResource = Resources::Read(rid))
 		{
 			Span<RID> entitiesRID = sceneResource.GetSubObjectList(SceneResource::Entities);
@@ -27,6 +76,7 @@ namespace Skore
 				Entity::Instantiate(this, nullptr, entityRID, true);
 			}
 		}
+		SetDeferredTransformUpdates(false);
 
 		if (enableResourceSync)
 		{
@@ -36,10 +86,13 @@ namespace Skore
 
 	}
 
-	Scene::Scene(TypedRID<EntityResource> rid, bool enableResourceSync) : m_enableResourceSync(enableResourceSync)
+	Scene::Scene(TypedRID<EntityResource> rid, bool enableResourceSync) : m_enableResourceSync(enableResourceSync), m_entityStorage(sizeof(Entity), alignof(Entity))
 	{
 		InitUI();
+
+		SetDeferredTransformUpdates(true);
 		Entity::Instantiate(this, nullptr, rid, true);
+		SetDeferredTransformUpdates(false);
 		if (enableResourceSync)
 		{
 			Event::Bind<OnPluginReloaded, &Scene::DoReflectionUpdated>(this);
@@ -54,6 +107,22 @@ namespace Skore
 		}
 		Event::Unbind<OnPluginReloaded, &Scene::DoReflectionUpdated>(this);
 
+		//the contact listener reads entities while stepping
+		physicsScene.WaitStep();
+
+		m_dirtyTransforms.Clear();
+
+		//objects are still destroyed one by one, but their memory is released with the storages at the end
+		m_destroying = true;
+		m_entityStorage.BeginRelease();
+		for (auto& it : m_componentStorages)
+		{
+			if (it.second)
+			{
+				it.second->BeginRelease();
+			}
+		}
+
 		for (Entity* entity : entities)
 		{
 			entity->DestroyInternal(false);
@@ -70,6 +139,24 @@ namespace Skore
 		entitiesByRID.Clear();
 		entities.Clear();
 
+		for (auto& it : m_queryCaches)
+		{
+			for (QueryCache* cache : it.second)
+			{
+				DestroyAndFree(cache);
+			}
+		}
+
+		ClearPrefabTemplates();
+
+		for (auto& it : m_componentStorages)
+		{
+			if (it.second)
+			{
+				DestroyAndFree(it.second);
+			}
+		}
+
 		if (uiContext) uiContext->Destroy();
 	}
 
@@ -78,6 +165,332 @@ namespace Skore
 		return m_enableResourceSync;
 	}
 
+	ComponentStorage* Scene::GetComponentStorage(TypeID typeId) const
+	{
+		if (auto it = m_componentStorages.Find(typeId))
+		{
+			return it->second;
+		}
+		return nullptr;
+	}
+
+	Entity* Scene::AllocateEntity()
+	{
+		Entity* entity = static_cast<Entity*>(m_entityStorage.Allocate());
+		new(PlaceHolder{}, entity) Entity();
+		entity->m_storage = &m_entityStorage;
+		return entity;
+	}
+
+	Component* Scene::AllocateComponent(ReflectType* reflectType)
+	{
+		ReflectConstructor* constructor = reflectType->GetDefaultConstructor();
+		if (constructor == nullptr) return nullptr;
+
+		const TypeProps& props = reflectType->GetProps();
+
+		auto it = m_componentStorages.Find(props.typeId);
+		if (it == m_componentStorages.end())
+		{
+			const ComponentDesc* desc = reflectType->GetAttribute<ComponentDesc>();
+
+			ComponentStorage* storage = nullptr;
+			if ((desc == nullptr || desc->pooledStorage) && props.alignment <= ComponentStorage::MaxAlignment)
+			{
+				storage = Alloc<ComponentStorage>(props.size, props.alignment);
+			}
+			it = m_componentStorages.Insert(props.typeId, storage).first;
+		}
+
+		//types reloaded with a bigger size fall back to the heap
+		ComponentStorage* storage = it->second;
+		if (storage == nullptr || storage->GetComponentSize() < props.size)
+		{
+			return constructor->NewObject(MemoryGlobals::GetDefaultAllocator(), nullptr)->SafeCast<Component>();
+		}
+
+		Component* component = constructor->NewObject(storage->GetAllocator(), nullptr)->SafeCast<Component>();
+		component->m_storage = storage;
+		return component;
+	}
+
+	void Scene::FreeComponent(Component* component)
+	{
+		if (ComponentStorage* storage = component->m_storage)
+		{
+			storage->GetAllocator()->DestroyAndFree(component);
+		}
+		else
+		{
+			DestroyAndFree(component);
+		}
+	}
+
+	Scene::QueryCache* Scene::FindOrCreateQueryCache(Span<TypeID> types)
+	{
+		u64 key = 0;
+		for (TypeID typeId : types)
+		{
+			HashCombine(key, static_cast<u64>(typeId));
+		}
+
+		//different type lists can share a key, caches with the same key are chained
+		Array<QueryCache*>& bucket = m_queryCaches[key];
+		for (QueryCache* cache : bucket)
+		{
+			if (types == cache->types)
+			{
+				return cache;
+			}
+		}
+
+		QueryCache* cache = Alloc<QueryCache>();
+		cache->types = types;
+		bucket.EmplaceBack(cache);
+
+		for (TypeID typeId : types)
+		{
+			Array<QueryCache*>& caches = m_queryCachesByType[typeId];
+			if (caches.IndexOf(cache) == nPos)
+			{
+				caches.EmplaceBack(cache);
+			}
+		}
+
+		for (Entity* entity : entities)
+		{
+			AddQueryMatches(cache, entity);
+		}
+
+		return cache;
+	}
+
+	void Scene::AddQueryMatches(QueryCache* cache, Entity* entity)
+	{
+		//components of inactive entities are not registered
+		if (!entity->IsActive()) return;
+
+		TryAddQueryMatch(cache, entity, nullptr, nullptr);
+
+		for (Entity* child : entity->m_children)
+		{
+			AddQueryMatches(cache, child);
+		}
+	}
+
+	bool Scene::TryAddQueryMatch(QueryCache* cache, Entity* entity, Component* added, Component* removed)
+	{
+		usize count = cache->types.Size();
+		usize first = cache->components.Size();
+		cache->components.Resize(first + count);
+
+		for (usize i = 0; i < count; ++i)
+		{
+			Component* match = nullptr;
+			if (added && added->GetTypeId() == cache->types[i])
+			{
+				match = added;
+			}
+			else
+			{
+				for (Component* component : entity->m_components)
+				{
+					//siblings removed in the same deactivation are no longer registered
+					if (component != removed && component->m_registered && component->GetTypeId() == cache->types[i])
+					{
+						match = component;
+						break;
+					}
+				}
+			}
+
+			if (match == nullptr)
+			{
+				cache->components.Resize(first);
+				return false;
+			}
+			cache->components[first + i] = match;
+		}
+
+		cache->rows.Insert(entity, cache->entities.Size());
+		cache->entities.EmplaceBack(entity);
+		return true;
+	}
+
+	void Scene::RemoveQueryMatch(QueryCache* cache, usize row)
+	{
+		usize count = cache->types.Size();
+		usize last = cache->entities.Size() - 1;
+
+		cache->rows.Erase(cache->entities[row]);
+
+		if (row != last)
+		{
+			Entity* moved = cache->entities[last];
+			cache->entities[row] = moved;
+			for (usize i = 0; i < count; ++i)
+			{
+				cache->components[row * count + i] = cache->components[last * count + i];
+			}
+			cache->rows[moved] = row;
+		}
+
+		cache->entities.PopBack();
+		cache->components.Resize(last * count);
+	}
+
+	void Scene::OnQueryComponentAdded(Component* component)
+	{
+		auto it = m_queryCachesByType.Find(component->GetTypeId());
+		if (it == m_queryCachesByType.end()) return;
+
+		for (QueryCache* cache : it->second)
+		{
+			if (!cache->rows.Has(component->entity))
+			{
+				TryAddQueryMatch(cache, component->entity, component, nullptr);
+			}
+		}
+	}
+
+	void Scene::OnQueryComponentRemoved(Component* component)
+	{
+		if (m_destroying) return;
+
+		auto it = m_queryCachesByType.Find(component->GetTypeId());
+		if (it == m_queryCachesByType.end()) return;
+
+		for (QueryCache* cache : it->second)
+		{
+			auto rowIt = cache->rows.Find(component->entity);
+			if (rowIt == cache->rows.end()) continue;
+
+			usize row = rowIt->second;
+			usize count = cache->types.Size();
+
+			bool referenced = false;
+			for (usize i = 0; i < count; ++i)
+			{
+				if (cache->components[row * count + i] == component)
+				{
+					referenced = true;
+					break;
+				}
+			}
+
+			if (referenced)
+			{
+				RemoveQueryMatch(cache, row);
+
+				//another component of the same type can still match
+				TryAddQueryMatch(cache, component->entity, nullptr, component);
+			}
+		}
+	}
+
+	void Scene::SetDeferredTransformUpdates(bool deferred)
+	{
+		if (m_deferredTransformUpdates && !deferred)
+		{
+			FlushTransformUpdates();
+		}
+		m_deferredTransformUpdates = deferred;
+	}
+
+	bool Scene::IsDeferredTransformUpdates() const
+	{
+		return m_deferredTransformUpdates;
+	}
+
+	void Scene::FlushTransformUpdates()
+	{
+		if (m_dirtyTransforms.Empty())
+		{
+			return;
+		}
+
+		SK_SCOPED_CPU_ZONE("Scene - FlushTransformUpdates");
+
+		//dirty transforms with a dirty ancestor are reached from the ancestor, only the top ones start the pass.
+		m_transformUpdates.Clear();
+		for (Transform* transform : m_dirtyTransforms)
+		{
+			bool dirtyAncestor = false;
+			for (Entity* parent = transform->entity->GetParent(); parent != nullptr; parent = parent->GetParent())
+			{
+				Transform* parentTransform = parent->GetComponent<Transform>();
+				if (parentTransform == nullptr)
+				{
+					break;
+				}
+
+				if (parentTransform->m_transformDirty)
+				{
+					dirtyAncestor = true;
+					break;
+				}
+			}
+
+			if (!dirtyAncestor)
+			{
+				u32 flags = transform->m_pendingFlags;
+				if (!transform->m_pendingPhysicsSync)
+				{
+					flags |= Transform::UpdateTransform_SkipPhysicsSync;
+				}
+				m_transformUpdates.EmplaceBack(TransformUpdate{transform, flags});
+			}
+		}
+		m_dirtyTransforms.Clear();
+
+		//breadth-first, parents are always updated before their children. Propagation stops at entities without Transform.
+		for (usize i = 0; i < m_transformUpdates.Size(); ++i)
+		{
+			TransformUpdate update = m_transformUpdates[i];
+			Transform*      transform = update.transform;
+			Entity*         entity = transform->entity;
+
+			entity->m_worldTransform = transform->GetParentWorldTransform() * transform->GetLocalTransform();
+
+			transform->m_pendingFlags = 0;
+			transform->m_transformDirty = false;
+			transform->m_pendingPhysicsSync = false;
+
+			for (Entity* child : entity->m_children)
+			{
+				Transform* childTransform = child->GetComponent<Transform>();
+				if (childTransform == nullptr)
+				{
+					continue;
+				}
+
+				u32 flags = update.flags;
+				if (childTransform->m_transformDirty)
+				{
+					flags |= childTransform->m_pendingFlags;
+					if (childTransform->m_pendingPhysicsSync)
+					{
+						flags &= ~Transform::UpdateTransform_SkipPhysicsSync;
+					}
+				}
+				m_transformUpdates.EmplaceBack(TransformUpdate{childTransform, flags});
+			}
+		}
+
+		//notified after all world transforms are updated, transforms changed by listeners are handled on next flush.
+		EntityEventDesc desc;
+		desc.type = EntityEventType::TransformUpdated;
+
+		for (const TransformUpdate& update : m_transformUpdates)
+		{
+			desc.flags = update.flags;
+			for (Component* component : update.transform->entity->m_components)
+			{
+				component->ProcessEvent(desc);
+			}
+		}
+	}
+
 	Entity* Scene::FindEntityByRID(RID rid) const
 	{
 		if (auto it = entitiesByRID.Find(rid))
@@ -127,14 +540,10 @@ namespace Skore
 		return entities;
 	}
 
-	AABB Scene::GetBounds() const
+	AABB Scene::GetBounds()
 	{
-		AABB bounds;
-		for (Entity* entity : entities)
-		{
-			bounds.Expand(entity->GetBounds());
-		}
-		return bounds;
+		spatialIndex.Flush();
+		return spatialIndex.GetBounds();
 	}
 
 	void Scene::RegisterType(NativeReflectType<Scene>& type)
@@ -160,14 +569,109 @@ namespace Skore
 		auto it = entitiesByRID.Find(rid);
 		if (it == entitiesByRID.end())
 		{
-			Entity* entity = static_cast<Entity*>(MemAlloc(sizeof(Entity)));
-			new(PlaceHolder{}, entity) Entity();
-			it = entitiesByRID.Insert(rid, entity).first;
+			it = entitiesByRID.Insert(rid, AllocateEntity()).first;
 		}
 
 		return it->second;
 	}
 
+	Scene::PrefabTemplate* Scene::FindOrCreatePrefabTemplate(RID rid, Entity* owner)
+	{
+		u64 version = Resources::GetVersion(rid);
+
+		if (auto it = m_prefabTemplates.Find(rid))
+		{
+			if (it->second->version == version)
+			{
+				return it->second;
+			}
+
+			for (PrefabComponent& component : it->second->components)
+			{
+				DestroyAndFree(component.prototype);
+			}
+			DestroyAndFree(it->second);
+			m_prefabTemplates.Erase(rid);
+		}
+
+		PrefabTemplate* prefabTemplate = Alloc<PrefabTemplate>();
+		prefabTemplate->version = version;
+		AddPrefabNode(prefabTemplate, rid, U32_MAX, owner);
+		m_prefabTemplates.Insert(rid, prefabTemplate);
+
+		return prefabTemplate;
+	}
+
+	void Scene::AddPrefabNode(PrefabTemplate* prefabTemplate, RID rid, u32 parent, Entity* owner)
+	{
+		ResourceObject entityObject = Resources::Read(rid);
+		if (!entityObject) return;
+
+		u32 index = prefabTemplate->nodes.Size();
+
+		PrefabNode& node = prefabTemplate->nodes.EmplaceBack();
+		node.parent = parent;
+		node.name = entityObject.GetString(EntityResource::Name);
+		node.layer = static_cast<u8>(entityObject.GetUInt(EntityResource::Layer));
+		node.deactivated = entityObject.GetBool(EntityResource::Deactivated);
+		node.firstComponent = prefabTemplate->components.Size();
+		node.componentCount = 0;
+		node.childCount = 0;
+
+		if (parent != U32_MAX)
+		{
+			prefabTemplate->nodes[parent].childCount++;
+		}
+
+		entityObject.IterateSubObjectList(EntityResource::Components, [&](RID component)
+		{
+			ResourceType* type = Resources::GetType(component);
+			if (type == nullptr || type->GetReflectType() == nullptr) return;
+
+			ReflectType* reflectType = Reflection::FindTypeById(type->GetReflectType()->GetProps().typeId);
+			if (reflectType == nullptr) return;
+
+			Object* object = reflectType->NewObject();
+			if (object == nullptr) return;
+
+			Component* prototype = object->SafeCast<Component>();
+			if (prototype == nullptr)
+			{
+				DestroyAndFree(object);
+				return;
+			}
+
+			//entity references are resolved here, owner only provides the scene
+			Resources::FromResource(component, prototype, owner);
+			prefabTemplate->components.EmplaceBack(PrefabComponent{reflectType, prototype});
+		});
+
+		prefabTemplate->nodes[index].componentCount = prefabTemplate->components.Size() - prefabTemplate->nodes[index].firstComponent;
+
+		entityObject.IterateSubObjectList(EntityResource::Children, [&](RID child)
+		{
+			AddPrefabNode(prefabTemplate, child, index, owner);
+		});
+	}
+
+	bool Scene::HasPrefabTemplate(RID rid) const
+	{
+		return m_prefabTemplates.Has(rid);
+	}
+
+	void Scene::ClearPrefabTemplates()
+	{
+		for (auto& it : m_prefabTemplates)
+		{
+			for (PrefabComponent& component : it.second->components)
+			{
+				DestroyAndFree(component.prototype);
+			}
+			DestroyAndFree(it.second);
+		}
+		m_prefabTemplates.Clear();
+	}
+
 	void Scene::OnSceneDeactivated()
 	{
 		//TODO
@@ -222,59 +726,246 @@ namespace Skore
 			m_fixedUpdateComponents.erase(m_fixedUpdateToRemove.Dequeue());
 		}
 
+		while (!m_parallelTickToAdd.IsEmpty())
+		{
+			m_parallelTickComponents.emplace(m_parallelTickToAdd.Dequeue());
+			m_parallelTickStagesDirty = true;
+		}
+
+		while (!m_parallelTickToRemove.IsEmpty())
+		{
+			m_parallelTickComponents.erase(m_parallelTickToRemove.Dequeue());
+			m_parallelTickStagesDirty = true;
+		}
+
 		physicsScene.ExecuteEvents();
 	}
 
 	void Scene::Update()
+	{
+		Update(App::DeltaTime());
+	}
+
+	void Scene::Update(f64 deltaTime)
 	{
 		SK_SCOPED_CPU_ZONE("Scene - Update");
 
 		Physics::SetCurrentScene(&physicsScene);
 		Navigation::SetCurrentScene(&navigationScene);
 
+		//async step from the last frame, its results are applied before anything else touches the bodies
+		if (physicsScene.SyncStep())
+		{
+			physicsScene.WriteBackTransforms();
+			FlushTransformUpdates();
+			physicsScene.ProcessCollisionEvents();
+			physicsScene.ProcessPendingBodiesToAdd();
+		}
+
 		ExecuteEvents();
 
+		if (m_parallelTickStagesDirty)
+		{
+			BuildParallelTickStages();
+		}
+
+		FlushTransformUpdates();
 		physicsScene.UpdateCharacterControllers();
 
 		f32 stepSize = physicsScene.GetFixedTimeStep();
 		if (stepSize > 0.0f)
 		{
-			m_physicsAccumulator += App::DeltaTime();
+			m_physicsAccumulator += deltaTime;
 			while (m_physicsAccumulator >= stepSize)
 			{
 				SK_SCOPED_CPU_ZONE("Scene - OnFixedUpdate");
+				for (ParallelTickStage& stage : m_parallelTickStages)
+				{
+					BeginParallelTickStage();
+					JobSystem::ParallelFor(stage.fixedUpdateComponents.Size(), ParallelTickBatchSize, [&](u32 index)
+					{
+						stage.fixedUpdateComponents[index]->OnFixedUpdate(stepSize);
+					});
+					EndParallelTickStage();
+				}
+
 				for (FixedTickable* fixedTickable : m_fixedUpdateComponents)
 				{
 					fixedTickable->OnFixedUpdate(stepSize);
 				}
-				physicsScene.DoFixedUpdate(stepSize);
+				FlushTransformUpdates();
 				m_physicsAccumulator -= stepSize;
+
+				//the last step of the frame overlaps OnUpdate
+				if (physicsScene.IsAsyncStep() && m_physicsAccumulator < stepSize)
+				{
+					physicsScene.BeginFixedUpdate(stepSize);
+				}
+				else
+				{
+					physicsScene.DoFixedUpdate(stepSize);
+				}
 			}
 		}
 
-		physicsScene.WriteBackTransforms();
-		physicsScene.ProcessCollisionEvents();
-		physicsScene.ProcessPendingBodiesToAdd();
+		if (!physicsScene.IsStepping())
+		{
+			physicsScene.WriteBackTransforms();
+			FlushTransformUpdates();
+			physicsScene.ProcessCollisionEvents();
+			physicsScene.ProcessPendingBodiesToAdd();
+		}
 
-		navigationScene.Update(static_cast<f32>(App::DeltaTime()));
+		navigationScene.Update(static_cast<f32>(deltaTime));
+
+		//queries of this frame see the bounds after the physics write back
+		spatialIndex.Flush();
 
 		{
 			SK_SCOPED_CPU_ZONE("Scene - OnUpdate");
 
-			f64 deltaTime = App::DeltaTime();
+			for (ParallelTickStage& stage : m_parallelTickStages)
+			{
+				BeginParallelTickStage();
+				JobSystem::ParallelFor(stage.updateComponents.Size(), ParallelTickBatchSize, [&](u32 index)
+				{
+					stage.updateComponents[index]->OnUpdate(deltaTime);
+				});
+				EndParallelTickStage();
+			}
+
 			for (Tickable* tickable : m_updateComponents)
 			{
 				tickable->OnUpdate(deltaTime);
 			}
 		}
+
+		FlushTransformUpdates();
 	}
 
 	void Scene::DoReflectionUpdated()
 	{
+		//reloaded components are recreated, nothing can stay queued
+		FlushTransformUpdates();
+
 		for (Entity* entity : entities)
 		{
 			entity->ReflectionReload();
 		}
+
+		//attributes can change on reload, stages are assigned again on next update
+		m_parallelTickStageByType.Clear();
+		m_parallelTickStagesDirty = true;
+
+		//prototypes have the layout of the old types
+		ClearPrefabTemplates();
+	}
+
+	u32 Scene::FindParallelTickStage(TypeID typeId, const ParallelTick* parallelTick)
+	{
+		if (auto it = m_parallelTickStageByType.Find(typeId))
+		{
+			return it->second;
+		}
+
+		u32 stageIndex = 0;
+		for (; stageIndex < m_parallelTickStages.Size(); ++stageIndex)
+		{
+			ParallelTickStage& stage = m_parallelTickStages[stageIndex];
+
+			bool conflicts = false;
+			for (usize i = 0; i < stage.types.Size(); ++i)
+			{
+				if (ParallelTickConflicts(typeId, parallelTick, stage.types[i], stage.access[i]))
+				{
+					conflicts = true;
+					break;
+				}
+			}
+
+			if (!conflicts)
+			{
+				break;
+			}
+		}
+
+		if (stageIndex == m_parallelTickStages.Size())
+		{
+			m_parallelTickStages.EmplaceBack();
+		}
+
+		m_parallelTickStages[stageIndex].types.EmplaceBack(typeId);
+		m_parallelTickStages[stageIndex].access.EmplaceBack(parallelTick);
+		m_parallelTickStageByType.Insert(typeId, stageIndex);
+		return stageIndex;
+	}
+
+	u32 Scene::GetParallelTickStage(TypeID typeId) const
+	{
+		if (auto it = m_parallelTickStageByType.Find(typeId))
+		{
+			return it->second;
+		}
+		return U32_MAX;
+	}
+
+	//transform writes of the workers only queue the entity, world transforms, physics, renderer and children are updated
+	//on the calling thread once the stage is done. The next stage sees the updated world transforms.
+	void Scene::BeginParallelTickStage()
+	{
+		m_parallelTickDeferred = m_deferredTransformUpdates;
+		m_deferredTransformUpdates = true;
+		m_parallelTicking = true;
+	}
+
+	void Scene::EndParallelTickStage()
+	{
+		m_parallelTicking = false;
+		m_deferredTransformUpdates = m_parallelTickDeferred;
+		if (!m_deferredTransformUpdates)
+		{
+			FlushTransformUpdates();
+		}
+	}
+
+	void Scene::BuildParallelTickStages()
+	{
+		SK_SCOPED_CPU_ZONE("Scene - BuildParallelTickStages");
+
+		m_parallelTickStagesDirty = false;
+
+		if (m_parallelTickStageByType.Empty())
+		{
+			m_parallelTickStages.Clear();
+		}
+
+		for (ParallelTickStage& stage : m_parallelTickStages)
+		{
+			stage.updateComponents.Clear();
+			stage.fixedUpdateComponents.Clear();
+		}
+
+		for (Component* component : m_parallelTickComponents)
+		{
+			ReflectType* type = component->GetType();
+			const ParallelTick* parallelTick = type ? type->GetAttribute<ParallelTick>() : nullptr;
+			if (!parallelTick)
+			{
+				continue;
+			}
+
+			ParallelTickStage& stage = m_parallelTickStages[FindParallelTickStage(type->GetProps().typeId, parallelTick)];
+
+			if (Tickable* tickable = dynamic_cast<Tickable*>(component))
+			{
+				stage.updateComponents.EmplaceBack(tickable);
+			}
+
+			if (FixedTickable* fixedTickable = dynamic_cast<FixedTickable*>(component))
+			{
+				stage.fixedUpdateComponents.EmplaceBack(fixedTickable);
+			}
+		}
 	}
 
 	void Scene::InitUI()
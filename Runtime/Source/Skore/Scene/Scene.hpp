@@ -2,15 +2,22 @@
 #include "Skore/Core/Object.hpp"
 #include "Skore/Core/Queue.hpp"
 #include "Skore/Core/HashMap.hpp"
+#include "Skore/Core/FlatHashMap.hpp"
 #include "Physics.hpp"
+#include "ComponentStorage.hpp"
+#include "SpatialIndex.hpp"
 #include "Skore/Navigation/Navigation.hpp"
 #include "Skore/Core/UnorderedDense.hpp"
 #include "Skore/Graphics/RenderSceneObjects.hpp"
 #include "Skore/Resource/ResourceReflection.hpp"
 #include "Skore/UI/RmlUI.hpp"
 
+#include <mutex>
+
 namespace Skore
 {
+	class Transform;
+
 	class SK_API Scene : public Object
 	{
 	public:
@@ -47,6 +54,27 @@ namespace Skore
 			}
 		}
 
+		// calls fn(A*, B*, ...) for each entity that has all the listed components.
+		// matches are cached on first use and updated as components are added or removed,
+		// fn must not add or remove components of the queried types.
+		template <typename... Types, typename Fn>
+		void Query(Fn&& fn)
+		{
+			static_assert(sizeof...(Types) > 0, "query requires at least one component type");
+
+			constexpr usize count = sizeof...(Types);
+			TypeID          types[count] = {TypeInfo<Types>::ID()...};
+			QueryCache*     cache = FindOrCreateQueryCache(Span<TypeID>(types, count));
+
+			for (usize row = 0; row < cache->entities.Size(); ++row)
+			{
+				InvokeQuery<Types...>(fn, cache->components.Data() + row * count, Traits::MakeIntegerSequence<usize, count>{});
+			}
+		}
+
+		// storage of the component type, nullptr for types declared with ComponentDesc::pooledStorage = false.
+		ComponentStorage* GetComponentStorage(TypeID typeId) const;
+
 		template <typename T>
 		bool HasIterable()
 		{
@@ -57,18 +85,35 @@ namespace Skore
 			return false;
 		}
 
-		AABB GetBounds() const;
+		// bounds of the active entities in the spatial index, flushes it first.
+		AABB GetBounds();
+
+		// when enabled, transform setters only mark the entity as dirty and world transforms are updated once per frame in
+		// FlushTransformUpdates, listeners receive one coalesced TransformUpdated per entity.
+		// GetWorldTransform of a dirty entity returns the value from the last flush.
+		void SetDeferredTransformUpdates(bool deferred);
+		bool IsDeferredTransformUpdates() const;
+		void FlushTransformUpdates();
+
+		// stage the ParallelTick type runs in, U32_MAX until the type is assigned on the next Update.
+		u32 GetParallelTickStage(TypeID typeId) const;
+
+		// true if Entity::InstantiateBatch has a cached template for the entity resource, templates are cleared on reflection reload.
+		bool HasPrefabTemplate(RID rid) const;
 
 		friend class Entity;
 		friend class SceneManager;
 		friend class Component;
 		friend class SceneEditor;
+		friend class Transform;
+		friend class SpatialIndex;
 
 		friend class ResourceCast<Entity*>;
 
 		RenderSceneObjects renderObjects;
 		PhysicsScene       physicsScene;
 		NavigationScene    navigationScene;
+		SpatialIndex       spatialIndex{this};
 		UIContext*					 uiContext = nullptr;
 
 		void NotifyEvent(const EntityEventDesc& event, bool notifyChildren = false);
@@ -78,9 +123,14 @@ namespace Skore
 		static Scene* CreateFromEntity(RID rid, bool enableResourceSync = false);
 
 		void ExecuteEvents(bool executeComponentUpdates = true);
+
+		// one frame of the scene, called by SceneManager for the active scene.
+		void Update();
+		// same as Update with an explicit frame delta instead of App::DeltaTime, for simulations driven outside the app loop.
+		void Update(f64 deltaTime);
 	private:
 		Array<Entity*>                  entities;
-		HashMap<RID, Entity*>           entitiesByRID;
+		FlatHashMap<RID, Entity*>       entitiesByRID;
 		HashMap<String, Array<Entity*>> entitiesByName;
 
 		bool m_enableResourceSync = false;
@@ -92,23 +142,119 @@ namespace Skore
 		Queue<Tickable*>      m_updateToRemove;
 		Queue<FixedTickable*> m_fixedUpdateToAdd;
 		Queue<FixedTickable*> m_fixedUpdateToRemove;
+		Queue<Component*>     m_parallelTickToAdd;
+		Queue<Component*>     m_parallelTickToRemove;
 		Queue<Entity*>        m_queueToDestroy;
 
 		DenseSet<Tickable*>      m_updateComponents = {};
 		DenseSet<FixedTickable*> m_fixedUpdateComponents = {};
 
+		// components with ParallelTick are grouped in stages, types in the same stage don't conflict and tick concurrently.
+		struct ParallelTickStage
+		{
+			Array<TypeID>              types;
+			Array<const ParallelTick*> access;
+			Array<Tickable*>           updateComponents;
+			Array<FixedTickable*>      fixedUpdateComponents;
+		};
+
+		DenseSet<Component*>     m_parallelTickComponents = {};
+		Array<ParallelTickStage> m_parallelTickStages;
+		HashMap<TypeID, u32>     m_parallelTickStageByType;
+		bool                     m_parallelTickStagesDirty = false;
+		bool                     m_parallelTicking = false;
+		bool                     m_parallelTickDeferred = false;
+
 		HashMap<TypeID, DenseSet<Component*>> m_iterableComponents = {};
 
+		struct QueryCache
+		{
+			Array<TypeID>           types;
+			Array<Component*>       components; //types.Size() components per matched entity, in query order
+			Array<Entity*>          entities;
+			HashMap<Entity*, usize> rows;
+		};
+
+		HashMap<u64, Array<QueryCache*>>    m_queryCaches; //by hash of the type list
+		HashMap<TypeID, Array<QueryCache*>> m_queryCachesByType;
+		HashMap<TypeID, ComponentStorage*>  m_componentStorages;
+		ComponentStorage                    m_entityStorage;
+		bool                                m_destroying = false;
+
+		struct TransformUpdate
+		{
+			Transform* transform;
+			u32        flags;
+		};
+
+		bool                   m_deferredTransformUpdates = false;
+		Array<Transform*>      m_dirtyTransforms;
+		std::mutex             m_dirtyTransformsMutex; //workers of a parallel tick stage push concurrently
+		Array<TransformUpdate> m_transformUpdates;
+
 		f64 m_physicsAccumulator = 0.0;
 
+		struct PrefabComponent
+		{
+			ReflectType* reflectType;
+			Component*   prototype; //field values read from the component resource, instances are deep copies of it
+		};
+
+		struct PrefabNode
+		{
+			u32    parent; //U32_MAX for the root
+			String name;
+			u8     layer;
+			bool   deactivated;
+			u32    firstComponent;
+			u32    componentCount;
+			u32    childCount;
+		};
+
+		//flattened entity resource used by Entity::InstantiateBatch, nodes are stored depth first so parents come before their children.
+		//rebuilt when the resource version changes, changes on children and components bump the version of the root.
+		struct PrefabTemplate
+		{
+			u64                    version;
+			Array<PrefabNode>      nodes;
+			Array<PrefabComponent> components;
+		};
+
+		HashMap<RID, PrefabTemplate*> m_prefabTemplates;
+
 
 		Entity* FindOrCreateInstance(RID rid);
 
+		PrefabTemplate* FindOrCreatePrefabTemplate(RID rid, Entity* owner);
+		void            AddPrefabNode(PrefabTemplate* prefabTemplate, RID rid, u32 parent, Entity* owner);
+		void            ClearPrefabTemplates();
+
 		void OnSceneDeactivated();
 		void OnSceneActivated();
-		void Update();
 		void DoReflectionUpdated();
 
+		Entity*    AllocateEntity();
+		Component* AllocateComponent(ReflectType* reflectType);
+		void       FreeComponent(Component* component);
+
+		QueryCache* FindOrCreateQueryCache(Span<TypeID> types);
+		void        AddQueryMatches(QueryCache* cache, Entity* entity);
+		bool        TryAddQueryMatch(QueryCache* cache, Entity* entity, Component* added, Component* removed);
+		void        RemoveQueryMatch(QueryCache* cache, usize row);
+		void        OnQueryComponentAdded(Component* component);
+		void        OnQueryComponentRemoved(Component* component);
+
+		template <typename... Types, typename Fn, usize... Is>
+		static SK_FINLINE void InvokeQuery(Fn& fn, Component** components, Traits::IntegerSequence<usize, Is...>)
+		{
+			fn(static_cast<Types*>(components[Is])...);
+		}
+
+		void BuildParallelTickStages();
+		u32  FindParallelTickStage(TypeID typeId, const ParallelTick* parallelTick);
+		void BeginParallelTickStage();
+		void EndParallelTickStage();
+
 		void InitUI();
 
 		static void OnSceneResourceChange(ResourceObject& oldValue, ResourceObject& newValue, VoidPtr userData);
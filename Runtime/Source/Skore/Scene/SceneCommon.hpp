@@ -111,6 +111,17 @@ namespace Skore
 		bool          allowMultiple = true;
 		Array<TypeID> dependencies{};
 		String		  category = "";
+		bool          pooledStorage = true; //instances are kept in contiguous per-type chunks owned by the scene, false uses the heap
+	};
+
+	// Opt-in for running OnUpdate/OnFixedUpdate on worker threads.
+	// reads/writes list the component types accessed on the component's own entity, the component itself is always written.
+	// Parallel tickers must not create or destroy entities/components while ticking.
+	// Transform writes are applied after the stage, GetWorldTransform returns the value from before the stage until then.
+	struct ParallelTick
+	{
+		Array<TypeID> reads{};
+		Array<TypeID> writes{};
 	};
 
 	struct EntityEventDesc
@@ -54,6 +54,13 @@ namespace Skore
 			componentDesc.Field<&ComponentDesc::allowMultiple>("allowMultiple");
 			componentDesc.Field<&ComponentDesc::dependencies>("dependencies");
 			componentDesc.Field<&ComponentDesc::category>("category");
+			componentDesc.Field<&ComponentDesc::pooledStorage>("pooledStorage");
+		}
+
+		{
+			auto parallelTick = Reflection::Type<ParallelTick>();
+			parallelTick.Field<&ParallelTick::reads>("reads");
+			parallelTick.Field<&ParallelTick::writes>("writes");
 		}
 
 		{
@@ -220,6 +227,7 @@ namespace Skore
 				.Field<PhysicsSettings::MaxContactConstraints>(ResourceFieldType::UInt)
 				.Field<PhysicsSettings::PhysicsTicksPerSeconds>(ResourceFieldType::UInt)
 				.Field<PhysicsSettings::CollisionMatrix>(ResourceFieldType::SubObjectList)
+				.Field<PhysicsSettings::AsyncSimulation>(ResourceFieldType::Bool)
 				.Attribute<EditableSettings>(EditableSettings{
 					.path = "Engine/Physics Settings",
 					.type = TypeInfo<ProjectSettings>::ID(),
@@ -234,6 +242,7 @@ namespace Skore
 			object.SetUInt(PhysicsSettings::MaxBodyPairs, 65536);
 			object.SetUInt(PhysicsSettings::MaxContactConstraints, 10240);
 			object.SetUInt(PhysicsSettings::PhysicsTicksPerSeconds, 75);
+			object.SetBool(PhysicsSettings::AsyncSimulation, false);
 
 			for (u32 i = 0; i < MaxLayers; ++i)
 			{
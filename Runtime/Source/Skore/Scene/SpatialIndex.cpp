@@ -0,0 +1,640 @@
+#include "Skore/Scene/SpatialIndex.hpp"
+
+#include "Skore/Scene/Entity.hpp"
+#include "Skore/Scene/Scene.hpp"
+
+namespace Skore
+{
+	namespace
+	{
+		//leaves are enlarged by a fraction of their extent plus a fixed margin
+		constexpr f32 FatMarginScale = 0.1f;
+		constexpr f32 FatMarginMin = 0.05f;
+
+		//leaves shrunk inside their enlarged bounds are reinserted when the stored area is this many times bigger
+		constexpr f32 FatAreaRatio = 4.0f;
+
+		//balanced tree, height stays around 1.44 * log2(count)
+		constexpr u32 MaxStackSize = 256;
+
+		SK_FINLINE AABB Union(const AABB& a, const AABB& b)
+		{
+			return AABB{Vec3::Min(a.min, b.min), Vec3::Max(a.max, b.max)};
+		}
+
+		SK_FINLINE f32 Area(const AABB& aabb)
+		{
+			Vec3 d = aabb.max - aabb.min;
+			return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+		}
+
+		SK_FINLINE AABB Enlarge(const AABB& aabb)
+		{
+			Vec3 margin = (aabb.max - aabb.min) * FatMarginScale + FatMarginMin;
+			return AABB{aabb.min - margin, aabb.max + margin};
+		}
+
+		SK_FINLINE bool Contains(const AABB& outer, const AABB& inner)
+		{
+			return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+				inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+		}
+
+		SK_FINLINE bool Overlaps(const AABB& a, const AABB& b)
+		{
+			return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+				a.min.y <= b.max.y && a.max.y >= b.min.y &&
+				a.min.z <= b.max.z && a.max.z >= b.min.z;
+		}
+
+		SK_FINLINE bool OverlapsSphere(const AABB& aabb, const Vec3& center, f32 radiusSquared)
+		{
+			f32 distance = 0.0f;
+			for (i32 i = 0; i < 3; ++i)
+			{
+				if (center[i] < aabb.min[i])
+				{
+					distance += (aabb.min[i] - center[i]) * (aabb.min[i] - center[i]);
+				}
+				else if (center[i] > aabb.max[i])
+				{
+					distance += (center[i] - aabb.max[i]) * (center[i] - aabb.max[i]);
+				}
+			}
+			return distance <= radiusSquared;
+		}
+
+		//slab test, distance is 0 when the origin is inside
+		SK_FINLINE bool IntersectRay(const AABB& aabb, const Vec3& origin, const Vec3& invDir, f32 maxDistance, f32& distance)
+		{
+			f32 tMin = 0.0f;
+			f32 tMax = maxDistance;
+			for (i32 i = 0; i < 3; ++i)
+			{
+				f32 t1 = (aabb.min[i] - origin[i]) * invDir[i];
+				f32 t2 = (aabb.max[i] - origin[i]) * invDir[i];
+				tMin = Math::Max(tMin, Math::Min(t1, t2));
+				tMax = Math::Min(tMax, Math::Max(t1, t2));
+			}
+			distance = tMin;
+			return tMin <= tMax;
+		}
+	}
+
+	SpatialIndex::SpatialIndex(Scene* scene) : m_scene(scene) {}
+
+	void SpatialIndex::AddEntity(Entity* entity)
+	{
+		SK_ASSERT(!m_scene->m_parallelTicking, "spatial index cannot be modified from parallel ticks");
+
+		if (auto it = m_proxyByEntity.Find(entity))
+		{
+			m_proxies[it->second].references++;
+			MarkDirty(entity);
+			return;
+		}
+
+		u32 proxyIndex = 0;
+		if (!m_freeProxies.Empty())
+		{
+			proxyIndex = m_freeProxies.Back();
+			m_freeProxies.PopBack();
+		}
+		else
+		{
+			proxyIndex = static_cast<u32>(m_proxies.Size());
+			m_proxies.EmplaceBack();
+		}
+
+		Proxy& proxy = m_proxies[proxyIndex];
+		proxy.entity = entity;
+		proxy.aabb = {};
+		proxy.layerMask = 0;
+		proxy.node = U32_MAX;
+		proxy.references = 1;
+		proxy.dirty = false;
+
+		m_proxyByEntity.Insert(entity, proxyIndex);
+		m_scene->renderObjects.trackBoundsChanges = true;
+
+		MarkDirty(entity);
+	}
+
+	void SpatialIndex::RemoveEntity(Entity* entity)
+	{
+		SK_ASSERT(!m_scene->m_parallelTicking, "spatial index cannot be modified from parallel ticks");
+
+		auto it = m_proxyByEntity.Find(entity);
+		if (it == m_proxyByEntity.end()) return;
+
+		u32    proxyIndex = it->second;
+		Proxy& proxy = m_proxies[proxyIndex];
+
+		if (--proxy.references > 0)
+		{
+			MarkDirty(entity);
+			return;
+		}
+
+		RemoveProxyNode(proxy);
+
+		//stale entries in m_dirtyProxies are skipped by the dirty flag
+		proxy.entity = nullptr;
+		proxy.dirty = false;
+
+		m_freeProxies.EmplaceBack(proxyIndex);
+		m_proxyByEntity.Erase(entity);
+	}
+
+	void SpatialIndex::MarkDirty(Entity* entity)
+	{
+		SK_ASSERT(!m_scene->m_parallelTicking, "spatial index cannot be modified from parallel ticks");
+
+		if (auto it = m_proxyByEntity.Find(entity))
+		{
+			Proxy& proxy = m_proxies[it->second];
+			if (!proxy.dirty)
+			{
+				proxy.dirty = true;
+				m_dirtyProxies.EmplaceBack(it->second);
+			}
+		}
+	}
+
+	void SpatialIndex::Flush()
+	{
+		SK_ASSERT(!m_scene->m_parallelTicking, "spatial index cannot be modified from parallel ticks");
+
+		if (m_proxyByEntity.Size() == 0) return;
+
+		//user data is the entity, untracked entities are ignored without being dereferenced
+		m_scene->renderObjects.TakeBoundsChanges(m_boundsChanges);
+		for (u64 userData : m_boundsChanges)
+		{
+			MarkDirty(static_cast<Entity*>(IntToPtr(userData)));
+		}
+
+		for (u32 proxyIndex : m_dirtyProxies)
+		{
+			if (m_proxies[proxyIndex].dirty)
+			{
+				m_proxies[proxyIndex].dirty = false;
+				UpdateProxy(proxyIndex);
+			}
+		}
+		m_dirtyProxies.Clear();
+	}
+
+	usize SpatialIndex::QueryAABB(const AABB& aabb, Span<Entity*> results, u64 layerMask) const
+	{
+		return Query(results, layerMask, [&](const AABB& bounds)
+		{
+			return Overlaps(bounds, aabb);
+		});
+	}
+
+	usize SpatialIndex::QuerySphere(const Vec3& center, f32 radius, Span<Entity*> results, u64 layerMask) const
+	{
+		f32 radiusSquared = radius * radius;
+		return Query(results, layerMask, [&](const AABB& bounds)
+		{
+			return OverlapsSphere(bounds, center, radiusSquared);
+		});
+	}
+
+	usize SpatialIndex::QueryFrustum(const Frustum& frustum, Span<Entity*> results, u64 layerMask) const
+	{
+		return Query(results, layerMask, [&](const AABB& bounds)
+		{
+			return bounds.IsOnFrustum(frustum);
+		});
+	}
+
+	usize SpatialIndex::Raycast(const Ray& ray, f32 maxDistance, Span<SpatialHit> hits, u64 layerMask) const
+	{
+		if (m_root == U32_MAX || hits.Empty()) return 0;
+
+		Vec3  invDir = Vec3{1.0f / ray.dir.x, 1.0f / ray.dir.y, 1.0f / ray.dir.z};
+		f32   limit = maxDistance;
+		usize count = 0;
+
+		u32 stack[MaxStackSize];
+		u32 stackSize = 0;
+		stack[stackSize++] = m_root;
+
+		while (stackSize > 0)
+		{
+			const Node& node = m_nodes[stack[--stackSize]];
+
+			f32 distance = 0.0f;
+			if ((node.layerMask & layerMask) == 0 || !IntersectRay(node.aabb, ray.origin, invDir, limit, distance)) continue;
+
+			if (node.left != U32_MAX)
+			{
+				SK_ASSERT(stackSize + 2 <= MaxStackSize, "spatial index stack overflow");
+				stack[stackSize++] = node.left;
+				stack[stackSize++] = node.right;
+				continue;
+			}
+
+			const Proxy& proxy = m_proxies[node.proxy];
+			if (!IntersectRay(proxy.aabb, ray.origin, invDir, limit, distance)) continue;
+
+			//sorted insert, the farthest hit is dropped when full
+			usize index = count < hits.Size() ? count++ : hits.Size() - 1;
+			while (index > 0 && hits[index - 1].distance > distance)
+			{
+				hits[index] = hits[index - 1];
+				--index;
+			}
+			hits[index] = SpatialHit{proxy.entity, distance};
+
+			if (count == hits.Size())
+			{
+				limit = hits[count - 1].distance;
+			}
+		}
+
+		return count;
+	}
+
+	AABB SpatialIndex::GetBounds() const
+	{
+		//leaves store enlarged bounds, the proxies have the exact ones
+		AABB bounds = {};
+		for (const auto& it : m_proxyByEntity)
+		{
+			const Proxy& proxy = m_proxies[it.second];
+			if (proxy.node != U32_MAX)
+			{
+				bounds.Expand(proxy.aabb);
+			}
+		}
+		return bounds;
+	}
+
+	usize SpatialIndex::GetEntityCount() const
+	{
+		return m_proxyByEntity.Size();
+	}
+
+	u32 SpatialIndex::GetHeight() const
+	{
+		return m_root != U32_MAX ? static_cast<u32>(m_nodes[m_root].height) : 0;
+	}
+
+	bool SpatialIndex::Validate() const
+	{
+		usize leafCount = 0;
+
+		if (m_root != U32_MAX)
+		{
+			if (m_nodes[m_root].parent != U32_MAX) return false;
+
+			Array<u32> stack;
+			stack.EmplaceBack(m_root);
+
+			while (!stack.Empty())
+			{
+				u32 index = stack.Back();
+				stack.PopBack();
+
+				const Node& node = m_nodes[index];
+				if (node.left == U32_MAX)
+				{
+					if (node.right != U32_MAX || node.height != 0 || node.proxy >= m_proxies.Size()) return false;
+
+					const Proxy& proxy = m_proxies[node.proxy];
+					if (proxy.entity == nullptr || proxy.node != index) return false;
+					if (node.layerMask != proxy.layerMask || !Contains(node.aabb, proxy.aabb)) return false;
+
+					leafCount++;
+					continue;
+				}
+
+				if (node.right == U32_MAX) return false;
+
+				const Node& left = m_nodes[node.left];
+				const Node& right = m_nodes[node.right];
+
+				if (left.parent != index || right.parent != index) return false;
+				if (node.height != 1 + Math::Max(left.height, right.height)) return false;
+				if (node.layerMask != (left.layerMask | right.layerMask)) return false;
+				if (!Contains(node.aabb, left.aabb) || !Contains(node.aabb, right.aabb)) return false;
+
+				stack.EmplaceBack(node.left);
+				stack.EmplaceBack(node.right);
+			}
+		}
+
+		//every proxy with a node is reachable from the root
+		usize proxyCount = 0;
+		for (const auto& it : m_proxyByEntity)
+		{
+			const Proxy& proxy = m_proxies[it.second];
+			if (proxy.entity != it.first) return false;
+			if (proxy.node != U32_MAX)
+			{
+				proxyCount++;
+			}
+		}
+
+		return leafCount == proxyCount;
+	}
+
+	template <typename Fn>
+	usize SpatialIndex::Query(Span<Entity*> results, u64 layerMask, Fn&& overlaps) const
+	{
+		if (m_root == U32_MAX || results.Empty()) return 0;
+
+		usize count = 0;
+
+		u32 stack[MaxStackSize];
+		u32 stackSize = 0;
+		stack[stackSize++] = m_root;
+
+		while (stackSize > 0 && count < results.Size())
+		{
+			const Node& node = m_nodes[stack[--stackSize]];
+			if ((node.layerMask & layerMask) == 0 || !overlaps(node.aabb)) continue;
+
+			if (node.left != U32_MAX)
+			{
+				SK_ASSERT(stackSize + 2 <= MaxStackSize, "spatial index stack overflow");
+				stack[stackSize++] = node.left;
+				stack[stackSize++] = node.right;
+				continue;
+			}
+
+			const Proxy& proxy = m_proxies[node.proxy];
+			if (overlaps(proxy.aabb))
+			{
+				results[count++] = proxy.entity;
+			}
+		}
+
+		return count;
+	}
+
+	void SpatialIndex::UpdateProxy(u32 proxyIndex)
+	{
+		Proxy& proxy = m_proxies[proxyIndex];
+
+		AABB aabb = {};
+		if (proxy.entity->IsActive())
+		{
+			EntityEventDesc event;
+			event.type = EntityEventType::CalculateEntityAABB;
+			event.eventData = &aabb;
+			proxy.entity->NotifyEvent(event, false);
+		}
+
+		//inactive or mesh not loaded yet, the renderer reports the aabb when it's available
+		if (!aabb)
+		{
+			RemoveProxyNode(proxy);
+			return;
+		}
+
+		proxy.aabb = aabb;
+
+		u64 layerMask = proxy.entity->GetLayerMask();
+		if (proxy.node != U32_MAX)
+		{
+			const AABB& fatAabb = m_nodes[proxy.node].aabb;
+			if (layerMask == proxy.layerMask && Contains(fatAabb, aabb) && Area(fatAabb) <= Area(Enlarge(aabb)) * FatAreaRatio)
+			{
+				return;
+			}
+			RemoveLeaf(proxy.node);
+		}
+		else
+		{
+			proxy.node = AllocateNode();
+		}
+
+		proxy.layerMask = layerMask;
+
+		Node& node = m_nodes[proxy.node];
+		node.aabb = Enlarge(aabb);
+		node.layerMask = layerMask;
+		node.left = U32_MAX;
+		node.right = U32_MAX;
+		node.proxy = proxyIndex;
+		node.height = 0;
+
+		InsertLeaf(proxy.node);
+	}
+
+	void SpatialIndex::RemoveProxyNode(Proxy& proxy)
+	{
+		if (proxy.node != U32_MAX)
+		{
+			RemoveLeaf(proxy.node);
+			FreeNode(proxy.node);
+			proxy.node = U32_MAX;
+		}
+	}
+
+	u32 SpatialIndex::AllocateNode()
+	{
+		if (!m_freeNodes.Empty())
+		{
+			u32 index = m_freeNodes.Back();
+			m_freeNodes.PopBack();
+			return index;
+		}
+		m_nodes.EmplaceBack();
+		return static_cast<u32>(m_nodes.Size() - 1);
+	}
+
+	void SpatialIndex::FreeNode(u32 index)
+	{
+		m_nodes[index].height = -1;
+		m_freeNodes.EmplaceBack(index);
+	}
+
+	void SpatialIndex::InsertLeaf(u32 leaf)
+	{
+		if (m_root == U32_MAX)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = U32_MAX;
+			return;
+		}
+
+		//descends while pushing the leaf into a child is cheaper than pairing it with the current node
+		AABB leafAabb = m_nodes[leaf].aabb;
+		u32  index = m_root;
+
+		auto childCost = [&](u32 child)
+		{
+			f32 area = Area(Union(m_nodes[child].aabb, leafAabb));
+			return m_nodes[child].left == U32_MAX ? area : area - Area(m_nodes[child].aabb);
+		};
+
+		while (m_nodes[index].left != U32_MAX)
+		{
+			const Node& node = m_nodes[index];
+
+			f32 combinedArea = Area(Union(node.aabb, leafAabb));
+			f32 cost = 2.0f * combinedArea;
+			f32 inheritanceCost = 2.0f * (combinedArea - Area(node.aabb));
+
+			f32 leftCost = childCost(node.left) + inheritanceCost;
+			f32 rightCost = childCost(node.right) + inheritanceCost;
+
+			if (cost < leftCost && cost < rightCost) break;
+
+			index = leftCost < rightCost ? node.left : node.right;
+		}
+
+		u32 sibling = index;
+		u32 oldParent = m_nodes[sibling].parent;
+		u32 newParent = AllocateNode();
+
+		Node& parentNode = m_nodes[newParent];
+		parentNode.parent = oldParent;
+		parentNode.left = sibling;
+		parentNode.right = leaf;
+		parentNode.proxy = U32_MAX;
+
+		if (oldParent != U32_MAX)
+		{
+			if (m_nodes[oldParent].left == sibling)
+			{
+				m_nodes[oldParent].left = newParent;
+			}
+			else
+			{
+				m_nodes[oldParent].right = newParent;
+			}
+		}
+		else
+		{
+			m_root = newParent;
+		}
+
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		Refit(newParent);
+	}
+
+	void SpatialIndex::RemoveLeaf(u32 leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = U32_MAX;
+			return;
+		}
+
+		u32 parent = m_nodes[leaf].parent;
+		u32 grandParent = m_nodes[parent].parent;
+		u32 sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+		m_nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		if (grandParent != U32_MAX)
+		{
+			if (m_nodes[grandParent].left == parent)
+			{
+				m_nodes[grandParent].left = sibling;
+			}
+			else
+			{
+				m_nodes[grandParent].right = sibling;
+			}
+			Refit(grandParent);
+		}
+		else
+		{
+			m_root = sibling;
+		}
+	}
+
+	void SpatialIndex::Refit(u32 index)
+	{
+		while (index != U32_MAX)
+		{
+			index = Balance(index);
+			UpdateNode(index);
+			index = m_nodes[index].parent;
+		}
+	}
+
+	void SpatialIndex::UpdateNode(u32 index)
+	{
+		Node&       node = m_nodes[index];
+		const Node& left = m_nodes[node.left];
+		const Node& right = m_nodes[node.right];
+
+		node.aabb = Union(left.aabb, right.aabb);
+		node.layerMask = left.layerMask | right.layerMask;
+		node.height = 1 + Math::Max(left.height, right.height);
+	}
+
+	//rotates the taller child up when the heights of the children differ by more than one, returns the new subtree root
+	u32 SpatialIndex::Balance(u32 a)
+	{
+		if (m_nodes[a].left == U32_MAX || m_nodes[a].height < 2)
+		{
+			return a;
+		}
+
+		u32 b = m_nodes[a].left;
+		u32 c = m_nodes[a].right;
+		i32 balance = m_nodes[c].height - m_nodes[b].height;
+
+		if (balance > 1 || balance < -1)
+		{
+			//up is the child being rotated up, a keeps the other child and takes the shorter grandchild
+			u32 up = balance > 1 ? c : b;
+			u32 f = m_nodes[up].left;
+			u32 g = m_nodes[up].right;
+
+			u32 parent = m_nodes[a].parent;
+			m_nodes[up].parent = parent;
+			m_nodes[a].parent = up;
+
+			if (parent != U32_MAX)
+			{
+				if (m_nodes[parent].left == a)
+				{
+					m_nodes[parent].left = up;
+				}
+				else
+				{
+					m_nodes[parent].right = up;
+				}
+			}
+			else
+			{
+				m_root = up;
+			}
+
+			u32 taller = m_nodes[f].height > m_nodes[g].height ? f : g;
+			u32 shorter = taller == f ? g : f;
+
+			m_nodes[up].left = a;
+			m_nodes[up].right = taller;
+
+			if (up == c)
+			{
+				m_nodes[a].right = shorter;
+			}
+			else
+			{
+				m_nodes[a].left = shorter;
+			}
+			m_nodes[shorter].parent = a;
+
+			UpdateNode(a);
+			UpdateNode(up);
+			return up;
+		}
+
+		return a;
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "SceneCommon.hpp"
+#include "Skore/Common.hpp"
+#include "Skore/Core/Array.hpp"
+#include "Skore/Core/HashMap.hpp"
+#include "Skore/Core/Math.hpp"
+#include "Skore/Core/Span.hpp"
+
+namespace Skore
+{
+	class Entity;
+	class Scene;
+
+	struct SpatialHit
+	{
+		Entity* entity = nullptr;
+		f32     distance = 0.0f;
+	};
+
+	// Dynamic aabb tree (incremental BVH) with the bounds of the scene entities that have renderers.
+	// Leaves are stored enlarged so small movements don't touch the tree, results are tested against the exact bounds.
+	// Renderer aabb, visibility and layer changes are collected from RenderSceneObjects and applied on Flush.
+	// Scene::Update flushes once before OnUpdate, queries are read-only and see the tree of the last flush,
+	// so they can run from parallel ticks. Adding, removing, marking and flushing can't.
+	// Queries write up to results.Size() entities and return how many were written, they don't allocate.
+	class SK_API SpatialIndex
+	{
+	public:
+		SK_NO_COPY_CONSTRUCTOR(SpatialIndex);
+
+		explicit SpatialIndex(Scene* scene);
+
+		//counted, each renderer of the entity adds one reference
+		void AddEntity(Entity* entity);
+		void RemoveEntity(Entity* entity);
+		void MarkDirty(Entity* entity);
+		void Flush();
+
+		usize QueryAABB(const AABB& aabb, Span<Entity*> results, u64 layerMask = AllLayersMask) const;
+		usize QuerySphere(const Vec3& center, f32 radius, Span<Entity*> results, u64 layerMask = AllLayersMask) const;
+		usize QueryFrustum(const Frustum& frustum, Span<Entity*> results, u64 layerMask = AllLayersMask) const;
+
+		//closest hits against the entity bounds sorted by distance, ray.dir must be normalized
+		usize Raycast(const Ray& ray, f32 maxDistance, Span<SpatialHit> hits, u64 layerMask = AllLayersMask) const;
+
+		//union of the exact bounds of the entities in the tree
+		AABB GetBounds() const;
+
+		usize GetEntityCount() const;
+		u32   GetHeight() const;
+
+		//checks links, heights, layer masks and that every node contains its children, used by tests
+		bool Validate() const;
+
+	private:
+		struct Node
+		{
+			AABB aabb;
+			u64  layerMask;
+			u32  parent;
+			u32  left;
+			u32  right;
+			u32  proxy; //leaves only
+			i32  height;
+		};
+
+		struct Proxy
+		{
+			Entity* entity;
+			AABB    aabb;
+			u64     layerMask;
+			u32     node;
+			u32     references;
+			bool    dirty;
+		};
+
+		Scene*                m_scene = nullptr;
+		Array<Node>           m_nodes;
+		Array<u32>            m_freeNodes;
+		Array<Proxy>          m_proxies;
+		Array<u32>            m_freeProxies;
+		HashMap<Entity*, u32> m_proxyByEntity;
+		Array<u32>            m_dirtyProxies;
+		Array<u64>            m_boundsChanges;
+		u32                   m_root = U32_MAX;
+
+		u32  AllocateNode();
+		void FreeNode(u32 index);
+		void InsertLeaf(u32 leaf);
+		void RemoveLeaf(u32 leaf);
+		u32  Balance(u32 index);
+		void Refit(u32 index);
+		void UpdateNode(u32 index);
+		void UpdateProxy(u32 proxyIndex);
+		void RemoveProxyNode(Proxy& proxy);
+
+		template <typename Fn>
+		usize Query(Span<Entity*> results, u64 layerMask, Fn&& overlaps) const;
+	};
+}
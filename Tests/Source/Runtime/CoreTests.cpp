@@ -5,8 +5,11 @@
 #include "doctest.h"
 #include "Skore/Core/Array.hpp"
 #include "Skore/Core/Event.hpp"
+#include "Skore/Core/FlatHashMap.hpp"
 #include "Skore/Core/HashMap.hpp"
 #include "Skore/Core/HashSet.hpp"
+#include "Skore/Core/JobSystem.hpp"
+#include "Skore/Core/Math.hpp"
 #include "Skore/Core/Queue.hpp"
 #include "Skore/Core/Serialization.hpp"
 #include "Skore/Core/Span.hpp"
@@ -16,6 +19,9 @@
 
 #include <vector>
 #include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
 
 using namespace Skore;
 
@@ -432,6 +438,161 @@ namespace
 		CHECK(map.Has("AAA"));
 	}
 
+	TEST_CASE("Core::FlatHashMapBasics")
+	{
+		FlatHashMap<int, int> map{};
+		CHECK(map.Empty());
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			CHECK(map.Insert(i, i * 100).second);
+		}
+
+		CHECK(map.Size() == 1000);
+		CHECK(!map.Insert(10, 0).second);
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			auto it = map.Find(i);
+			REQUIRE(it != map.end());
+			CHECK(it->second == i * 100);
+		}
+
+		CHECK(!map.Has(1000));
+
+		usize count = 0;
+		for (auto& it : map)
+		{
+			CHECK(it.second == it.first * 100);
+			count++;
+		}
+		CHECK(count == 1000);
+
+		//const maps give const iterators, iterators convert to them
+		const FlatHashMap<int, int>& constMap = map;
+		FlatHashMap<int, int>::ConstIterator constIt = constMap.Find(10);
+		REQUIRE(constIt != constMap.end());
+		CHECK(constIt == FlatHashMap<int, int>::ConstIterator{map.Find(10)});
+		static_assert(std::is_same_v<decltype(constIt.operator->()), const Pair<int, int>*>);
+
+		count = 0;
+		for (const auto& it : constMap)
+		{
+			count += it.second == it.first * 100;
+		}
+		CHECK(count == 1000);
+	}
+
+	TEST_CASE("Core::FlatHashMapErase")
+	{
+		FlatHashMap<u64, u64> map{};
+
+		//insert/erase churn leaves deleted slots behind, capacity must stay bounded
+		for (u64 i = 0; i < 100000; ++i)
+		{
+			map.Insert(i, i);
+			if (i >= 100)
+			{
+				map.Erase(i - 100);
+			}
+		}
+
+		CHECK(map.Size() == 100);
+		CHECK(map.Capacity() <= 256);
+
+		for (u64 i = 99900; i < 100000; ++i)
+		{
+			REQUIRE(map.Find(i) != map.end());
+		}
+
+		for (auto it = map.begin(); it != map.end(); ++it)
+		{
+			if (it->first % 2 == 0)
+			{
+				map.Erase(it);
+			}
+		}
+
+		CHECK(map.Size() == 50);
+		for (auto& it : map)
+		{
+			CHECK(it.first % 2 == 1);
+		}
+	}
+
+	TEST_CASE("Core::FlatHashMapStr")
+	{
+		FlatHashMap<String, String> map{};
+		map["AAAA"] = "BBBB";
+		map.Emplace("CCCC", "DDDD");
+
+		for (int i = 0; i < 10000; ++i)
+		{
+			std::string str = std::to_string(i);
+			map.Insert(String{str.c_str()}, String{str.c_str()});
+		}
+
+		StringView strView = {"AAAA"};
+		auto       it = map.Find(strView);
+		REQUIRE(it != map.end());
+		CHECK(it->second == "BBBB");
+
+		CHECK(map.Has(StringView{"CCCC"}));
+		map.Erase(StringView{"CCCC"});
+		CHECK(!map.Has(StringView{"CCCC"}));
+
+		FlatHashMap<String, String> copy = map;
+		CHECK(copy.Size() == map.Size());
+		CHECK(copy.Find("9999")->second == "9999");
+
+		FlatHashMap<String, String> moved = Traits::Move(copy);
+		CHECK(moved.Size() == map.Size());
+		CHECK(copy.Empty());
+	}
+
+	template <typename Map>
+	f64 HashMapBenchmark(u64 count)
+	{
+		auto begin = std::chrono::steady_clock::now();
+
+		Map map{};
+		for (u64 i = 0; i < count; ++i)
+		{
+			map.Insert(i * 7919, i);
+		}
+
+		u64 sum = 0;
+		for (u32 round = 0; round < 10; ++round)
+		{
+			for (u64 i = 0; i < count * 2; ++i)
+			{
+				if (auto it = map.Find(i * 7919))
+				{
+					sum += it->second;
+				}
+			}
+		}
+
+		for (u64 i = 0; i < count; i += 2)
+		{
+			map.Erase(i * 7919);
+		}
+
+		CHECK(sum > 0);
+		return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	}
+
+	//run with --no-skip
+	TEST_CASE("Core::FlatHashMapBenchmark" * doctest::skip())
+	{
+		for (u64 count : {1000ull, 100000ull, 1000000ull})
+		{
+			f64 hashMap = HashMapBenchmark<HashMap<u64, u64>>(count);
+			f64 flatHashMap = HashMapBenchmark<FlatHashMap<u64, u64>>(count);
+			MESSAGE("entries: " << count << " HashMap: " << hashMap << "ms FlatHashMap: " << flatHashMap << "ms");
+		}
+	}
+
 	TEST_CASE("TestString_Constructor")
 	{
 		{
@@ -1344,4 +1505,224 @@ namespace
 		CHECK(foundValue);
 		CHECK(foundBlob);
 	}
+
+	TEST_CASE("Core::JobSystemScheduleAndWait")
+	{
+		std::atomic<u32> value = 0;
+
+		Array<JobHandle> handles;
+		for (u32 i = 0; i < 1000; ++i)
+		{
+			handles.EmplaceBack(JobSystem::Schedule([&value]
+			{
+				value.fetch_add(1);
+			}));
+		}
+
+		for (JobHandle handle : handles)
+		{
+			JobSystem::Wait(handle);
+			CHECK(JobSystem::IsCompleted(handle));
+		}
+
+		CHECK(value.load() == 1000);
+	}
+
+	TEST_CASE("Core::JobSystemParentAndContinuations")
+	{
+		std::atomic<u32> children = 0;
+		u32              childrenOnContinuation = 0;
+
+		JobHandle parent = JobSystem::Create([] {});
+		for (u32 i = 0; i < 64; ++i)
+		{
+			JobSystem::Run(JobSystem::Create([&children]
+			{
+				children.fetch_add(1);
+			}, parent));
+		}
+
+		JobHandle continuation = JobSystem::Create([&]
+		{
+			childrenOnContinuation = children.load();
+		});
+
+		JobSystem::AddContinuation(parent, continuation);
+		JobSystem::Run(continuation);
+		JobSystem::Run(parent);
+
+		JobSystem::Wait(continuation);
+		CHECK(childrenOnContinuation == 64);
+
+		// stale handles are reported as completed
+		JobHandle late = JobSystem::Create([] {});
+		JobSystem::AddContinuation(parent, late);
+		JobSystem::Run(late);
+		JobSystem::Wait(late);
+		CHECK(JobSystem::IsCompleted(late));
+	}
+
+	TEST_CASE("Core::JobSystemParallelFor")
+	{
+		Array<u32> values(10000, 0);
+		JobSystem::ParallelFor(values.Size(), 128, [&](u32 index)
+		{
+			values[index] = index * 2;
+		});
+
+		bool valid = true;
+		for (u32 i = 0; i < values.Size(); ++i)
+		{
+			valid &= values[i] == i * 2;
+		}
+		CHECK(valid);
+	}
+
+	namespace
+	{
+		bool ApproxEqual(const f32* a, const f32* b, u32 count, f32 epsilon)
+		{
+			for (u32 i = 0; i < count; ++i)
+			{
+				if (std::abs(a[i] - b[i]) > epsilon * std::max(1.0f, std::abs(b[i])))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+
+	TEST_CASE("Core::MathSimdMatchesScalar")
+	{
+		std::mt19937                        rng(42);
+		std::uniform_real_distribution<f32> dist(-2.0f, 2.0f);
+
+		auto randomQuat = [&]
+		{
+			return Quat::Normalized(Quat{dist(rng), dist(rng), dist(rng), dist(rng)});
+		};
+
+		bool mul = true, mulVec = true, inverse = true, slerp = true, toMatrix = true;
+
+		for (u32 i = 0; i < 1000; ++i)
+		{
+			Mat4 a, b;
+			for (u32 e = 0; e < 16; ++e)
+			{
+				a.a[e] = dist(rng);
+				b.a[e] = dist(rng);
+			}
+			Vec4 v{dist(rng), dist(rng), dist(rng), dist(rng)};
+
+			Mat4 ab = a * b;
+			Mat4 abScalar = MathScalar::Mul(a, b);
+			mul &= ApproxEqual(ab.a, abScalar.a, 16, 1e-5f);
+
+			Vec4 av = a * v;
+			Vec4 avScalar = MathScalar::Mul(a, v);
+			mulVec &= ApproxEqual(av.c, avScalar.c, 4, 1e-5f);
+
+			Quat q0 = randomQuat();
+			Quat q1 = randomQuat();
+
+			Mat4 transform = Mat4::Translate(Vec3{dist(rng), dist(rng), dist(rng)}) * Quat::ToMatrix4(q0);
+			Mat4 inv = Mat4::Inverse(transform);
+			Mat4 invScalar = MathScalar::Inverse(transform);
+			inverse &= ApproxEqual(inv.a, invScalar.a, 16, 1e-4f);
+
+			f32  t = (dist(rng) + 2.0f) / 4.0f;
+			Quat s = Quat::Slerp(q0, q1, t);
+			Quat sScalar = MathScalar::Slerp(q0, q1, t);
+			slerp &= ApproxEqual(s.c, sScalar.c, 4, 1e-5f);
+
+			Mat4 m = Quat::ToMatrix4(q1);
+			Mat4 mScalar = MathScalar::ToMatrix4(q1);
+			toMatrix &= ApproxEqual(m.a, mScalar.a, 16, 1e-5f);
+		}
+
+		CHECK(mul);
+		CHECK(mulVec);
+		CHECK(inverse);
+		CHECK(slerp);
+		CHECK(toMatrix);
+	}
+
+	TEST_CASE("Core::FrameAllocator")
+	{
+		Allocator* allocator = MemoryGlobals::GetFrameAllocator();
+
+		Array<u32> copy;
+		String     strCopy;
+
+		{
+			Array<u32> values(allocator);
+			for (u32 i = 0; i < 100000; ++i)
+			{
+				values.EmplaceBack(i);
+			}
+
+			String str(allocator);
+			for (u32 i = 0; i < 1000; ++i)
+			{
+				str += "frame";
+			}
+
+			// the last allocation is resized in place
+			VoidPtr ptr = allocator->MemAlloc(allocator->allocator, 64);
+			CHECK(allocator->MemRealloc(allocator->allocator, ptr, 128) == ptr);
+
+			// memory stays valid until the end of the next frame
+			MemoryGlobals::ResetFrameAllocator();
+			CHECK(MemoryGlobals::GetFrameAllocatorStats().used >= values.Size() * sizeof(u32));
+
+			Array<u32> next(allocator, 1000);
+
+			bool valid = true;
+			for (u32 i = 0; i < values.Size(); ++i)
+			{
+				valid &= values[i] == i;
+			}
+			CHECK(valid);
+			CHECK(str.Size() == 5000);
+
+			// copies keep the frame allocator, CopyFromFrame moves the data out of it
+			Array<u32> frameCopy = values;
+			CHECK(frameCopy.Size() == values.Size());
+			CHECK(frameCopy[99999] == 99999);
+
+			copy = CopyFromFrame(values);
+			strCopy = CopyFromFrame(str);
+		}
+
+		MemoryGlobals::ResetFrameAllocator();
+		MemoryGlobals::ResetFrameAllocator();
+
+		Array<u32> reused(allocator, 100000);
+		for (u32& value : reused)
+		{
+			value = 0;
+		}
+
+		CHECK(copy.Size() == 100000);
+		CHECK(copy[99999] == 99999);
+		CHECK(strCopy.Size() == 5000);
+		CHECK(MemoryGlobals::GetFrameAllocatorStats().reserved > 0);
+	}
+
+	TEST_CASE("Core::RandomSeed")
+	{
+		Random::SetSeed(1234);
+		u64 first = Random::Xorshift64star();
+		u64 firstUInt = Random::NextUInt(1000);
+		f32 firstFloat = Random::NextFloat32(0.0f, 1.0f);
+
+		Random::SetSeed(1234);
+		CHECK(Random::Xorshift64star() == first);
+		CHECK(Random::NextUInt(1000) == firstUInt);
+		CHECK(Random::NextFloat32(0.0f, 1.0f) == firstFloat);
+
+		Random::SetSeed(0);
+		CHECK(Random::Xorshift64star() != 0);
+	}
 }
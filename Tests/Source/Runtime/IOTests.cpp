@@ -1,9 +1,28 @@
 
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <doctest.h>
+#include <SDL3/SDL.h>
+#include "Skore/App.hpp"
+#include "Skore/IO/Compression.hpp"
+#include "Skore/IO/FileSystem.hpp"
+#include "Skore/IO/Input.hpp"
 #include "Skore/IO/Path.hpp"
+#include "Skore/Resource/ResourceBuffer.hpp"
 
 using namespace Skore;
 
+namespace Skore
+{
+	void SK_API FileSystemInit();
+	void SK_API FileSystemShutdown();
+	void SK_API InputInit();
+	void SK_API InputHandlerEvents(SDL_Event* event);
+	void SK_API InputOnBeginFrame();
+	void SK_API InputOnEndFrame();
+}
+
 namespace
 {
 	TEST_CASE("IO::PathBasics")
@@ -34,4 +53,400 @@ namespace
 		CHECK(Path::Name(file) == "Leaf");
 		CHECK(Path::Parent(file) == parent);
 	}
-}
\ No newline at end of file
+
+	TEST_CASE("IO::ReadFileAsync")
+	{
+		String path = Path::Join(FileSystem::CurrentDir(), "ReadFileAsync.bin");
+
+		constexpr usize blockSize = 4096;
+		constexpr usize blockCount = 300;
+
+		Array<u8> data;
+		data.Resize(blockSize * blockCount);
+		for (usize i = 0; i < data.Size(); ++i)
+		{
+			data[i] = static_cast<u8>((i * 31) ^ (i >> 12));
+		}
+		FileSystem::SaveFileAsByteArray(path, data);
+
+		FileHandler fileHandler = FileSystem::OpenFile(path, AccessMode::ReadOnly);
+		REQUIRE(fileHandler);
+
+		Array<u8> result;
+		result.Resize(data.Size());
+
+		//blocks in reverse order, more requests than the reads that can be in flight
+		Array<FileReadRequest> requests;
+		for (usize i = 0; i < blockCount; ++i)
+		{
+			usize block = blockCount - i - 1;
+			requests.EmplaceBack(FileReadRequest{
+				.fileHandler = fileHandler,
+				.offset = block * blockSize,
+				.size = blockSize,
+				.data = result.Data() + block * blockSize
+			});
+		}
+
+		//reads past the end of the file are short, invalid handlers read nothing
+		u8 tail[blockSize];
+		requests.EmplaceBack(FileReadRequest{fileHandler, data.Size() - 100, blockSize, tail});
+		requests.EmplaceBack(FileReadRequest{FileHandler{}, 0, blockSize, tail});
+
+		std::atomic<u32> callbacks{0};
+		FileReadHandler  handler = FileSystem::ReadFileAsync(requests, [](const FileReadRequest& request, u64 bytesRead, VoidPtr userData)
+		{
+			static_cast<std::atomic<u32>*>(userData)->fetch_add(1);
+		}, &callbacks);
+
+		CHECK(FileSystem::WaitFileRead(handler) == data.Size() + 100);
+		CHECK(callbacks.load() == requests.Size());
+		CHECK(result == data);
+		CHECK(memcmp(tail, data.Data() + data.Size() - 100, 100) == 0);
+
+		CHECK(FileSystem::WaitFileRead(FileSystem::ReadFileAsync({})) == 0);
+
+		FileSystem::CloseFile(fileHandler);
+		FileSystem::Remove(path);
+	}
+
+	TEST_CASE("IO::ReadFileAsyncAfterShutdown")
+	{
+		String path = Path::Join(FileSystem::CurrentDir(), "ReadFileAsyncAfterShutdown.bin");
+
+		Array<u8> data;
+		data.Resize(8192);
+		for (usize i = 0; i < data.Size(); ++i)
+		{
+			data[i] = static_cast<u8>(i * 7);
+		}
+		FileSystem::SaveFileAsByteArray(path, data);
+
+		//resource buffers read all the copies of a batch together
+		ResourceBuffer buffer(1);
+		buffer.MapFile(path, true, 1024, 4096);
+
+		u8                 first[512];
+		u8                 second[256];
+		ResourceBufferCopy copies[] = {
+			{first, sizeof(first), 0},
+			{second, sizeof(second), 2048}
+		};
+		CHECK(buffer.CopyData(Span<ResourceBufferCopy>(copies, 2)) == sizeof(first) + sizeof(second));
+		CHECK(memcmp(first, data.Data() + 1024, sizeof(first)) == 0);
+		CHECK(memcmp(second, data.Data() + 1024 + 2048, sizeof(second)) == 0);
+
+		//no io threads are started after shutdown, the requests are read before returning
+		FileSystemShutdown();
+
+		FileHandler fileHandler = FileSystem::OpenFile(path, AccessMode::ReadOnly);
+		REQUIRE(fileHandler);
+
+		Array<u8>       result;
+		result.Resize(data.Size());
+		FileReadRequest requests[] = {
+			{fileHandler, 0, 4096, result.Data()},
+			{fileHandler, 4096, 4096, result.Data() + 4096}
+		};
+		FileReadHandler handler = FileSystem::ReadFileAsync(Span<FileReadRequest>(requests, 2));
+		CHECK(FileSystem::IsFileReadCompleted(handler));
+		CHECK(FileSystem::WaitFileRead(handler) == data.Size());
+		CHECK(result == data);
+
+		FileSystem::CloseFile(fileHandler);
+		FileSystemInit();
+
+		FileSystem::Remove(path);
+	}
+
+	struct InputFrameState
+	{
+		bool keyA;
+		bool keyB;
+		bool mouseLeft;
+		Vec2 mousePosition;
+		Vec2 mouseWheel;
+
+		bool operator==(const InputFrameState& other) const
+		{
+			return keyA == other.keyA && keyB == other.keyB && mouseLeft == other.mouseLeft &&
+				mousePosition.x == other.mousePosition.x && mousePosition.y == other.mousePosition.y &&
+				mouseWheel.x == other.mouseWheel.x && mouseWheel.y == other.mouseWheel.y;
+		}
+	};
+
+	//live events of each frame, as App::Run polls them before the update
+	void FeedInputEvents(u32 frame)
+	{
+		SDL_Event event{};
+		switch (frame)
+		{
+			case 0:
+				event.type = SDL_EVENT_KEY_DOWN;
+				event.key.scancode = SDL_SCANCODE_A;
+				InputHandlerEvents(&event);
+				event = {};
+				event.type = SDL_EVENT_MOUSE_MOTION;
+				event.motion.x = 10.0f;
+				event.motion.y = 20.0f;
+				event.motion.xrel = 1.0f;
+				event.motion.yrel = 2.0f;
+				InputHandlerEvents(&event);
+				break;
+			case 2:
+				event.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+				event.button.button = SDL_BUTTON_LEFT;
+				InputHandlerEvents(&event);
+				event = {};
+				event.type = SDL_EVENT_TEXT_INPUT;
+				event.text.text = "skore";
+				InputHandlerEvents(&event);
+				break;
+			case 3:
+				event.type = SDL_EVENT_KEY_UP;
+				event.key.scancode = SDL_SCANCODE_A;
+				InputHandlerEvents(&event);
+				event = {};
+				event.type = SDL_EVENT_MOUSE_WHEEL;
+				event.wheel.y = 1.0f;
+				InputHandlerEvents(&event);
+				break;
+			default:
+				//pressed and released before the update, recorded but no state change
+				event.type = SDL_EVENT_KEY_DOWN;
+				event.key.scancode = SDL_SCANCODE_B;
+				InputHandlerEvents(&event);
+				event.type = SDL_EVENT_KEY_UP;
+				InputHandlerEvents(&event);
+				break;
+		}
+	}
+
+	InputFrameState RunInputFrame()
+	{
+		InputOnBeginFrame();
+		InputFrameState state{
+			.keyA = Input::IsKeyDown(Key::A),
+			.keyB = Input::IsKeyDown(Key::B),
+			.mouseLeft = Input::IsMouseDown(MouseButton::Left),
+			.mousePosition = Input::GetMousePosition(),
+			.mouseWheel = Input::GetMouseWheel()
+		};
+		InputOnEndFrame();
+		return state;
+	}
+
+	TEST_CASE("IO::InputRecordReplay")
+	{
+		InputInit();
+
+		String path = Path::Join(FileSystem::CurrentDir(), "InputRecordReplay.skir");
+
+		constexpr u32 frameCount = 6;
+
+		REQUIRE(Input::StartRecording(path));
+		CHECK(Input::IsRecording());
+		CHECK(!Input::StartReplay(path));
+
+		Array<InputFrameState> recorded;
+		for (u32 frame = 0; frame < frameCount; ++frame)
+		{
+			FeedInputEvents(frame);
+			recorded.EmplaceBack(RunInputFrame());
+		}
+		Input::StopRecording();
+		CHECK(!Input::IsRecording());
+
+		CHECK(recorded[0].keyA);
+		CHECK(recorded[2].mouseLeft);
+		CHECK(!recorded[3].keyA);
+		CHECK(recorded[3].mouseWheel.y == 1.0f);
+
+		//header layout of the stream, followed by the events and the text
+		struct RecordHeader
+		{
+			u32 magic;
+			u32 version;
+			u32 tickRate;
+			u32 frameCount;
+			u64 randomSeed;
+			u64 eventCount;
+			u64 textSize;
+		};
+
+		Array<u8> bytes;
+		FileSystem::ReadFileAsByteArray(path, bytes);
+		REQUIRE(bytes.Size() > sizeof(RecordHeader));
+		CHECK(memcmp(bytes.Data(), "SKIR", 4) == 0);
+
+		RecordHeader header{};
+		memcpy(&header, bytes.Data(), sizeof(RecordHeader));
+		CHECK(header.version == 1);
+		CHECK(header.tickRate == App::GetTickRate());
+		CHECK(header.randomSeed == App::GetRandomSeed());
+		CHECK(header.frameCount == frameCount);
+		CHECK(header.textSize == 5);
+		CHECK(memcmp(bytes.Data() + bytes.Size() - 5, "skore", 5) == 0);
+
+		//initial mouse position, 2 events on frames 0, 2 and 3, and 2 key events on frames 1, 4 and 5
+		u64 eventCount = 1 + 2 + 2 + 2 + 6;
+		CHECK(header.eventCount == eventCount);
+		REQUIRE(header.eventCount > 0);
+		CHECK((bytes.Size() - sizeof(RecordHeader) - header.textSize) % header.eventCount == 0);
+
+		//the event stream is fed at the same frame offsets, live input is ignored while replaying
+		REQUIRE(Input::StartReplay(path));
+		CHECK(Input::IsReplaying());
+		CHECK(!Input::StartRecording(path));
+		CHECK(!Input::IsKeyDown(Key::A));
+
+		for (u32 frame = 0; frame < frameCount; ++frame)
+		{
+			SDL_Event live{};
+			live.type = SDL_EVENT_KEY_DOWN;
+			live.key.scancode = SDL_SCANCODE_B;
+			InputHandlerEvents(&live);
+
+			CHECK(RunInputFrame() == recorded[frame]);
+		}
+
+		//finishes on the frame after the last recorded one
+		InputOnBeginFrame();
+		InputOnEndFrame();
+		CHECK(!Input::IsReplaying());
+
+		FileSystem::Remove(path);
+	}
+
+	Array<u8> CompressionRoundTrip(Span<u8> data, CompressionMode mode, i32 level)
+	{
+		Array<u8> compressed;
+		compressed.Resize(Compression::GetMaxCompressedBufferSize(data.Size(), mode));
+		usize compressedSize = Compression::Compress(compressed.Data(), compressed.Size(), data.Data(), data.Size(), mode, level);
+		CHECK(compressedSize > 0);
+		compressed.Resize(compressedSize);
+
+		Array<u8> result;
+		result.Resize(data.Size());
+		CHECK(Compression::Decompress(result.Data(), result.Size(), compressed.Data(), compressed.Size(), mode) == data.Size());
+		CHECK(result == Array<u8>(data));
+		return compressed;
+	}
+
+	TEST_CASE("IO::CompressionLZ4")
+	{
+		Array<u8> text;
+		for (u32 i = 0; i < 2000; ++i)
+		{
+			const char* word = i % 7 == 0 ? "texture " : (i % 3 == 0 ? "mesh " : "mip ");
+			text.Insert(text.end(), reinterpret_cast<const u8*>(word), reinterpret_cast<const u8*>(word) + strlen(word));
+		}
+
+		//runs of repeated bytes and short periods decode as overlapping matches
+		Array<u8> runs;
+		for (u32 i = 0; i < 100000; ++i)
+		{
+			runs.EmplaceBack(static_cast<u8>(i < 50000 ? 7 : (i % 3) * 40));
+		}
+
+		Array<u8> noise;
+		u32       seed = 12345;
+		for (u32 i = 0; i < 70000; ++i)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			noise.EmplaceBack(static_cast<u8>(seed >> 24));
+		}
+
+		u8 small[] = {1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3, 1};
+
+		for (i32 level : {1, CompressionLZ4HCLevel})
+		{
+			CHECK(CompressionRoundTrip(text, CompressionMode::LZ4, level).Size() < text.Size() / 4);
+			CHECK(CompressionRoundTrip(runs, CompressionMode::LZ4, level).Size() < runs.Size() / 50);
+			CompressionRoundTrip(noise, CompressionMode::LZ4, level);
+			CompressionRoundTrip(Span<u8>(small, 5), CompressionMode::LZ4, level);
+			CompressionRoundTrip(Span<u8>(small, sizeof(small)), CompressionMode::LZ4, level);
+		}
+
+		CHECK(CompressionRoundTrip(text, CompressionMode::LZ4, CompressionLZ4HCLevel).Size() <= CompressionRoundTrip(text, CompressionMode::LZ4, 1).Size());
+
+		//output that doesn't fit fails instead of truncating
+		Array<u8> tooSmall;
+		tooSmall.Resize(noise.Size() / 2);
+		CHECK(Compression::Compress(tooSmall.Data(), tooSmall.Size(), noise.Data(), noise.Size(), CompressionMode::LZ4) == 0);
+
+		//corrupted data never writes out of bounds
+		Array<u8> compressed = CompressionRoundTrip(text, CompressionMode::LZ4, 1);
+		Array<u8> result;
+		result.Resize(text.Size());
+		CHECK(Compression::Decompress(result.Data(), result.Size() - 1, compressed.Data(), compressed.Size(), CompressionMode::LZ4) == 0);
+		CHECK(Compression::Decompress(result.Data(), result.Size(), compressed.Data(), compressed.Size() - 1, CompressionMode::LZ4) != text.Size());
+		for (usize i = 0; i < compressed.Size(); i += 7)
+		{
+			Array<u8> corrupted = compressed;
+			corrupted[i] ^= 0xA5;
+			CHECK(Compression::Decompress(result.Data(), result.Size(), corrupted.Data(), corrupted.Size(), CompressionMode::LZ4) <= result.Size());
+		}
+	}
+
+	//run with --no-skip, compares the cooked buffers in Assets, zstd frames are decompressed first
+	TEST_CASE("IO::CompressionBenchmark" * doctest::skip())
+	{
+		struct Codec
+		{
+			const char*     name;
+			CompressionMode mode;
+			i32             level;
+		};
+
+		Codec codecs[] = {
+			{"zstd 3", CompressionMode::ZSTD, CompressionDefaultLevel},
+			{"zstd 19", CompressionMode::ZSTD, 19},
+			{"lz4", CompressionMode::LZ4, 1},
+			{"lz4 hc", CompressionMode::LZ4, CompressionLZ4HCLevel},
+		};
+
+		const char* files[] = {
+			"Materials/autumn_field_puresky_1k.texture.buffers/5a8e74d62049b73a.buffer",
+			"Meshes/Sphere.mesh.buffers/c5620893d551f53e.buffer",
+			"Fonts/DejaVuSans.buffer",
+		};
+
+		for (const char* file : files)
+		{
+			Array<u8> data;
+			FileSystem::ReadFileAsByteArray(Path::Join(SK_ASSETS_DIR, file), data);
+			REQUIRE(!data.Empty());
+
+			u64 uncompressedSize = Compression::GetMaxDecompressedBufferSize(data.Data(), data.Size(), CompressionMode::ZSTD);
+			if (uncompressedSize > 0 && uncompressedSize < U64_MAX - 1)
+			{
+				Array<u8> uncompressed;
+				uncompressed.Resize(uncompressedSize);
+				REQUIRE(Compression::Decompress(uncompressed.Data(), uncompressed.Size(), data.Data(), data.Size(), CompressionMode::ZSTD) == uncompressedSize);
+				data = Traits::Move(uncompressed);
+			}
+
+			for (const Codec& codec : codecs)
+			{
+				auto      begin = std::chrono::steady_clock::now();
+				Array<u8> compressed = CompressionRoundTrip(data, codec.mode, codec.level);
+				f64       compressTime = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+				Array<u8> result;
+				result.Resize(data.Size());
+
+				constexpr u32 rounds = 20;
+				begin = std::chrono::steady_clock::now();
+				for (u32 i = 0; i < rounds; ++i)
+				{
+					Compression::Decompress(result.Data(), result.Size(), compressed.Data(), compressed.Size(), codec.mode);
+				}
+				f64 decodeTime = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - begin).count() / rounds;
+
+				MESSAGE(doctest::String(file) << " " << doctest::String(codec.name) << ": " << data.Size() << " -> " << compressed.Size() << " bytes, ratio " << static_cast<f64>(data.Size()) / compressed.Size()
+					<< ", compress " << compressTime << "ms, decode " << decodeTime << "ms (" << data.Size() / (decodeTime * 1000.0) << " MB/s)");
+			}
+		}
+	}
+}
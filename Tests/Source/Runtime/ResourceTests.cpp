@@ -1,9 +1,16 @@
+#include <atomic>
 #include <iostream>
 #include <ostream>
+#include <thread>
 
 #include "doctest.h"
+#include "Skore/Core/JobSystem.hpp"
 #include "Skore/Core/Reflection.hpp"
 #include "Skore/Core/Serialization.hpp"
+#include "Skore/Core/StringUtils.hpp"
+#include "Skore/IO/FileSystem.hpp"
+#include "Skore/IO/Path.hpp"
+#include "Skore/Resource/ResourcePackage.hpp"
 #include "Skore/Resource/Resources.hpp"
 
 using namespace Skore;
@@ -454,6 +461,287 @@ namespace
 		ResourceShutdown();
 	}
 
+	TEST_CASE("Resource::UndoRedoDelta")
+	{
+		ResourceInit();
+		RegisterTestTypes();
+
+		String longString;
+		for (u32 i = 0; i < 1024; ++i)
+		{
+			longString.Append("a");
+		}
+
+		RID rid = Resources::Create<ResourceTest>();
+		{
+			ResourceObject write = Resources::Write(rid);
+			write.SetInt(ResourceTest::IntValue, 10);
+			write.SetString(ResourceTest::StringValue, longString);
+			write.Commit();
+		}
+
+		//unchanged fields are not stored
+		UndoRedoScope* scope = UndoRedoScope::Create("delta");
+		{
+			ResourceObject write = Resources::Write(rid);
+			write.SetInt(ResourceTest::IntValue, 20);
+			write.SetBool(ResourceTest::BoolValue, true);
+			write.Commit(scope);
+		}
+		CHECK(scope->GetMemorySize() < longString.Size());
+
+		scope->Undo();
+		{
+			ResourceObject read = Resources::Read(rid);
+			CHECK(read.GetInt(ResourceTest::IntValue) == 10);
+			CHECK(!read.HasValue(ResourceTest::BoolValue));
+			CHECK(read.GetString(ResourceTest::StringValue) == longString);
+		}
+
+		scope->Redo();
+		{
+			ResourceObject read = Resources::Read(rid);
+			CHECK(read.GetInt(ResourceTest::IntValue) == 20);
+			CHECK(read.GetBool(ResourceTest::BoolValue));
+			CHECK(read.GetString(ResourceTest::StringValue) == longString);
+		}
+		scope->Destroy();
+
+		//destroyed resources are restored from the stored fields
+		UndoRedoScope* destroyScope = UndoRedoScope::Create("destroy");
+		Resources::Destroy(rid, destroyScope);
+		CHECK(!Resources::HasValue(rid));
+		CHECK(destroyScope->GetMemorySize() > longString.Size());
+
+		destroyScope->Undo();
+		{
+			ResourceObject read = Resources::Read(rid);
+			REQUIRE(read);
+			CHECK(read.GetInt(ResourceTest::IntValue) == 20);
+			CHECK(read.GetString(ResourceTest::StringValue) == longString);
+		}
+
+		destroyScope->Redo();
+		CHECK(!Resources::HasValue(rid));
+		destroyScope->Destroy();
+
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Resource::ResourcesByType")
+	{
+		ResourceInit();
+		RegisterTestTypes();
+
+		ResourceType* type = Resources::FindType<ResourceTest>();
+
+		RID resources[3];
+		for (RID& rid : resources)
+		{
+			rid = Resources::Create<ResourceTest>();
+			ResourceObject write = Resources::Write(rid);
+			write.SetInt(ResourceTest::IntValue, 10);
+			write.Commit();
+		}
+
+		CHECK(Resources::GetResourcesByType(type).Size() == 3);
+
+		UndoRedoScope* scope = UndoRedoScope::Create("test scope");
+		Resources::Destroy(resources[1], scope);
+
+		{
+			Array<RID> byType = Resources::GetResourcesByType(type);
+			CHECK(byType.Size() == 2);
+			CHECK(FindFirst(byType.begin(), byType.end(), resources[1]) == nullptr);
+		}
+
+		scope->Undo();
+
+		u32 count = 0;
+		bool found = false;
+		Resources::IterateResourcesByType(type, [&](RID rid)
+		{
+			count++;
+			found = found || rid == resources[1];
+		});
+		CHECK(count == 3);
+		CHECK(found);
+
+		scope->Redo();
+		CHECK(Resources::GetResourcesByType(type).Size() == 2);
+
+		scope->Destroy();
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Resource::Transaction")
+	{
+		ResourceInit();
+		RegisterTestTypes();
+
+		RID parent = Resources::Create<ResourceTest>();
+		RID child = Resources::Create<ResourceTest>();
+		{
+			ResourceObject write = Resources::Write(parent);
+			write.SetInt(ResourceTest::IntValue, 1);
+			write.SetSubObject(ResourceTest::SubObject, child);
+			write.Commit();
+		}
+		Resources::DispatchEvents();
+
+		struct ChangedEvents
+		{
+			u32 count = 0;
+			i64 oldValue = 0;
+			i64 newValue = 0;
+		} events;
+
+		Resources::GetStorage(parent)->RegisterEvent(ResourceEventType::Changed, [](ResourceObject& oldValue, ResourceObject& newValue, VoidPtr userData)
+		{
+			ChangedEvents& events = *static_cast<ChangedEvents*>(userData);
+			events.count++;
+			events.oldValue = oldValue.GetInt(ResourceTest::IntValue);
+			events.newValue = newValue.GetInt(ResourceTest::IntValue);
+		}, &events);
+
+		u64 parentVersion = Resources::GetVersion(parent);
+		u64 childVersion = Resources::GetVersion(child);
+
+		Resources::BeginTransaction();
+		for (i64 i = 2; i <= 10; ++i)
+		{
+			Resources::BeginTransaction();
+			{
+				ResourceObject write = Resources::Write(parent);
+				write.SetInt(ResourceTest::IntValue, i);
+				write.Commit();
+			}
+			{
+				ResourceObject write = Resources::Write(child);
+				write.SetInt(ResourceTest::IntValue, i);
+				write.Commit();
+			}
+			Resources::EndTransaction();
+		}
+
+		//the committing thread reads its staged values, versions and events wait for the end
+		CHECK(Resources::Read(parent).GetInt(ResourceTest::IntValue) == 10);
+		CHECK(Resources::GetVersion(parent) == parentVersion);
+		Resources::EndTransaction();
+
+		CHECK(Resources::GetVersion(parent) == parentVersion + 1);
+		CHECK(Resources::GetVersion(child) == childVersion + 1);
+
+		Resources::DispatchEvents();
+		CHECK(events.count == 1);
+		CHECK(events.oldValue == 1);
+		CHECK(events.newValue == 10);
+
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Resource::TransactionAtomic")
+	{
+		ResourceInit();
+		RegisterTestTypes();
+
+		RID first = Resources::Create<ResourceTest>();
+		RID second = Resources::Create<ResourceTest>();
+		for (RID rid : {first, second})
+		{
+			ResourceObject write = Resources::Write(rid);
+			write.SetInt(ResourceTest::IntValue, 0);
+			write.Commit();
+		}
+
+		//other threads don't see anything of a transaction before it ends
+		{
+			std::atomic_int step = 0;
+			i64             firstValue = -1;
+			i64             secondValue = -1;
+
+			std::thread reader([&]
+			{
+				while (step.load() != 1) std::this_thread::yield();
+				firstValue = Resources::Read(first).GetInt(ResourceTest::IntValue);
+				secondValue = Resources::Read(second).GetInt(ResourceTest::IntValue);
+				step = 2;
+			});
+
+			Resources::BeginTransaction();
+			{
+				ResourceObject write = Resources::Write(first);
+				write.SetInt(ResourceTest::IntValue, 1);
+				write.Commit();
+			}
+			{
+				ResourceObject write = Resources::Write(second);
+				write.SetInt(ResourceTest::IntValue, 1);
+				write.Commit();
+			}
+			CHECK(Resources::Read(first).GetInt(ResourceTest::IntValue) == 1);
+			CHECK(Resources::Read(second).GetInt(ResourceTest::IntValue) == 1);
+
+			step = 1;
+			while (step.load() != 2) std::this_thread::yield();
+			reader.join();
+
+			CHECK(firstValue == 0);
+			CHECK(secondValue == 0);
+
+			Resources::EndTransaction();
+
+			std::thread([&]
+			{
+				firstValue = Resources::Read(first).GetInt(ResourceTest::IntValue);
+				secondValue = Resources::Read(second).GetInt(ResourceTest::IntValue);
+			}).join();
+
+			CHECK(firstValue == 1);
+			CHECK(secondValue == 1);
+		}
+
+		//both values are published together, a reader never sees second ahead of first
+		{
+			constexpr i64    iterations = 500;
+			std::atomic_bool running = true;
+			std::atomic_int  mismatches = 0;
+
+			std::thread reader([&]
+			{
+				while (running.load())
+				{
+					i64 secondValue = Resources::Read(second).GetInt(ResourceTest::IntValue);
+					i64 firstValue = Resources::Read(first).GetInt(ResourceTest::IntValue);
+					if (firstValue < secondValue)
+					{
+						mismatches++;
+					}
+				}
+			});
+
+			for (i64 i = 2; i < iterations; ++i)
+			{
+				Resources::BeginTransaction();
+				for (RID rid : {first, second})
+				{
+					ResourceObject write = Resources::Write(rid);
+					write.SetInt(ResourceTest::IntValue, i);
+					write.Commit();
+				}
+				Resources::EndTransaction();
+			}
+
+			running = false;
+			reader.join();
+
+			CHECK(mismatches.load() == 0);
+		}
+
+		Resources::DispatchEvents();
+		ResourceShutdown();
+	}
+
 	TEST_CASE("Resource::Subobjects")
 	{
 		ResourceInit();
@@ -907,6 +1195,205 @@ namespace
 		}
 	}
 
+	TEST_CASE("Resource::ParallelDeserialization")
+	{
+		constexpr u32 count = 64;
+
+		UUID             target = UUID::RandomUUID();
+		Array<UUID>      uuids;
+		Array<Array<u8>> data;
+
+		{
+			ResourceInit();
+			RegisterTestTypes();
+
+			RID targetRid = Resources::Create<ResourceTest>(target);
+
+			for (u32 i = 0; i < count; ++i)
+			{
+				UUID uuid = uuids.EmplaceBack(UUID::RandomUUID());
+				RID  rid = Resources::Create<ResourceTest>(uuid);
+
+				ResourceObject write = Resources::Write(rid);
+				write.SetInt(ResourceTest::IntValue, i);
+				write.SetReference(ResourceTest::Reference, targetRid);
+				write.Commit();
+
+				BinaryArchiveWriter writer;
+				Resources::Serialize(rid, writer);
+				data.EmplaceBack(writer.GetData());
+			}
+
+			ResourceShutdown();
+		}
+
+		{
+			ResourceInit();
+			RegisterTestTypes();
+
+			Array<RID> rids;
+			rids.Resize(count);
+
+			//all resources reserve the same referenced uuid concurrently
+			JobSystem::ParallelFor(count, 1, [&](u32 index)
+			{
+				BinaryArchiveReader reader(data[index]);
+				rids[index] = Resources::Deserialize(reader);
+			});
+
+			RID targetRid = Resources::FindByUUID(target);
+			CHECK(targetRid);
+
+			for (u32 i = 0; i < count; ++i)
+			{
+				CHECK(Resources::FindByUUID(uuids[i]) == rids[i]);
+
+				ResourceObject read = Resources::Read(rids[i]);
+				REQUIRE(read);
+				CHECK(read.GetInt(ResourceTest::IntValue) == i);
+				CHECK(read.GetReference(ResourceTest::Reference) == targetRid);
+			}
+
+			ResourceShutdown();
+		}
+	}
+
+	TEST_CASE("Resource::ParallelDeserializationCreatesType")
+	{
+		constexpr u32 count = 128;
+
+		Array<Array<u8>> data;
+
+		{
+			ResourceInit();
+			Reflection::Type<StructToCast>();
+			Reflection::Type<CompositionStruct>();
+
+			for (u32 i = 0; i < count; ++i)
+			{
+				StructToCast value;
+				value.intValue = static_cast<i32>(i);
+				value.composition.value = static_cast<i32>(i * 2);
+
+				RID rid = Resources::Create<StructToCast>(UUID::RandomUUID());
+				Resources::ToResource(rid, &value);
+
+				BinaryArchiveWriter writer;
+				Resources::Serialize(rid, writer);
+				data.EmplaceBack(writer.GetData());
+			}
+
+			ResourceShutdown();
+		}
+
+		{
+			ResourceInit();
+
+			//no resource type for StructToCast yet, the first chunks create it while the others look it up
+			REQUIRE(Resources::FindType<StructToCast>() == nullptr);
+
+			Array<RID> rids;
+			rids.Resize(count);
+
+			JobSystem::ParallelFor(count, 1, [&](u32 index)
+			{
+				BinaryArchiveReader reader(data[index]);
+				rids[index] = Resources::Deserialize(reader);
+			});
+
+			ResourceType* type = Resources::FindType<StructToCast>();
+			REQUIRE(type);
+			CHECK(type->GetReflectType() != nullptr);
+			CHECK(type->GetFields().Size() == 3);
+			CHECK(type->GetVersion() == 1);
+
+			for (u32 i = 0; i < count; ++i)
+			{
+				REQUIRE(rids[i]);
+				CHECK(Resources::GetType(rids[i]) == type);
+
+				StructToCast value;
+				REQUIRE(Resources::FromResource(rids[i], &value));
+				CHECK(value.intValue == static_cast<i32>(i));
+				CHECK(value.composition.value == static_cast<i32>(i * 2));
+			}
+
+			ResourceShutdown();
+		}
+	}
+
+	TEST_CASE("Resource::EpochReclamation")
+	{
+		ResourceInit();
+		RegisterTestTypes();
+
+		RID rid = Resources::Create<ResourceTest>();
+		{
+			ResourceObject write = Resources::Write(rid);
+			write.SetInt(ResourceTest::IntValue, 0);
+			write.SetString(ResourceTest::StringValue, "first value, long enough to be allocated");
+			write.Commit();
+		}
+
+		{
+			ResourceObject read = Resources::Read(rid);
+			StringView     value = read.GetString(ResourceTest::StringValue);
+
+			ResourceObject write = Resources::Write(rid);
+			write.SetString(ResourceTest::StringValue, "second value");
+			write.Commit();
+
+			//the replaced instance is kept while a read object is alive
+			Resources::DispatchEvents();
+			Resources::GarbageCollect();
+			CHECK(value == "first value, long enough to be allocated");
+		}
+
+		//readers on other threads while the main thread commits and collects
+		{
+			ResourceObject write = Resources::Write(rid);
+			write.SetString(ResourceTest::StringValue, "value start");
+			write.Commit();
+		}
+
+		std::atomic_bool running = true;
+		std::atomic_bool valid = true;
+		Array<std::thread> readers;
+		for (u32 i = 0; i < 4; ++i)
+		{
+			readers.EmplaceBack([&]
+			{
+				while (running)
+				{
+					ResourceObject read = Resources::Read(rid);
+					if (!read.GetString(ResourceTest::StringValue).StartsWith("value "))
+					{
+						valid = false;
+					}
+				}
+			});
+		}
+
+		for (u64 i = 0; i < 2000; ++i)
+		{
+			ResourceObject write = Resources::Write(rid);
+			write.SetString(ResourceTest::StringValue, String("value ").Append(ToString(i)));
+			write.Commit();
+
+			Resources::DispatchEvents();
+			Resources::GarbageCollect();
+		}
+
+		running = false;
+		for (std::thread& reader : readers)
+		{
+			reader.join();
+		}
+		CHECK(valid);
+
+		ResourceShutdown();
+	}
+
 	TEST_CASE("Resource::TypeExportImportJson")
 	{
 		String exportedJson;
@@ -1266,4 +1753,360 @@ namespace
 
 		ResourceShutdown();
 	}
+	TEST_CASE("Resource::PackageChunks")
+	{
+		String path = Path::Join(FileSystem::CurrentDir(), "ResourcePackageChunks.resources");
+
+		Array<u8> compressible;
+		compressible.Resize(64 * 1024);
+		for (usize i = 0; i < compressible.Size(); ++i)
+		{
+			compressible[i] = static_cast<u8>(i % 16);
+		}
+
+		Array<u8> small = {1, 2, 3};
+
+		{
+			ResourcePackageWriter writer;
+			REQUIRE(writer.Open(path));
+			writer.AddChunk(compressible);
+			writer.BeginGroup();
+			writer.AddChunk(small);
+			writer.AddChunk(compressible, CompressionMode::None);
+			writer.Close();
+		}
+
+		{
+			ResourcePackageReader reader;
+			REQUIRE(reader.Open(path));
+			REQUIRE(reader.GetChunkCount() == 3);
+
+			CHECK(reader.GetChunk(0).mode == CompressionMode::ZSTD);
+			CHECK(reader.GetChunk(0).size < compressible.Size());
+			CHECK(reader.GetChunk(1).mode == CompressionMode::None);
+			CHECK(reader.GetChunk(2).mode == CompressionMode::None);
+			CHECK(reader.GetChunk(0).group == 0);
+			CHECK(reader.GetChunk(1).group == 1);
+			CHECK(reader.GetChunk(2).group == 1);
+
+			Array<u8> buffer;
+			CHECK(reader.ReadChunk(0, buffer) == Span<u8>(compressible));
+			CHECK(reader.ReadChunk(1, buffer) == Span<u8>(small));
+
+			Span<u8> stored = reader.ReadChunk(2, buffer);
+			CHECK(stored == Span<u8>(compressible));
+			CHECK((stored.Data() < buffer.Data() || stored.Data() >= buffer.Data() + buffer.Size()));
+		}
+
+		//packages exported as a single zstd frame
+		{
+			Array<u8> compressed;
+			compressed.Resize(Compression::GetMaxCompressedBufferSize(compressible.Size(), CompressionMode::ZSTD));
+			usize compressedSize = Compression::Compress(compressed.Data(), compressed.Size(), compressible.Data(), compressible.Size(), CompressionMode::ZSTD);
+			FileSystem::SaveFileAsByteArray(path, Span<u8>(compressed.Data(), compressedSize));
+
+			ResourcePackageReader reader;
+			REQUIRE(reader.Open(path));
+			REQUIRE(reader.GetChunkCount() == 1);
+
+			Array<u8> buffer;
+			CHECK(reader.ReadChunk(0, buffer) == Span<u8>(compressible));
+		}
+
+		FileSystem::Remove(path);
+	}
+
+	TEST_CASE("Resource::PackageDictionary")
+	{
+		String path = Path::Join(FileSystem::CurrentDir(), "ResourcePackageDictionary.resources");
+
+		//small records sharing their layout, like cooked materials
+		Array<u8>    samples;
+		Array<usize> sampleSizes;
+		for (u32 i = 0; i < 200; ++i)
+		{
+			String record = String("{\"type\":\"Skore::MaterialResource\",\"name\":\"Material_") + ToString(i) + "\",\"baseColor\":[" + ToString(i % 7) + ",1,1],\"roughness\":0." + ToString(i % 10) + ",\"metallic\":0,\"alphaCutoff\":0.5}";
+			samples.Insert(samples.end(), reinterpret_cast<const u8*>(record.begin()), reinterpret_cast<const u8*>(record.end()));
+			sampleSizes.EmplaceBack(record.Size());
+		}
+
+		Array<u8> dictionary;
+		Compression::TrainDictionary(samples, sampleSizes, dictionary);
+		REQUIRE(!dictionary.Empty());
+		CHECK(dictionary.Size() <= CompressionDictionarySize);
+
+		Span<u8> record(samples.Data(), sampleSizes[0]);
+
+		{
+			ResourcePackageWriter writer;
+			REQUIRE(writer.Open(path));
+			writer.AddDictionary(dictionary);
+			writer.AddChunk(record);
+			writer.Close();
+		}
+
+		{
+			ResourcePackageReader reader;
+			REQUIRE(reader.Open(path));
+			REQUIRE(reader.GetChunkCount() == 2);
+
+			CHECK(reader.GetChunk(0).type == ResourcePackageChunkType::Dictionary);
+			CHECK(reader.GetChunk(1).dictionary);
+			CHECK(reader.GetChunk(1).size < record.Size() / 2);
+
+			Array<u8> buffer;
+			CHECK(reader.ReadChunk(1, buffer) == record);
+		}
+
+		FileSystem::Remove(path);
+	}
+
+	TEST_CASE("Resource::PackageParallelCompression")
+	{
+		String path = Path::Join(FileSystem::CurrentDir(), "ResourcePackageParallel.resources");
+
+		Array<Array<u8>> chunks;
+		for (u32 c = 0; c < 32; ++c)
+		{
+			Array<u8>& chunk = chunks.EmplaceBack();
+			chunk.Resize(8 * 1024 + c);
+			for (usize i = 0; i < chunk.Size(); ++i)
+			{
+				chunk[i] = static_cast<u8>((i + c) % (c + 2));
+			}
+		}
+
+		{
+			ResourcePackageWriter writer;
+			REQUIRE(writer.Open(path));
+			writer.SetCompressionThreads(4);
+			for (u32 c = 0; c < chunks.Size(); ++c)
+			{
+				if (c == chunks.Size() / 2)
+				{
+					writer.BeginGroup();
+				}
+				writer.AddChunk(Array<u8>(chunks[c]), CompressionMode::ZSTD, 9);
+			}
+			writer.Close();
+		}
+
+		{
+			ResourcePackageReader reader;
+			REQUIRE(reader.Open(path));
+			REQUIRE(reader.GetChunkCount() == chunks.Size());
+
+			Array<u8> buffer;
+			for (u32 c = 0; c < chunks.Size(); ++c)
+			{
+				CHECK(reader.GetChunk(c).mode == CompressionMode::ZSTD);
+				CHECK(reader.GetChunk(c).group == (c < chunks.Size() / 2 ? 0 : 1));
+				CHECK(reader.ReadChunk(c, buffer) == Span<u8>(chunks[c]));
+			}
+		}
+
+		FileSystem::Remove(path);
+	}
+
+	TEST_CASE("Resource::LazyPackage")
+	{
+		String path = Path::Join(FileSystem::CurrentDir(), "ResourceLazyPackage.resources");
+
+		UUID lazyUUID = UUID::RandomUUID();
+		UUID targetUUID = UUID::RandomUUID();
+		UUID asyncUUID = UUID::RandomUUID();
+		UUID eagerUUID = UUID::RandomUUID();
+
+		{
+			ResourceInit();
+			RegisterTestTypes();
+
+			RID target = Resources::Create<ResourceTest>(targetUUID);
+			RID lazy = Resources::Create<ResourceTest>(lazyUUID);
+			RID async = Resources::Create<ResourceTest>(asyncUUID);
+			RID eager = Resources::Create<ResourceTest>(eagerUUID);
+
+			for (RID rid : {target, lazy, async, eager})
+			{
+				ResourceObject write = Resources::Write(rid);
+				write.SetInt(ResourceTest::IntValue, static_cast<i64>(rid.id));
+				if (rid == lazy)
+				{
+					write.SetReference(ResourceTest::Reference, target);
+				}
+				write.Commit();
+			}
+
+			struct PackageAsset
+			{
+				StringView pathId;
+				RID        rid;
+			};
+
+			auto writeAssets = [](std::initializer_list<PackageAsset> assets)
+			{
+				BinaryArchiveWriter writer{true};
+				writer.BeginSeq("assets");
+				for (const PackageAsset& asset : assets)
+				{
+					writer.BeginMap();
+					writer.WriteString("pathId", asset.pathId);
+					Resources::Serialize(asset.rid, writer);
+					writer.WriteUInt("bufferCount", 0);
+					writer.EndMap();
+				}
+				writer.EndSeq();
+				return Array<u8>(writer.GetData());
+			};
+
+			ResourcePackageWriter package;
+			REQUIRE(package.Open(path));
+			package.AddChunk(writeAssets({{"LazyPackage://Eager", eager}}));
+			package.BeginGroup();
+			package.AddChunk(writeAssets({{"LazyPackage://Lazy", lazy}, {"LazyPackage://Target", target}, {"LazyPackage://Async", async}}));
+
+			BinaryArchiveWriter writer{true};
+			writer.BeginSeq("assets");
+			u32 entry = 0;
+			for (const PackageAsset& asset : {PackageAsset{"LazyPackage://Lazy", lazy}, PackageAsset{"LazyPackage://Target", target}, PackageAsset{"LazyPackage://Async", async}})
+			{
+				writer.BeginMap();
+				writer.WriteString("pathId", asset.pathId);
+				writer.WriteString("uuid", Resources::GetUUID(asset.rid).ToString());
+				writer.WriteString("type", Resources::GetType(asset.rid)->GetName());
+				writer.WriteUInt("chunk", 1);
+				writer.WriteUInt("entry", entry++);
+				writer.EndMap();
+			}
+			writer.EndSeq();
+			package.AddTableOfContents(writer.GetData());
+			package.Close();
+
+			ResourceShutdown();
+		}
+
+		{
+			ResourceInit();
+			RegisterTestTypes();
+
+			Resources::LoadResources(path, ResourceLoadMode::Lazy);
+
+			//chunks not listed in the table of contents are loaded upfront
+			RID eager = Resources::FindOrReserveByUUID(eagerUUID);
+			CHECK(Resources::GetStorage(eager)->instance.load() != nullptr);
+
+			RID lazy = Resources::FindOrReserveByUUID(lazyUUID);
+			RID target = Resources::FindOrReserveByUUID(targetUUID);
+			RID async = Resources::FindOrReserveByUUID(asyncUUID);
+
+			for (RID rid : {lazy, target, async})
+			{
+				CHECK(Resources::GetStorage(rid)->instance.load() == nullptr);
+				CHECK(Resources::GetType(rid) == Resources::FindType<ResourceTest>());
+			}
+			CHECK(Resources::GetResourcesByType(Resources::FindType<ResourceTest>()).Size() == 4);
+
+			CHECK(Resources::FindByPath("LazyPackage://Lazy") == lazy);
+			CHECK(Resources::GetStorage(lazy)->instance.load() != nullptr);
+			CHECK(Resources::GetStorage(target)->instance.load() == nullptr);
+
+			CHECK(Resources::Read(lazy).GetReference(ResourceTest::Reference) == target);
+
+			//references are loaded when read
+			CHECK(Resources::Read(target));
+			CHECK(Resources::GetPath(target) == "LazyPackage://Target");
+
+			JobHandle handle = Resources::LoadAsync(async);
+			CHECK(handle);
+			JobSystem::Wait(handle);
+			CHECK(Resources::GetStorage(async)->instance.load() != nullptr);
+			CHECK(!Resources::LoadAsync(async));
+
+			ResourceShutdown();
+		}
+
+		FileSystem::Remove(path);
+	}
+
+	TEST_CASE("Resource::LazyPackageInvalidEntry")
+	{
+		String path = Path::Join(FileSystem::CurrentDir(), "ResourceLazyPackageInvalid.resources");
+
+		UUID lazyUUID = UUID::RandomUUID();
+		UUID invalidUUID = UUID::RandomUUID();
+
+		{
+			ResourceInit();
+			RegisterTestTypes();
+
+			RID lazy = Resources::Create<ResourceTest>(lazyUUID);
+			RID invalid = Resources::Create<ResourceTest>(invalidUUID);
+
+			BinaryArchiveWriter assets{true};
+			assets.BeginSeq("assets");
+			for (RID rid : {lazy, invalid})
+			{
+				assets.BeginMap();
+				assets.WriteString("pathId", rid == lazy ? "LazyPackage://Lazy" : "LazyPackage://Invalid");
+				Resources::Serialize(rid, assets);
+				assets.WriteUInt("bufferCount", 0);
+				assets.EndMap();
+			}
+			assets.EndSeq();
+
+			ResourcePackageWriter package;
+			REQUIRE(package.Open(path));
+			package.AddChunk(Array<u8>(assets.GetData()));
+
+			//second entry has no uuid, the third one points to a chunk that doesn't exist
+			BinaryArchiveWriter writer{true};
+			writer.BeginSeq("assets");
+			writer.BeginMap();
+			writer.WriteString("pathId", "LazyPackage://Lazy");
+			writer.WriteString("uuid", lazyUUID.ToString());
+			writer.WriteString("type", Resources::GetType(lazy)->GetName());
+			writer.WriteUInt("chunk", 0);
+			writer.WriteUInt("entry", 0);
+			writer.EndMap();
+			writer.BeginMap();
+			writer.WriteString("pathId", "LazyPackage://Invalid");
+			writer.WriteString("uuid", "");
+			writer.WriteString("type", Resources::GetType(invalid)->GetName());
+			writer.WriteUInt("chunk", 0);
+			writer.WriteUInt("entry", 1);
+			writer.EndMap();
+			writer.BeginMap();
+			writer.WriteString("pathId", "LazyPackage://Missing");
+			writer.WriteString("uuid", UUID::RandomUUID().ToString());
+			writer.WriteString("type", Resources::GetType(invalid)->GetName());
+			writer.WriteUInt("chunk", 10);
+			writer.WriteUInt("entry", 0);
+			writer.EndMap();
+			writer.EndSeq();
+			package.AddTableOfContents(writer.GetData());
+			package.Close();
+
+			ResourceShutdown();
+		}
+
+		{
+			ResourceInit();
+			RegisterTestTypes();
+
+			Resources::LoadResources(path, ResourceLoadMode::Lazy);
+
+			//the chunk is loaded upfront for the invalid entry, valid entries stay on demand
+			RID invalid = Resources::FindOrReserveByUUID(invalidUUID);
+			CHECK(Resources::GetStorage(invalid)->instance.load() != nullptr);
+
+			RID lazy = Resources::FindOrReserveByUUID(lazyUUID);
+			CHECK(Resources::GetStorage(lazy)->instance.load() == nullptr);
+			CHECK(Resources::Read(lazy));
+			CHECK(Resources::GetPath(lazy) == "LazyPackage://Lazy");
+
+			ResourceShutdown();
+		}
+
+		FileSystem::Remove(path);
+	}
 }
@@ -0,0 +1,1542 @@
+#include "doctest.h"
+#include <SDL3/SDL.h>
+#include "Skore/App.hpp"
+#include "Skore/Events.hpp"
+#include "Skore/Core/Algorithm.hpp"
+#include "Skore/Core/Event.hpp"
+#include "Skore/Core/Reflection.hpp"
+#include "Skore/Graphics/Graphics.hpp"
+#include "Skore/Graphics/GraphicsResources.hpp"
+#include "Skore/IO/FileSystem.hpp"
+#include "Skore/IO/Input.hpp"
+#include "Skore/IO/Path.hpp"
+#include "Skore/Resource/Resources.hpp"
+#include "Skore/Scene/Component.hpp"
+#include "Skore/Scene/Entity.hpp"
+#include "Skore/Scene/Scene.hpp"
+#include "Skore/Scene/SceneCommon.hpp"
+#include "Skore/Scene/Physics.hpp"
+#include "Skore/Scene/Components/PhysicShapes.hpp"
+#include "Skore/Scene/Components/RenderComponents.hpp"
+#include "Skore/Scene/Components/RigidBody.hpp"
+#include "Skore/Scene/Components/Transform.hpp"
+
+using namespace Skore;
+
+namespace Skore
+{
+	void SK_API ResourceInit();
+	void SK_API ResourceShutdown();
+	void SK_API PhysicsInit();
+	void SK_API PhysicsShutdown();
+	void SK_API InputInit();
+	void SK_API InputHandlerEvents(SDL_Event* event);
+	void SK_API InputOnBeginFrame();
+	void SK_API InputOnEndFrame();
+}
+
+namespace
+{
+	struct ParallelCounter : Component
+	{
+		SK_CLASS(ParallelCounter, Component);
+
+		i32 value = 0;
+
+		static void RegisterType(NativeReflectType<ParallelCounter>& type)
+		{
+			type.Field<&ParallelCounter::value>("value");
+		}
+	};
+
+	struct ParallelCounterWriter : Component, Tickable
+	{
+		SK_CLASS(ParallelCounterWriter, Component);
+
+		void OnUpdate(f64 deltaTime) override
+		{
+			entity->GetComponent<ParallelCounter>()->value++;
+		}
+
+		static void RegisterType(NativeReflectType<ParallelCounterWriter>& type)
+		{
+			type.Attribute<ParallelTick>(ParallelTick{.writes = {TypeInfo<ParallelCounter>::ID()}});
+		}
+	};
+
+	struct ParallelCounterReader : Component, Tickable
+	{
+		SK_CLASS(ParallelCounterReader, Component);
+
+		i32 seen = -1;
+
+		void OnUpdate(f64 deltaTime) override
+		{
+			seen = entity->GetComponent<ParallelCounter>()->value;
+		}
+
+		static void RegisterType(NativeReflectType<ParallelCounterReader>& type)
+		{
+			type.Attribute<ParallelTick>(ParallelTick{.reads = {TypeInfo<ParallelCounter>::ID()}});
+		}
+	};
+
+	struct ParallelMover : Component, Tickable
+	{
+		SK_CLASS(ParallelMover, Component);
+
+		void OnUpdate(f64 deltaTime) override
+		{
+			Transform* transform = entity->GetComponent<Transform>();
+			transform->SetPosition(transform->GetPosition() + Vec3{1.0f, 0.0f, 0.0f});
+		}
+
+		static void RegisterType(NativeReflectType<ParallelMover>& type)
+		{
+			type.Attribute<ParallelTick>(ParallelTick{.writes = {TypeInfo<Transform>::ID()}});
+		}
+	};
+
+	struct InputMover : Component, Tickable
+	{
+		SK_CLASS(InputMover, Component);
+
+		void OnUpdate(f64 deltaTime) override
+		{
+			Transform* transform = entity->GetComponent<Transform>();
+			Vec3       position = transform->GetPosition();
+			if (Input::IsKeyDown(Key::D))
+			{
+				position.x += static_cast<f32>(2.0 * deltaTime);
+			}
+			position.z += Random::NextFloat32(0.0f, 1.0f) * static_cast<f32>(deltaTime);
+			transform->SetPosition(position);
+
+			if (Input::IsKeyPressed(Key::Space))
+			{
+				entity->GetComponent<RigidBody>()->AddImpulse(Vec3{0.0f, 5.0f, 0.0f});
+			}
+		}
+	};
+
+	struct QueryA : Component
+	{
+		SK_CLASS(QueryA, Component);
+
+		i32 value = 0;
+
+		static void RegisterType(NativeReflectType<QueryA>& type) {}
+	};
+
+	struct QueryB : Component
+	{
+		SK_CLASS(QueryB, Component);
+
+		static void RegisterType(NativeReflectType<QueryB>& type) {}
+	};
+
+	//reports fixed bounds to the spatial index, like a renderer with a loaded mesh
+	struct SpatialBounds : Component
+	{
+		SK_CLASS(SpatialBounds, Component);
+
+		AABB bounds = {};
+
+		void OnCreate() override
+		{
+			scene->spatialIndex.AddEntity(entity);
+		}
+
+		void OnDestroy() override
+		{
+			scene->spatialIndex.RemoveEntity(entity);
+		}
+
+		void ProcessEvent(const EntityEventDesc& event) override
+		{
+			if (event.type == EntityEventType::CalculateEntityAABB)
+			{
+				static_cast<AABB*>(event.eventData)->Expand(bounds);
+			}
+			else if (event.type == EntityEventType::EntityLayerChanged || event.type == EntityEventType::EntityActivated || event.type == EntityEventType::EntityDeactivated)
+			{
+				scene->spatialIndex.MarkDirty(entity);
+			}
+		}
+
+		void SetBounds(const AABB& value)
+		{
+			bounds = value;
+			scene->spatialIndex.MarkDirty(entity);
+		}
+
+		static void RegisterType(NativeReflectType<SpatialBounds>& type) {}
+	};
+
+	//counts live instances, the scene teardown has to run every destructor even when the storage memory is released at once
+	struct PooledTracked : Component
+	{
+		SK_CLASS(PooledTracked, Component);
+
+		static inline i32 alive = 0;
+
+		u64 payload[4] = {};
+
+		PooledTracked()
+		{
+			alive++;
+		}
+
+		~PooledTracked() override
+		{
+			alive--;
+		}
+
+		static void RegisterType(NativeReflectType<PooledTracked>& type) {}
+	};
+
+	struct HeapComponent : Component
+	{
+		SK_CLASS(HeapComponent, Component);
+
+		static void RegisterType(NativeReflectType<HeapComponent>& type)
+		{
+			type.Attribute<ComponentDesc>(ComponentDesc{.pooledStorage = false});
+		}
+	};
+
+	struct TransformCounter : Component
+	{
+		SK_CLASS(TransformCounter, Component);
+
+		u32 updates = 0;
+
+		void ProcessEvent(const EntityEventDesc& event) override
+		{
+			if (event.type == EntityEventType::TransformUpdated)
+			{
+				updates++;
+			}
+		}
+
+		static void RegisterType(NativeReflectType<TransformCounter>& type) {}
+	};
+
+	//queries the spatial index from the workers, the index is only read
+	struct SpatialQuerier : Component, Tickable
+	{
+		SK_CLASS(SpatialQuerier, Component);
+
+		AABB  area = {};
+		usize found = 0;
+
+		void OnUpdate(f64 deltaTime) override
+		{
+			Entity* results[8];
+			found = scene->spatialIndex.QueryAABB(area, Span<Entity*>(results, 8));
+		}
+
+		static void RegisterType(NativeReflectType<SpatialQuerier>& type)
+		{
+			type.Attribute<ParallelTick>(ParallelTick{.reads = {TypeInfo<SpatialBounds>::ID()}});
+		}
+	};
+
+	struct TestRandom
+	{
+		u32 state = 12345;
+
+		f32 Next(f32 min, f32 max)
+		{
+			state = state * 1664525u + 1013904223u;
+			return min + (max - min) * (static_cast<f32>(state >> 8) / static_cast<f32>(1u << 24));
+		}
+
+		AABB NextBounds(f32 range, f32 maxSize)
+		{
+			Vec3 min = {Next(-range, range), Next(-range, range), Next(-range, range)};
+			Vec3 size = {Next(0.1f, maxSize), Next(0.1f, maxSize), Next(0.1f, maxSize)};
+			return AABB{min, min + size};
+		}
+	};
+
+	bool OverlapsAABB(const AABB& a, const AABB& b)
+	{
+		return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+			a.min.y <= b.max.y && a.max.y >= b.min.y &&
+			a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+
+	bool OverlapsSphere(const AABB& aabb, const Vec3& center, f32 radius)
+	{
+		Vec3 closest = Vec3::Max(aabb.min, Vec3::Min(center, aabb.max));
+		Vec3 d = closest - center;
+		return d.x * d.x + d.y * d.y + d.z * d.z <= radius * radius;
+	}
+
+	Array<Entity*> SortedEntities(Span<Entity*> entities)
+	{
+		Array<Entity*> sorted = entities;
+		Sort(sorted.begin(), sorted.end(), [](Entity* a, Entity* b)
+		{
+			return a < b;
+		});
+		return sorted;
+	}
+
+	RID CreateEntityResource(StringView name, u8 layer, const Vec3& position, i32 counter)
+	{
+		RID transform = Resources::Create<Transform>(UUID::RandomUUID());
+		{
+			ResourceObject transformObject = Resources::Write(transform);
+			transformObject.SetVec3(transformObject.GetIndex("position"), position);
+			transformObject.Commit();
+		}
+
+		RID parallelCounter = Resources::Create<ParallelCounter>(UUID::RandomUUID());
+		{
+			ResourceObject counterObject = Resources::Write(parallelCounter);
+			counterObject.SetInt(counterObject.GetIndex("value"), counter);
+			counterObject.Commit();
+		}
+
+		RID rid = Resources::Create<EntityResource>(UUID::RandomUUID());
+		ResourceObject entityObject = Resources::Write(rid);
+		entityObject.SetString(EntityResource::Name, name);
+		entityObject.SetUInt(EntityResource::Layer, layer);
+		entityObject.AddToSubObjectList(EntityResource::Components, transform);
+		entityObject.AddToSubObjectList(EntityResource::Components, parallelCounter);
+		entityObject.Commit();
+		return rid;
+	}
+
+	void AddChildResource(RID parent, RID child)
+	{
+		ResourceObject entityObject = Resources::Write(parent);
+		entityObject.AddToSubObjectList(EntityResource::Children, child);
+		entityObject.Commit();
+	}
+
+	//root (layer 3) with two children, the first one has a child
+	RID CreatePrefabResource()
+	{
+		RID root = CreateEntityResource("Root", 3, Vec3{1.0f, 2.0f, 3.0f}, 10);
+		RID first = CreateEntityResource("First", 5, Vec3{0.0f, 1.0f, 0.0f}, 20);
+		RID second = CreateEntityResource("Second", 7, Vec3{-1.0f, 0.0f, 0.0f}, 30);
+		RID grandchild = CreateEntityResource("Grandchild", 5, Vec3{0.0f, 0.0f, 4.0f}, 40);
+
+		AddChildResource(first, grandchild);
+		AddChildResource(root, first);
+		AddChildResource(root, second);
+		return root;
+	}
+
+	struct TransformFrameResult
+	{
+		Array<Mat4> worldTransforms;
+		Array<u32>  updates;
+	};
+
+	//root -> middle -> leaf and a second root, the leaf moves under the second root in the middle of the frame
+	TransformFrameResult RunTransformFrame(bool deferred)
+	{
+		Scene scene;
+
+		auto create = [&](Entity* parent, const Vec3& position) -> Entity*
+		{
+			Entity* entity = parent ? parent->CreateChild() : scene.CreateEntity();
+			entity->AddComponent<Transform>()->SetPosition(position);
+			entity->AddComponent<TransformCounter>();
+			return entity;
+		};
+
+		Entity* root = create(nullptr, Vec3{1.0f, 0.0f, 0.0f});
+		Entity* middle = create(root, Vec3{0.0f, 2.0f, 0.0f});
+		Entity* leaf = create(middle, Vec3{0.0f, 0.0f, 3.0f});
+		Entity* otherRoot = create(nullptr, Vec3{-5.0f, 0.0f, 0.0f});
+
+		Entity* entities[] = {root, middle, leaf, otherRoot};
+		for (Entity* entity : entities)
+		{
+			entity->GetComponent<TransformCounter>()->updates = 0;
+		}
+
+		scene.SetDeferredTransformUpdates(deferred);
+
+		root->GetComponent<Transform>()->SetPosition(Vec3{2.0f, 0.0f, 0.0f});
+		middle->GetComponent<Transform>()->SetRotation(Quat::AngleAxis(Math::Radians(90.0f), Vec3{0.0f, 1.0f, 0.0f}));
+		leaf->GetComponent<Transform>()->SetScale(Vec3{2.0f, 2.0f, 2.0f});
+		leaf->SetParent(otherRoot);
+		otherRoot->GetComponent<Transform>()->SetRotation(Quat::AngleAxis(Math::Radians(45.0f), Vec3{0.0f, 0.0f, 1.0f}));
+		root->GetComponent<Transform>()->SetPosition(Vec3{3.0f, 1.0f, 0.0f});
+		leaf->GetComponent<Transform>()->SetPosition(Vec3{0.0f, 1.0f, 3.0f});
+
+		scene.FlushTransformUpdates();
+
+		TransformFrameResult result;
+		for (Entity* entity : entities)
+		{
+			result.worldTransforms.EmplaceBack(entity->GetWorldTransform());
+			result.updates.EmplaceBack(entity->GetComponent<TransformCounter>()->updates);
+		}
+		return result;
+	}
+
+	void CheckSameTranslation(const Mat4& a, const Mat4& b)
+	{
+		Vec3 ta = Mat4::GetTranslation(a);
+		Vec3 tb = Mat4::GetTranslation(b);
+		CHECK(ta.x == doctest::Approx(tb.x));
+		CHECK(ta.y == doctest::Approx(tb.y));
+		CHECK(ta.z == doctest::Approx(tb.z));
+	}
+
+	//compares a batch copy with an entity created by Entity::Instantiate
+	void CheckSameEntity(Entity* copy, Entity* expected)
+	{
+		CHECK(copy != expected);
+		CHECK(copy->GetName() == expected->GetName());
+		CHECK(copy->GetLayer() == expected->GetLayer());
+		CHECK(copy->IsActive() == expected->IsActive());
+
+		Span<Component*> copyComponents = copy->GetComponents();
+		Span<Component*> expectedComponents = expected->GetComponents();
+		REQUIRE(copyComponents.Size() == expectedComponents.Size());
+		for (usize i = 0; i < copyComponents.Size(); ++i)
+		{
+			CHECK(copyComponents[i] != expectedComponents[i]);
+			CHECK(copyComponents[i]->GetType() == expectedComponents[i]->GetType());
+		}
+
+		Transform* copyTransform = copy->GetComponent<Transform>();
+		Transform* expectedTransform = expected->GetComponent<Transform>();
+		REQUIRE(copyTransform);
+		REQUIRE(expectedTransform);
+		CHECK(copyTransform->GetPosition().x == doctest::Approx(expectedTransform->GetPosition().x));
+		CHECK(copyTransform->GetPosition().y == doctest::Approx(expectedTransform->GetPosition().y));
+		CHECK(copyTransform->GetPosition().z == doctest::Approx(expectedTransform->GetPosition().z));
+		CheckSameTranslation(copy->GetWorldTransform(), expected->GetWorldTransform());
+
+		ParallelCounter* copyCounter = copy->GetComponent<ParallelCounter>();
+		ParallelCounter* expectedCounter = expected->GetComponent<ParallelCounter>();
+		REQUIRE(copyCounter);
+		REQUIRE(expectedCounter);
+		CHECK(copyCounter->value == expectedCounter->value);
+
+		REQUIRE(copy->GetChildrenNum() == expected->GetChildrenNum());
+		for (u32 i = 0; i < copy->GetChildrenNum(); ++i)
+		{
+			CHECK(copy->GetChildAt(i)->GetParent() == copy);
+			CheckSameEntity(copy->GetChildAt(i), expected->GetChildAt(i));
+		}
+	}
+
+	struct QueryRow
+	{
+		Entity* entity;
+		QueryA* a;
+		QueryB* b;
+	};
+
+	Array<QueryRow> QueryAB(Scene& scene)
+	{
+		Array<QueryRow> rows;
+		scene.Query<QueryA, QueryB>([&](QueryA* a, QueryB* b)
+		{
+			CHECK(a->entity == b->entity);
+			rows.EmplaceBack(QueryRow{a->entity, a, b});
+		});
+		return rows;
+	}
+
+	bool HasQueryRow(Span<QueryRow> rows, Entity* entity)
+	{
+		for (const QueryRow& row : rows)
+		{
+			if (row.entity == entity) return true;
+		}
+		return false;
+	}
+
+	//box without gravity, bodies are placed apart so they don't collide
+	RigidBody* CreatePhysicsBody(Scene& scene, const Vec3& position)
+	{
+		Entity* entity = scene.CreateEntity();
+		entity->AddComponent<Transform>()->SetPosition(position);
+		entity->AddComponent<BoxCollider>();
+		RigidBody* rigidBody = entity->AddComponent<RigidBody>();
+		rigidBody->SetGravityFactor(0.0f);
+		return rigidBody;
+	}
+
+	void RegisterSceneTestTypes()
+	{
+		App::ResetContext();
+
+		Reflection::Type<QueryA>();
+		Reflection::Type<QueryB>();
+		Reflection::Type<SpatialBounds>();
+		Reflection::Type<SpatialQuerier>();
+		Reflection::Type<TransformCounter>();
+		Reflection::Type<PooledTracked>();
+		Reflection::Type<HeapComponent>();
+		Reflection::Type<ParallelCounter>();
+		Reflection::Type<ParallelCounterWriter>();
+		Reflection::Type<ParallelCounterReader>();
+		Reflection::Type<ParallelMover>();
+		Reflection::Type<InputMover>();
+	}
+
+	TEST_CASE("Scene::ParallelTickConflictingStages")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			constexpr u32 entityCount = 1000;
+			constexpr i32 frameCount = 3;
+
+			Scene scene;
+
+			Array<ParallelCounter*>       counters;
+			Array<ParallelCounterReader*> readers;
+			for (u32 i = 0; i < entityCount; ++i)
+			{
+				Entity* entity = scene.CreateEntity();
+				counters.EmplaceBack(entity->AddComponent<ParallelCounter>());
+				entity->AddComponent<ParallelCounterWriter>();
+				readers.EmplaceBack(entity->AddComponent<ParallelCounterReader>());
+			}
+
+			for (i32 frame = 0; frame < frameCount; ++frame)
+			{
+				scene.Update();
+			}
+
+			u32 writerStage = scene.GetParallelTickStage(TypeInfo<ParallelCounterWriter>::ID());
+			u32 readerStage = scene.GetParallelTickStage(TypeInfo<ParallelCounterReader>::ID());
+			REQUIRE(writerStage != U32_MAX);
+			REQUIRE(readerStage != U32_MAX);
+			CHECK(writerStage != readerStage);
+
+			//stages run in order, a reader before the writer sees the value of the last frame
+			i32 expectedSeen = writerStage < readerStage ? frameCount : frameCount - 1;
+			for (u32 i = 0; i < entityCount; ++i)
+			{
+				CHECK(counters[i]->value == frameCount);
+				CHECK(readers[i]->seen == expectedSeen);
+			}
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::ParallelTickTransformWrites")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			constexpr u32 entityCount = 500;
+			constexpr u32 frameCount = 4;
+
+			Scene scene;
+
+			Array<Entity*> entities;
+			Array<Entity*> children;
+			for (u32 i = 0; i < entityCount; ++i)
+			{
+				Entity* entity = scene.CreateEntity();
+				entity->AddComponent<Transform>();
+				entity->AddComponent<ParallelMover>();
+				entities.EmplaceBack(entity);
+
+				Entity* child = entity->CreateChild();
+				child->AddComponent<Transform>()->SetPosition(Vec3{0.0f, 2.0f, 0.0f});
+				children.EmplaceBack(child);
+			}
+
+			for (u32 frame = 0; frame < frameCount; ++frame)
+			{
+				scene.Update();
+			}
+
+			for (u32 i = 0; i < entityCount; ++i)
+			{
+				Vec3 position = Mat4::GetTranslation(entities[i]->GetWorldTransform());
+				CHECK(position.x == doctest::Approx(static_cast<f32>(frameCount)));
+
+				Vec3 childPosition = Mat4::GetTranslation(children[i]->GetWorldTransform());
+				CHECK(childPosition.x == doctest::Approx(static_cast<f32>(frameCount)));
+				CHECK(childPosition.y == doctest::Approx(2.0f));
+			}
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::ComponentStorageReuse")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			Scene   scene;
+			Entity* entity = scene.CreateEntity();
+
+			//freed slots are reused by the next component of the type
+			PooledTracked* first = entity->AddComponent<PooledTracked>();
+			ComponentStorage* storage = scene.GetComponentStorage(TypeInfo<PooledTracked>::ID());
+			REQUIRE(storage != nullptr);
+			CHECK(storage->Owns(first));
+			CHECK(storage->GetCount() == 1);
+
+			entity->RemoveComponent(first);
+			CHECK(storage->GetCount() == 0);
+			CHECK(PooledTracked::alive == 0);
+
+			PooledTracked* second = entity->AddComponent<PooledTracked>();
+			CHECK(static_cast<VoidPtr>(second) == static_cast<VoidPtr>(first));
+			entity->RemoveComponent(second);
+
+			//chunks are kept and filled again
+			constexpr u32 count = ComponentStorage::ChunkCapacity * 3 + 5;
+
+			Array<Entity*> entities;
+			for (u32 i = 0; i < count; ++i)
+			{
+				Entity* child = scene.CreateEntity();
+				child->AddComponent<PooledTracked>();
+				entities.EmplaceBack(child);
+			}
+			CHECK(storage->GetCount() == count);
+			CHECK(storage->GetChunkCount() == 4);
+			CHECK(PooledTracked::alive == static_cast<i32>(count));
+
+			//destroying entities returns their components to the storage
+			for (Entity* child : entities)
+			{
+				child->DestroyImmediate();
+			}
+			CHECK(storage->GetCount() == 0);
+			CHECK(PooledTracked::alive == 0);
+
+			for (u32 i = 0; i < count; ++i)
+			{
+				scene.CreateEntity()->AddComponent<PooledTracked>();
+			}
+			CHECK(storage->GetCount() == count);
+			CHECK(storage->GetChunkCount() == 4);
+		}
+
+		//the scene is destroyed with live pooled components, destructors still run
+		CHECK(PooledTracked::alive == 0);
+
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::ComponentStorageOptOut")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			Scene   scene;
+			Entity* entity = scene.CreateEntity();
+
+			HeapComponent* component = entity->AddComponent<HeapComponent>();
+			REQUIRE(component != nullptr);
+			CHECK(scene.GetComponentStorage(TypeInfo<HeapComponent>::ID()) == nullptr);
+
+			//pooled types next to it are not affected
+			PooledTracked* pooled = entity->AddComponent<PooledTracked>();
+			ComponentStorage* storage = scene.GetComponentStorage(TypeInfo<PooledTracked>::ID());
+			REQUIRE(storage != nullptr);
+			CHECK(storage->Owns(pooled));
+			CHECK(!storage->Owns(component));
+
+			entity->RemoveComponent(component);
+			CHECK(entity->GetComponent<HeapComponent>() == nullptr);
+
+			component = entity->AddComponent<HeapComponent>();
+			CHECK(entity->GetComponent<HeapComponent>() == component);
+
+			entity->DestroyImmediate();
+			CHECK(storage->GetCount() == 0);
+			CHECK(PooledTracked::alive == 0);
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::DeferredTransformsMatchImmediate")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			TransformFrameResult immediate = RunTransformFrame(false);
+			TransformFrameResult deferred = RunTransformFrame(true);
+
+			REQUIRE(immediate.worldTransforms.Size() == deferred.worldTransforms.Size());
+			for (usize i = 0; i < immediate.worldTransforms.Size(); ++i)
+			{
+				for (u32 j = 0; j < 16; ++j)
+				{
+					CHECK(deferred.worldTransforms[i].a[j] == doctest::Approx(immediate.worldTransforms[i].a[j]));
+				}
+
+				//one coalesced notification per entity, immediate mode sends one per change
+				CHECK(deferred.updates[i] == 1);
+				CHECK(immediate.updates[i] >= 1);
+			}
+			CHECK(immediate.updates[2] > 1);
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::DeferredTransformsOnLoad")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			TypedRID<EntityResource> prefab = CreatePrefabResource();
+			Scene                    scene(prefab);
+			CHECK(!scene.IsDeferredTransformUpdates());
+
+			Entity* grandchild = scene.FindFirstByName("Grandchild");
+			REQUIRE(grandchild != nullptr);
+
+			//(1, 2, 3) + (0, 1, 0) + (0, 0, 4)
+			Vec3 position = Mat4::GetTranslation(grandchild->GetWorldTransform());
+			CHECK(position.x == doctest::Approx(1.0f));
+			CHECK(position.y == doctest::Approx(3.0f));
+			CHECK(position.z == doctest::Approx(7.0f));
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::SpatialIndexInsertRemoveMove")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			constexpr u32 entityCount = 400;
+
+			Scene      scene;
+			TestRandom random;
+
+			Array<SpatialBounds*> components;
+			Array<bool>           tracked;
+			for (u32 i = 0; i < entityCount; ++i)
+			{
+				SpatialBounds* bounds = scene.CreateEntity()->AddComponent<SpatialBounds>();
+				bounds->SetBounds(random.NextBounds(100.0f, 5.0f));
+				components.EmplaceBack(bounds);
+				tracked.EmplaceBack(true);
+			}
+
+			scene.spatialIndex.Flush();
+			CHECK(scene.spatialIndex.GetEntityCount() == entityCount);
+			CHECK(scene.spatialIndex.Validate());
+
+			for (u32 iteration = 0; iteration < 50; ++iteration)
+			{
+				//large moves are reinserted, small ones mostly stay inside the enlarged leaf
+				for (u32 i = 0; i < 60; ++i)
+				{
+					SpatialBounds* bounds = components[static_cast<u32>(random.Next(0.0f, entityCount - 1))];
+					if (i % 2 == 0)
+					{
+						bounds->SetBounds(random.NextBounds(100.0f, 5.0f));
+					}
+					else
+					{
+						Vec3 offset = {random.Next(-0.1f, 0.1f), random.Next(-0.1f, 0.1f), random.Next(-0.1f, 0.1f)};
+						bounds->SetBounds(AABB{bounds->bounds.min + offset, bounds->bounds.max + offset});
+					}
+				}
+
+				for (u32 i = 0; i < 10; ++i)
+				{
+					u32 index = static_cast<u32>(random.Next(0.0f, entityCount - 1));
+					if (tracked[index])
+					{
+						scene.spatialIndex.RemoveEntity(components[index]->entity);
+					}
+					else
+					{
+						scene.spatialIndex.AddEntity(components[index]->entity);
+					}
+					tracked[index] = !tracked[index];
+				}
+
+				scene.spatialIndex.Flush();
+				REQUIRE(scene.spatialIndex.Validate());
+			}
+
+			usize trackedCount = 0;
+			for (bool value : tracked)
+			{
+				trackedCount += value ? 1 : 0;
+			}
+			CHECK(scene.spatialIndex.GetEntityCount() == trackedCount);
+
+			//balanced, a degenerate tree would be close to the entity count
+			CHECK(scene.spatialIndex.GetHeight() < 4 * 9);
+
+			for (u32 i = 0; i < entityCount; ++i)
+			{
+				if (tracked[i])
+				{
+					scene.spatialIndex.RemoveEntity(components[i]->entity);
+				}
+			}
+			CHECK(scene.spatialIndex.GetEntityCount() == 0);
+			CHECK(scene.spatialIndex.GetHeight() == 0);
+			CHECK(scene.spatialIndex.Validate());
+
+			for (u32 i = 0; i < entityCount; ++i)
+			{
+				scene.spatialIndex.AddEntity(components[i]->entity);
+			}
+			scene.spatialIndex.Flush();
+			CHECK(scene.spatialIndex.Validate());
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::SpatialIndexQueries")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			constexpr u32 entityCount = 500;
+
+			Scene      scene;
+			TestRandom random;
+
+			Array<SpatialBounds*> components;
+			for (u32 i = 0; i < entityCount; ++i)
+			{
+				Entity* entity = scene.CreateEntity();
+				entity->SetLayer(static_cast<u8>(i % 3));
+				SpatialBounds* bounds = entity->AddComponent<SpatialBounds>();
+				bounds->SetBounds(random.NextBounds(50.0f, 4.0f));
+				components.EmplaceBack(bounds);
+			}
+			scene.spatialIndex.Flush();
+
+			Array<Entity*> results;
+			results.Resize(entityCount);
+
+			Array<Entity*> expected;
+
+			for (u32 query = 0; query < 30; ++query)
+			{
+				u64 layerMask = query % 4 == 0 ? AllLayersMask : LayerToMask(static_cast<u8>(query % 3));
+
+				{
+					AABB aabb = random.NextBounds(50.0f, 30.0f);
+
+					expected.Clear();
+					for (SpatialBounds* bounds : components)
+					{
+						if ((bounds->entity->GetLayerMask() & layerMask) && OverlapsAABB(bounds->bounds, aabb))
+						{
+							expected.EmplaceBack(bounds->entity);
+						}
+					}
+
+					usize count = scene.spatialIndex.QueryAABB(aabb, results, layerMask);
+					CHECK(SortedEntities(Span<Entity*>(results.Data(), count)) == SortedEntities(expected));
+				}
+
+				{
+					Vec3 center = {random.Next(-50.0f, 50.0f), random.Next(-50.0f, 50.0f), random.Next(-50.0f, 50.0f)};
+					f32  radius = random.Next(1.0f, 20.0f);
+
+					expected.Clear();
+					for (SpatialBounds* bounds : components)
+					{
+						if ((bounds->entity->GetLayerMask() & layerMask) && OverlapsSphere(bounds->bounds, center, radius))
+						{
+							expected.EmplaceBack(bounds->entity);
+						}
+					}
+
+					usize count = scene.spatialIndex.QuerySphere(center, radius, results, layerMask);
+					CHECK(SortedEntities(Span<Entity*>(results.Data(), count)) == SortedEntities(expected));
+				}
+
+				{
+					Vec3    position = {random.Next(-50.0f, 50.0f), 0.0f, random.Next(-50.0f, 50.0f)};
+					Frustum frustum = Math::CreateFrustumFromCamera(position, Vec3{0, 0, 1}, Vec3{1, 0, 0}, Vec3{0, 1, 0}, 1.0f, Math::Radians(60.0f), 0.1f, 40.0f);
+
+					expected.Clear();
+					for (SpatialBounds* bounds : components)
+					{
+						if ((bounds->entity->GetLayerMask() & layerMask) && bounds->bounds.IsOnFrustum(frustum))
+						{
+							expected.EmplaceBack(bounds->entity);
+						}
+					}
+
+					usize count = scene.spatialIndex.QueryFrustum(frustum, results, layerMask);
+					CHECK(SortedEntities(Span<Entity*>(results.Data(), count)) == SortedEntities(expected));
+				}
+
+				//results stop at the size of the span
+				Entity* single[1];
+				CHECK(scene.spatialIndex.QueryAABB(AABB{Vec3{-100.0f, -100.0f, -100.0f}, Vec3{100.0f, 100.0f, 100.0f}}, Span<Entity*>(single, 1)) == 1);
+			}
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::SpatialIndexRaycastOrder")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			constexpr u32 entityCount = 50;
+
+			Scene scene;
+
+			//unit boxes along +x, added out of order so the tree order doesn't match the distance order
+			Array<Entity*> entities;
+			entities.Resize(entityCount);
+			for (u32 i = 0; i < entityCount; ++i)
+			{
+				u32     index = (i * 17) % entityCount;
+				Entity* entity = scene.CreateEntity();
+				f32     x = 2.0f * static_cast<f32>(index) + 1.0f;
+				entity->AddComponent<SpatialBounds>()->SetBounds(AABB{Vec3{x - 0.5f, -0.5f, -0.5f}, Vec3{x + 0.5f, 0.5f, 0.5f}});
+				entities[index] = entity;
+			}
+			scene.spatialIndex.Flush();
+
+			Ray ray{Vec3{0.0f, 0.1f, 0.1f}, Vec3{1.0f, 0.0f, 0.0f}};
+
+			//full buffer keeps the closest hits sorted by distance
+			SpatialHit hits[5];
+			usize      count = scene.spatialIndex.Raycast(ray, 1000.0f, Span<SpatialHit>(hits, 5));
+			REQUIRE(count == 5);
+			for (u32 i = 0; i < count; ++i)
+			{
+				CHECK(hits[i].entity == entities[i]);
+				CHECK(hits[i].distance == doctest::Approx(2.0f * static_cast<f32>(i) + 0.5f));
+			}
+
+			//max distance cuts the hits
+			count = scene.spatialIndex.Raycast(ray, 4.0f, Span<SpatialHit>(hits, 5));
+			CHECK(count == 2);
+
+			//a single hit is the closest one
+			count = scene.spatialIndex.Raycast(ray, 1000.0f, Span<SpatialHit>(hits, 1));
+			REQUIRE(count == 1);
+			CHECK(hits[0].entity == entities[0]);
+
+			//misses
+			Ray miss{Vec3{0.0f, 5.0f, 0.0f}, Vec3{1.0f, 0.0f, 0.0f}};
+			CHECK(scene.spatialIndex.Raycast(miss, 1000.0f, Span<SpatialHit>(hits, 5)) == 0);
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::SpatialIndexFlushOnUpdate")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			Scene scene;
+
+			SpatialBounds* first = scene.CreateEntity()->AddComponent<SpatialBounds>();
+			first->SetBounds(AABB{Vec3{0.0f, 0.0f, 0.0f}, Vec3{1.0f, 1.0f, 1.0f}});
+
+			SpatialBounds* second = scene.CreateEntity()->AddComponent<SpatialBounds>();
+			second->SetBounds(AABB{Vec3{10.0f, 0.0f, 0.0f}, Vec3{11.0f, 1.0f, 1.0f}});
+
+			Array<SpatialQuerier*> firstQueriers;
+			Array<SpatialQuerier*> secondQueriers;
+			for (u32 i = 0; i < 64; ++i)
+			{
+				SpatialQuerier* firstQuerier = scene.CreateEntity()->AddComponent<SpatialQuerier>();
+				firstQuerier->area = AABB{Vec3{-1.0f, -1.0f, -1.0f}, Vec3{2.0f, 2.0f, 2.0f}};
+				firstQueriers.EmplaceBack(firstQuerier);
+
+				SpatialQuerier* secondQuerier = scene.CreateEntity()->AddComponent<SpatialQuerier>();
+				secondQuerier->area = AABB{Vec3{19.0f, -1.0f, -1.0f}, Vec3{22.0f, 2.0f, 2.0f}};
+				secondQueriers.EmplaceBack(secondQuerier);
+			}
+
+			//the update flushes before the parallel ticks query the tree
+			scene.Update(0.0);
+			for (u32 i = 0; i < 64; ++i)
+			{
+				CHECK(firstQueriers[i]->found == 1);
+				CHECK(secondQueriers[i]->found == 0);
+			}
+
+			//queries see the tree of the last flush until the next update
+			second->SetBounds(AABB{Vec3{20.0f, 0.0f, 0.0f}, Vec3{21.0f, 1.0f, 1.0f}});
+			Entity* results[4];
+			CHECK(scene.spatialIndex.QueryAABB(secondQueriers[0]->area, Span<Entity*>(results, 4)) == 0);
+
+			scene.Update(0.0);
+			for (u32 i = 0; i < 64; ++i)
+			{
+				CHECK(firstQueriers[i]->found == 1);
+				CHECK(secondQueriers[i]->found == 1);
+			}
+
+			//scene bounds come from the exact bounds in the index and flush pending changes
+			first->SetBounds(AABB{Vec3{-5.0f, 0.0f, 0.0f}, Vec3{1.0f, 1.0f, 1.0f}});
+			AABB bounds = scene.GetBounds();
+			CHECK(bounds.min.x == doctest::Approx(-5.0f));
+			CHECK(bounds.max.x == doctest::Approx(21.0f));
+			CHECK(bounds.max.y == doctest::Approx(1.0f));
+
+			first->entity->SetActive(false);
+			bounds = scene.GetBounds();
+			CHECK(bounds.min.x == doctest::Approx(20.0f));
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::HeadlessMeshRendererBounds")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			//tests run without a device or window, like a headless app
+			REQUIRE(Graphics::GetDevice() == nullptr);
+			CHECK(!Graphics::GetWindow());
+
+			RID            mesh = Resources::Create<MeshResource>();
+			ResourceObject meshObject = Resources::Write(mesh);
+			meshObject.SetVec3(MeshResource::AABBMin, Vec3{-1.0f, -2.0f, -3.0f});
+			meshObject.SetVec3(MeshResource::AABBMax, Vec3{1.0f, 2.0f, 3.0f});
+			meshObject.Commit();
+
+			Scene   scene;
+			Entity* entity = scene.CreateEntity();
+			entity->AddComponent<Transform>()->SetPosition(Vec3{10.0f, 0.0f, 0.0f});
+			StaticMeshRenderer* renderer = entity->AddComponent<StaticMeshRenderer>();
+			renderer->SetMesh(mesh);
+
+			for (u32 frame = 0; frame < 3; ++frame)
+			{
+				scene.Update(1.0 / 60.0);
+			}
+
+			//bounds come from the mesh resource, nothing is loaded or uploaded
+			AABB aabb = renderer->GetAABB();
+			CHECK(aabb.min.x == doctest::Approx(9.0f));
+			CHECK(aabb.min.y == doctest::Approx(-2.0f));
+			CHECK(aabb.min.z == doctest::Approx(-3.0f));
+			CHECK(aabb.max.x == doctest::Approx(11.0f));
+			CHECK(aabb.max.y == doctest::Approx(2.0f));
+			CHECK(aabb.max.z == doctest::Approx(3.0f));
+
+			AABB bounds = scene.GetBounds();
+			CHECK(bounds.min.x == doctest::Approx(9.0f));
+			CHECK(bounds.max.z == doctest::Approx(3.0f));
+
+			Entity* results[4];
+			CHECK(scene.spatialIndex.QueryAABB(AABB{Vec3{10.5f, 1.5f, 2.5f}, Vec3{12.0f, 4.0f, 4.0f}}, Span<Entity*>(results, 4)) == 1);
+
+			//moving the entity updates the bounds without a device
+			entity->GetComponent<Transform>()->SetPosition(Vec3{0.0f, 5.0f, 0.0f});
+			scene.Update(1.0 / 60.0);
+			bounds = scene.GetBounds();
+			CHECK(bounds.min.x == doctest::Approx(-1.0f));
+			CHECK(bounds.min.y == doctest::Approx(3.0f));
+			CHECK(bounds.max.y == doctest::Approx(7.0f));
+
+			RenderSceneObjects& renderObjects = scene.renderObjects;
+			CHECK(renderObjects.GetMeshCache(renderer->GetRenderableObject()) == nullptr);
+			CHECK(renderObjects.instanceDataBuffer == nullptr);
+			CHECK(renderObjects.GetTLAS() == nullptr);
+			CHECK(renderObjects.GetVisiblePipelineCount() == 0);
+			CHECK(Graphics::GetDevice() == nullptr);
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::InstantiateBatchMatchesInstantiate")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			constexpr u32 count = 8;
+
+			RID prefab = CreatePrefabResource();
+
+			Scene scene;
+			Entity* parent = scene.CreateEntity();
+			parent->AddComponent<Transform>();
+
+			Entity* expected = parent->CreateChildFromAsset(prefab);
+			CHECK(!scene.HasPrefabTemplate(prefab));
+
+			Array<Entity*> copies = Entity::InstantiateBatch(parent, prefab, count);
+			REQUIRE(copies.Size() == count);
+			CHECK(scene.HasPrefabTemplate(prefab));
+			CHECK(parent->GetChildrenNum() == count + 1);
+
+			for (Entity* copy : copies)
+			{
+				CHECK(copy->GetParent() == parent);
+				CheckSameEntity(copy, expected);
+			}
+
+			//copies don't share components
+			copies[0]->GetComponent<ParallelCounter>()->value = 99;
+			CHECK(copies[1]->GetComponent<ParallelCounter>()->value == 10);
+
+			//transforms are applied to the first roots, the rest keep the prefab transform
+			Mat4 transforms[2] = {Mat4::Translate(10.0f, 0.0f, 0.0f), Mat4::Translate(0.0f, 20.0f, 0.0f)};
+			Array<Entity*> placed = Entity::InstantiateBatch(parent, prefab, 3, Span<Mat4>(transforms, 2));
+			REQUIRE(placed.Size() == 3);
+			CheckSameTranslation(placed[0]->GetComponent<Transform>()->GetLocalTransform(), transforms[0]);
+			CheckSameTranslation(placed[1]->GetComponent<Transform>()->GetLocalTransform(), transforms[1]);
+			CheckSameEntity(placed[2], expected);
+
+			//children follow the placed root
+			Vec3 childPosition = Mat4::GetTranslation(placed[0]->GetChildAt(0)->GetWorldTransform());
+			CHECK(childPosition.x == doctest::Approx(10.0f));
+			CHECK(childPosition.y == doctest::Approx(1.0f));
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::InstantiateBatchRebuildsTemplate")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			RID prefab = CreatePrefabResource();
+			RID first = Resources::Read(prefab).GetSubObjectList(EntityResource::Children)[0];
+			RID grandchild = Resources::Read(first).GetSubObjectList(EntityResource::Children)[0];
+
+			Scene scene;
+			Entity* parent = scene.CreateEntity();
+			parent->AddComponent<Transform>();
+
+			Array<Entity*> before = Entity::InstantiateBatch(parent, prefab, 2);
+			REQUIRE(before.Size() == 2);
+
+			//component commit on a grandchild bumps the root version
+			u64 version = Resources::GetVersion(prefab);
+			{
+				RID counter = EntityResource::GetOrCreateComponent(grandchild, TypeInfo<ParallelCounter>::ID(), nullptr);
+				ResourceObject counterObject = Resources::Write(counter);
+				counterObject.SetInt(counterObject.GetIndex("value"), 41);
+				counterObject.Commit();
+			}
+			CHECK(Resources::GetVersion(prefab) > version);
+
+			Array<Entity*> afterComponent = Entity::InstantiateBatch(parent, prefab, 2);
+			REQUIRE(afterComponent.Size() == 2);
+			CHECK(afterComponent[1]->GetChildAt(0)->GetChildAt(0)->GetComponent<ParallelCounter>()->value == 41);
+			CHECK(before[1]->GetChildAt(0)->GetChildAt(0)->GetComponent<ParallelCounter>()->value == 40);
+
+			//new child on a child
+			version = Resources::GetVersion(prefab);
+			AddChildResource(first, CreateEntityResource("Added", 9, Vec3{0.0f, 0.0f, 0.0f}, 50));
+			CHECK(Resources::GetVersion(prefab) > version);
+
+			Array<Entity*> afterChild = Entity::InstantiateBatch(parent, prefab, 2);
+			REQUIRE(afterChild.Size() == 2);
+
+			Entity* expected = parent->CreateChildFromAsset(prefab);
+			REQUIRE(expected->GetChildAt(0)->GetChildrenNum() == 2);
+			for (Entity* copy : afterChild)
+			{
+				CheckSameEntity(copy, expected);
+			}
+			CHECK(before[0]->GetChildAt(0)->GetChildrenNum() == 1);
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::InstantiateBatchReflectionReload")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			RID prefab = CreatePrefabResource();
+
+			//reflection reload is only bound on scenes with resource sync
+			Scene scene(Resources::Create<SceneResource>(UUID::RandomUUID()), true);
+			Entity* parent = scene.CreateEntity();
+			parent->AddComponent<Transform>();
+
+			Entity::InstantiateBatch(parent, prefab, 2);
+			CHECK(scene.HasPrefabTemplate(prefab));
+
+			EventHandler<OnPluginReloaded>{}.Invoke();
+			CHECK(!scene.HasPrefabTemplate(prefab));
+
+			Array<Entity*> copies = Entity::InstantiateBatch(parent, prefab, 2);
+			REQUIRE(copies.Size() == 2);
+			CHECK(scene.HasPrefabTemplate(prefab));
+
+			Entity* expected = parent->CreateChildFromAsset(prefab);
+			for (Entity* copy : copies)
+			{
+				CheckSameEntity(copy, expected);
+			}
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::QueryAddRemoveDeactivate")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			Scene scene;
+
+			Entity* first = scene.CreateEntity();
+			first->AddComponent<QueryA>();
+			QueryB* firstB = first->AddComponent<QueryB>();
+
+			Entity* second = scene.CreateEntity();
+			second->AddComponent<QueryA>();
+
+			Entity* third = scene.CreateEntity();
+			third->AddComponent<QueryA>();
+			third->AddComponent<QueryB>();
+
+			Entity* child = third->CreateChild();
+			child->AddComponent<QueryA>();
+			child->AddComponent<QueryB>();
+
+			Array<QueryRow> rows = QueryAB(scene);
+			CHECK(rows.Size() == 3);
+			CHECK(!HasQueryRow(rows, second));
+
+			//cached query is updated when components are added or removed
+			second->AddComponent<QueryB>();
+			CHECK(HasQueryRow(QueryAB(scene), second));
+
+			first->RemoveComponent(firstB);
+			rows = QueryAB(scene);
+			CHECK(rows.Size() == 3);
+			CHECK(!HasQueryRow(rows, first));
+
+			//deactivating removes the entity and its children
+			third->SetActive(false);
+			rows = QueryAB(scene);
+			CHECK(rows.Size() == 1);
+			CHECK(HasQueryRow(rows, second));
+
+			third->SetActive(true);
+			rows = QueryAB(scene);
+			CHECK(rows.Size() == 3);
+			CHECK(HasQueryRow(rows, third));
+			CHECK(HasQueryRow(rows, child));
+
+			second->DestroyImmediate();
+			rows = QueryAB(scene);
+			CHECK(rows.Size() == 2);
+			CHECK(!HasQueryRow(rows, second));
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::QueryMultipleComponentsOfType")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		{
+			Scene scene;
+
+			Entity* entity = scene.CreateEntity();
+			QueryA* a1 = entity->AddComponent<QueryA>();
+			QueryA* a2 = entity->AddComponent<QueryA>();
+			entity->AddComponent<QueryB>();
+
+			Array<QueryRow> rows = QueryAB(scene);
+			REQUIRE(rows.Size() == 1);
+			CHECK(rows[0].a == a1);
+
+			//another component of the same type takes the row
+			entity->RemoveComponent(a1);
+			rows = QueryAB(scene);
+			REQUIRE(rows.Size() == 1);
+			CHECK(rows[0].a == a2);
+
+			QueryA* a3 = entity->AddComponent<QueryA>();
+
+			//deactivation removes every component, none of them can match again
+			entity->SetActive(false);
+			CHECK(QueryAB(scene).Empty());
+
+			entity->SetActive(true);
+			rows = QueryAB(scene);
+			REQUIRE(rows.Size() == 1);
+			CHECK((rows[0].a == a2 || rows[0].a == a3));
+
+			//destroying an entity with two components of the queried type leaves nothing behind
+			Entity* other = scene.CreateEntity();
+			other->AddComponent<QueryA>();
+			other->AddComponent<QueryA>();
+			other->AddComponent<QueryB>();
+			CHECK(QueryAB(scene).Size() == 2);
+
+			other->DestroyImmediate();
+			rows = QueryAB(scene);
+			REQUIRE(rows.Size() == 1);
+			CHECK(rows[0].entity == entity);
+
+			Entity* inactive = scene.CreateEntity();
+			inactive->AddComponent<QueryA>();
+			inactive->AddComponent<QueryA>();
+			inactive->AddComponent<QueryB>();
+			inactive->SetActive(false);
+			inactive->DestroyImmediate();
+			rows = QueryAB(scene);
+			REQUIRE(rows.Size() == 1);
+			CHECK(rows[0].entity == entity);
+		}
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::PhysicsAsyncStepBufferedCommands")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		PhysicsInit();
+		{
+			//same commands applied right away, without an async step
+			Vec3 expectedVelocity;
+			{
+				Scene scene;
+				RigidBody* body = CreatePhysicsBody(scene, Vec3{0.0f, 0.0f, 0.0f});
+				scene.Update(0.0);
+
+				body->AddImpulse(Vec3{0.0f, 2.0f, 0.0f});
+				scene.Update(0.0);
+				expectedVelocity = body->GetLinearVelocity();
+			}
+			REQUIRE(expectedVelocity.y > 0.0f);
+
+			Scene scene;
+			scene.physicsScene.SetAsyncStep(true);
+			f64 stepSize = scene.physicsScene.GetFixedTimeStep();
+			REQUIRE(stepSize > 0.0);
+
+			RigidBody* impulseBody = CreatePhysicsBody(scene, Vec3{0.0f, 0.0f, 0.0f});
+			RigidBody* velocityBody = CreatePhysicsBody(scene, Vec3{10.0f, 0.0f, 0.0f});
+			scene.Update(0.0);
+
+			scene.Update(stepSize);
+			REQUIRE(scene.physicsScene.IsStepping());
+
+			impulseBody->AddImpulse(Vec3{0.0f, 2.0f, 0.0f});
+			velocityBody->SetLinearVelocity(Vec3{3.0f, 0.0f, 0.0f});
+
+			bool ranAfterStep = false;
+			scene.physicsScene.RunAfterStep([&]
+			{
+				ranAfterStep = true;
+			});
+			CHECK(!ranAfterStep);
+
+			//the next update syncs the step, applies the commands and writes the velocities back
+			scene.Update(0.0);
+			CHECK(!scene.physicsScene.IsStepping());
+			CHECK(ranAfterStep);
+
+			CHECK(impulseBody->GetLinearVelocity().y == doctest::Approx(expectedVelocity.y));
+			CHECK(velocityBody->GetLinearVelocity().x == doctest::Approx(3.0f));
+
+			//nothing is buffered without a step in flight
+			ranAfterStep = false;
+			scene.physicsScene.RunAfterStep([&]
+			{
+				ranAfterStep = true;
+			});
+			CHECK(ranAfterStep);
+		}
+		PhysicsShutdown();
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::PhysicsRaycastAllSorted")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		PhysicsInit();
+		{
+			Scene      scene;
+			RigidBody* lower = CreatePhysicsBody(scene, Vec3{0.0f, 0.0f, 0.0f});
+			RigidBody* upper = CreatePhysicsBody(scene, Vec3{0.0f, 5.0f, 0.0f});
+			CreatePhysicsBody(scene, Vec3{10.0f, 0.0f, 0.0f});
+			scene.Update(0.0);
+
+			//hits are appended to the caller's array, nearest first
+			Array<RaycastHit> hits;
+			hits.EmplaceBack(RaycastHit{});
+			REQUIRE(Physics::RaycastAll(Vec3{0.0f, 20.0f, 0.0f}, Vec3{0.0f, -1.0f, 0.0f}, 40.0f, hits));
+			REQUIRE(hits.Size() == 3);
+			CHECK(hits[0].entity == nullptr);
+			CHECK(hits[1].entity == upper->entity);
+			CHECK(hits[2].entity == lower->entity);
+			CHECK(hits[1].distance < hits[2].distance);
+			CHECK(hits[1].normal.y == doctest::Approx(1.0f));
+
+			hits.Clear();
+			CHECK(!Physics::RaycastAll(Vec3{-10.0f, 20.0f, 0.0f}, Vec3{0.0f, -1.0f, 0.0f}, 40.0f, hits));
+			CHECK(hits.Empty());
+		}
+		PhysicsShutdown();
+		ResourceShutdown();
+	}
+
+	TEST_CASE("Scene::PhysicsUnregisterDuringStep")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		PhysicsInit();
+		{
+			Scene scene;
+			scene.physicsScene.SetAsyncStep(true);
+
+			RigidBody* removed = CreatePhysicsBody(scene, Vec3{0.0f, 0.0f, 0.0f});
+			RigidBody* kept = CreatePhysicsBody(scene, Vec3{10.0f, 0.0f, 0.0f});
+			scene.Update(0.0);
+
+			scene.Update(scene.physicsScene.GetFixedTimeStep());
+			REQUIRE(scene.physicsScene.IsStepping());
+
+			removed->AddImpulse(Vec3{0.0f, 2.0f, 0.0f});
+			kept->SetLinearVelocity(Vec3{0.0f, 0.0f, 3.0f});
+
+			//waits for the step and drops the buffered commands of the body
+			removed->entity->DestroyImmediate();
+			CHECK(scene.physicsScene.IsStepping());
+
+			Entity* hitRemoved = nullptr;
+			Entity* hitKept = nullptr;
+			scene.physicsScene.RunAfterStep([&]
+			{
+				RaycastHit hit;
+				if (Physics::Raycast(Vec3{0.0f, 10.0f, 0.0f}, Vec3{0.0f, -1.0f, 0.0f}, 20.0f, hit))
+				{
+					hitRemoved = hit.entity;
+				}
+				if (Physics::Raycast(Vec3{10.0f, 10.0f, 0.0f}, Vec3{0.0f, -1.0f, 0.0f}, 20.0f, hit))
+				{
+					hitKept = hit.entity;
+				}
+			});
+
+			scene.Update(0.0);
+			CHECK(!scene.physicsScene.IsStepping());
+			CHECK(hitRemoved == nullptr);
+			CHECK(hitKept == kept->entity);
+			CHECK(kept->GetLinearVelocity().z == doctest::Approx(3.0f));
+		}
+		PhysicsShutdown();
+		ResourceShutdown();
+	}
+
+	void FeedReplayKey(SDL_Scancode scancode, bool down)
+	{
+		SDL_Event event{};
+		event.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+		event.key.scancode = scancode;
+		InputHandlerEvents(&event);
+	}
+
+	Array<Vec3> RunReplayScene(bool record, StringView path)
+	{
+		constexpr u32 frameCount = 90;
+		constexpr f64 deltaTime = 1.0 / 60.0;
+
+		Random::SetSeed(77);
+
+		Scene   scene;
+		Entity* entity = scene.CreateEntity();
+		entity->AddComponent<Transform>();
+		entity->AddComponent<BoxCollider>();
+		entity->AddComponent<RigidBody>();
+		entity->AddComponent<InputMover>();
+		scene.Update(0.0);
+
+		if (record)
+		{
+			REQUIRE(Input::StartRecording(path));
+		}
+		else
+		{
+			REQUIRE(Input::StartReplay(path));
+		}
+
+		Array<Vec3> positions;
+		for (u32 frame = 0; frame < frameCount; ++frame)
+		{
+			//live input, ignored while replaying
+			if (frame == 10 || frame == 50)
+			{
+				FeedReplayKey(SDL_SCANCODE_D, true);
+			}
+			if (frame == 30 || frame == 70)
+			{
+				FeedReplayKey(SDL_SCANCODE_D, false);
+			}
+			if (frame == 20 || frame == 60)
+			{
+				FeedReplayKey(SDL_SCANCODE_SPACE, true);
+			}
+			if (frame == 21 || frame == 61)
+			{
+				FeedReplayKey(SDL_SCANCODE_SPACE, false);
+			}
+
+			InputOnBeginFrame();
+			scene.Update(deltaTime);
+			positions.EmplaceBack(entity->GetComponent<Transform>()->GetPosition());
+			InputOnEndFrame();
+		}
+
+		if (record)
+		{
+			Input::StopRecording();
+		}
+		else
+		{
+			//one more frame ends the replay
+			InputOnBeginFrame();
+			InputOnEndFrame();
+			CHECK(!Input::IsReplaying());
+		}
+
+		return positions;
+	}
+
+	TEST_CASE("Scene::FixedStepInputReplay")
+	{
+		ResourceInit();
+		RegisterSceneTestTypes();
+		PhysicsInit();
+		InputInit();
+		{
+			String path = Path::Join(FileSystem::CurrentDir(), "FixedStepInputReplay.skir");
+
+			Array<Vec3> recorded = RunReplayScene(true, path);
+			REQUIRE(recorded.Size() > 0);
+			CHECK(recorded.Back().x > 0.0f);
+			CHECK(recorded.Back().z > 0.0f);
+
+			Array<Vec3> replayed = RunReplayScene(false, path);
+			REQUIRE(replayed.Size() == recorded.Size());
+			for (usize i = 0; i < recorded.Size(); ++i)
+			{
+				CHECK(replayed[i].x == recorded[i].x);
+				CHECK(replayed[i].y == recorded[i].y);
+				CHECK(replayed[i].z == recorded[i].z);
+			}
+
+			FileSystem::Remove(path);
+		}
+		PhysicsShutdown();
+		ResourceShutdown();
+	}
+}
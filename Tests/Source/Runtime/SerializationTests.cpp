@@ -4,6 +4,7 @@
 #include "Skore/App.hpp"
 #include "Skore/Core/Reflection.hpp"
 #include "Skore/Core/Serialization.hpp"
+#include "Skore/Core/StringUtils.hpp"
 
 using namespace Skore;
 
@@ -560,6 +561,83 @@ namespace
 	}
 
 
+	TEST_CASE("IO::Serialization::BinaryFullIndexed")
+	{
+		BinaryArchiveWriter writer{true};
+		WriteArchiveData(writer);
+
+		BinaryArchiveReader reader(writer.GetData());
+		CompareReaderData(reader);
+	}
+
+	TEST_CASE("IO::Serialization::BinaryMapNavigationIndexed")
+	{
+		BinaryArchiveWriter writer{true};
+		WriteMapNavigationTestData(writer);
+
+		BinaryArchiveReader reader(writer.GetData());
+		TestMapNavigation(reader);
+	}
+
+	TEST_CASE("IO::Serialization::BinaryFieldIndex")
+	{
+		constexpr u32 fieldCount = 32;
+
+		auto write = [&](BinaryArchiveWriter& writer)
+		{
+			writer.BeginMap("fields");
+			for (u32 i = 0; i < fieldCount; ++i)
+			{
+				writer.WriteUInt(String("field").Append(ToString(static_cast<u64>(i))), i * 10);
+			}
+			writer.BeginSeq("seq");
+			writer.AddUInt(1);
+			writer.AddUInt(2);
+			writer.EndSeq();
+			writer.EndMap();
+		};
+
+		BinaryArchiveWriter plainWriter;
+		write(plainWriter);
+
+		BinaryArchiveWriter indexedWriter{true};
+		write(indexedWriter);
+
+		CHECK(indexedWriter.GetData().Size() > plainWriter.GetData().Size());
+
+		for (Span<u8> data : {plainWriter.GetData(), indexedWriter.GetData()})
+		{
+			BinaryArchiveReader reader(data);
+			REQUIRE(reader.BeginMap("fields"));
+
+			bool valid = true;
+			for (u32 i = fieldCount; i > 0; --i)
+			{
+				valid &= reader.ReadUInt(String("field").Append(ToString(static_cast<u64>(i - 1)))) == (i - 1) * 10;
+			}
+			CHECK(valid);
+			CHECK(reader.ReadUInt("missing") == 0);
+
+			// the index is not visible as a map entry
+			u32 entries = 0;
+			while (reader.NextMapEntry())
+			{
+				entries++;
+			}
+			CHECK(entries == fieldCount + 1);
+
+			REQUIRE(reader.BeginSeq("seq"));
+			CHECK(reader.NextSeqEntry());
+			CHECK(reader.GetUInt() == 1);
+			CHECK(reader.NextSeqEntry());
+			CHECK(reader.GetUInt() == 2);
+			CHECK_FALSE(reader.NextSeqEntry());
+			reader.EndSeq();
+
+			reader.EndMap();
+		}
+	}
+
 	TEST_CASE("IO::Serialization::Binary")
 	{
 		BinaryArchiveWriter writer;